@@ -0,0 +1,73 @@
+#ifndef ALLOCCOUNTER_HPP
+#define ALLOCCOUNTER_HPP
+
+#include <cstdlib>
+#include <new>
+
+// Replaces the global operator new/delete to count heap traffic.
+// Include in exactly ONE translation unit (the benchmark's main file).
+namespace bench
+{
+	struct AllocStats
+	{
+		size_t	allocs;
+		size_t	frees;
+		size_t	bytes;
+	};
+
+	inline AllocStats& allocStats()
+	{
+		static AllocStats stats = {0, 0, 0};
+		return stats;
+	}
+
+	inline void resetAllocStats()
+	{
+		AllocStats& s = allocStats();
+		s.allocs = 0;
+		s.frees = 0;
+		s.bytes = 0;
+	}
+}
+
+#if __cplusplus >= 201103L
+# define BENCH_THROW_BAD_ALLOC
+# define BENCH_NOTHROW noexcept
+#else
+# define BENCH_THROW_BAD_ALLOC throw(std::bad_alloc)
+# define BENCH_NOTHROW throw()
+#endif
+
+// Kept out of line: once inlined into callers, GCC pairs the malloc/free
+// below with the new/delete expressions and reports them as mismatched
+#define BENCH_NOINLINE __attribute__((noinline))
+
+static void* countedAlloc(size_t size)
+{
+	bench::AllocStats& s = bench::allocStats();
+	s.allocs++;
+	s.bytes += size;
+	void* p = std::malloc(size ? size : 1);
+	if (p == NULL)
+		throw std::bad_alloc();
+	return p;
+}
+
+BENCH_NOINLINE void* operator new(size_t size) BENCH_THROW_BAD_ALLOC { return countedAlloc(size); }
+BENCH_NOINLINE void* operator new[](size_t size) BENCH_THROW_BAD_ALLOC { return countedAlloc(size); }
+
+BENCH_NOINLINE void operator delete(void* p) BENCH_NOTHROW
+{
+	if (p != NULL)
+		bench::allocStats().frees++;
+	std::free(p);
+}
+
+BENCH_NOINLINE void operator delete[](void* p) BENCH_NOTHROW
+{
+	if (p != NULL)
+		bench::allocStats().frees++;
+	std::free(p);
+}
+
+#endif
@@ -0,0 +1,244 @@
+#ifndef BENCH_HPP
+#define BENCH_HPP
+
+#include <ctime>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+
+// Minimal timing helpers shared by the benchmark programs of every exercise.
+// Header-only and C++98: benchmark bodies are plain functors with operator().
+//
+// Two levels:
+//   measure() + report():  best-of-N time and a free-form line, for the
+//                          exploratory benchmarks
+//   sample() + record():   warmup, many samples, median/p99 and
+//                          cycles/element, printed as text, CSV or JSON
+//                          lines (BENCH_FORMAT=text|csv|json) so runs can
+//                          be diffed between releases
+namespace bench
+{
+	// Monotonic clock in nanoseconds
+	inline double nowNs()
+	{
+		struct timespec ts;
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return static_cast<double>(ts.tv_sec) * 1e9 + static_cast<double>(ts.tv_nsec);
+	}
+
+	// Prevents the optimizer from discarding a value that is never used
+	template <typename T>
+	inline void doNotOptimize(T const & value)
+	{
+		__asm__ __volatile__("" : : "r,m"(value) : "memory");
+	}
+
+	// Forces pending memory writes to be considered observable
+	inline void clobberMemory()
+	{
+		__asm__ __volatile__("" : : : "memory");
+	}
+
+	// Calls f() `iterations` times per repetition and returns the best
+	// (lowest) time per call in nanoseconds
+	template <typename F>
+	double measure(F& f, size_t iterations, int repetitions = 5)
+	{
+		double best = 0;
+		for (int r = 0; r < repetitions; r++)
+		{
+			double start = nowNs();
+			for (size_t i = 0; i < iterations; i++)
+				f();
+			double elapsed = (nowNs() - start) / static_cast<double>(iterations);
+			if (r == 0 || elapsed < best)
+				best = elapsed;
+		}
+		return best;
+	}
+
+	// Prints one aligned result line: name, ns/op and an optional note
+	inline void report(std::string const & name, double nsPerOp, std::string const & note = "")
+	{
+		std::cout << std::left << std::setw(44) << name
+			<< std::right << std::setw(12) << std::fixed << std::setprecision(1) << nsPerOp
+			<< " ns/op";
+		if (!note.empty())
+			std::cout << "  " << note;
+		std::cout << std::endl;
+	}
+
+	// ==================== Statistics ====================
+
+	// Time stamp counter: reference cycles at the nominal frequency, not
+	// core cycles. 0 where there is none (the cycle column then reads 0).
+	inline unsigned long long cycles()
+	{
+#if defined(__x86_64__) || defined(__i386__)
+		return __builtin_ia32_rdtsc();
+#else
+		return 0;
+#endif
+	}
+
+	struct Stats
+	{
+		double	median;				// ns per call
+		double	p99;				// ns per call, nearest rank
+		double	best;				// ns per call
+		double	cyclesPerElement;	// median TSC cycles per call / elements
+		size_t	samples;
+		size_t	iterations;			// calls per sample
+	};
+
+	// Per-sample time and total time budget of sample()
+	static double const SAMPLE_NS = 200e3;
+	static double const BUDGET_NS = 300e6;
+	static size_t const MAX_SAMPLES = 101;
+	static size_t const MIN_SAMPLES = 11;
+
+	// Median, p99 and best of f() over `elements` elements of work.
+	// A warmup pass (at least `warmup` calls) faults in memory, trains the
+	// branch predictors and sizes the samples: enough calls per sample to
+	// last SAMPLE_NS, and as many samples as fit in BUDGET_NS (between
+	// MIN_SAMPLES and MAX_SAMPLES).
+	template <typename F>
+	Stats sample(F& f, size_t elements, size_t warmup = 3)
+	{
+		double start = nowNs();
+		size_t calls = 0;
+		while (calls < warmup || nowNs() - start < SAMPLE_NS)
+		{
+			f();
+			calls++;
+		}
+		double perCall = (nowNs() - start) / static_cast<double>(calls);
+
+		Stats stats;
+		stats.iterations = static_cast<size_t>(SAMPLE_NS / perCall);
+		if (stats.iterations == 0)
+			stats.iterations = 1;
+		stats.samples = static_cast<size_t>(BUDGET_NS / (perCall * static_cast<double>(stats.iterations)));
+		stats.samples = std::max(MIN_SAMPLES, std::min(MAX_SAMPLES, stats.samples));
+
+		std::vector<double> ns(stats.samples);
+		std::vector<double> ticks(stats.samples);
+		for (size_t s = 0; s < stats.samples; s++)
+		{
+			unsigned long long c0 = cycles();
+			double t0 = nowNs();
+			for (size_t i = 0; i < stats.iterations; i++)
+				f();
+			double t1 = nowNs();
+			unsigned long long c1 = cycles();
+			ns[s] = (t1 - t0) / static_cast<double>(stats.iterations);
+			ticks[s] = static_cast<double>(c1 - c0) / static_cast<double>(stats.iterations);
+		}
+		std::sort(ns.begin(), ns.end());
+		std::sort(ticks.begin(), ticks.end());
+		size_t rank = (stats.samples * 99 + 99) / 100 - 1;
+		stats.median = ns[stats.samples / 2];
+		stats.p99 = ns[rank];
+		stats.best = ns[0];
+		stats.cyclesPerElement = ticks[stats.samples / 2] / static_cast<double>(elements ? elements : 1);
+		return stats;
+	}
+
+	// ==================== Machine-readable output ====================
+
+	enum Format
+	{
+		TEXT,
+		CSV,
+		JSON
+	};
+
+	// From the BENCH_FORMAT environment variable, read once
+	inline Format format()
+	{
+		static int cached = -1;
+		if (cached < 0)
+		{
+			char const * env = std::getenv("BENCH_FORMAT");
+			cached = TEXT;
+			if (env != NULL && std::strcmp(env, "csv") == 0)
+				cached = CSV;
+			else if (env != NULL && std::strcmp(env, "json") == 0)
+				cached = JSON;
+		}
+		return static_cast<Format>(cached);
+	}
+
+	// Names are quoted for CSV and escaped for JSON
+	inline std::string quoted(std::string const & text)
+	{
+		char const quote = (format() == CSV) ? '"' : '\\';
+		std::string out = "\"";
+		for (size_t i = 0; i < text.size(); i++)
+		{
+			if (text[i] == '"' || (text[i] == '\\' && format() == JSON))
+				out += quote;
+			out += text[i];
+		}
+		return out + "\"";
+	}
+
+	// One result: an aligned line, a CSV row (header before the first one)
+	// or one JSON object per line
+	inline void record(std::string const & suite, std::string const & name, size_t elements, Stats const & s)
+	{
+		static bool header = false;
+		Format f = format();
+		std::ostringstream line;
+		line << std::fixed << std::setprecision(1);
+		if (f == TEXT)
+		{
+			line << std::left << std::setw(44) << name << std::right
+				<< std::setw(12) << s.median << " ns  p99 "
+				<< std::setw(10) << s.p99 << " ns  "
+				<< std::setprecision(3) << std::setw(8) << s.cyclesPerElement << " cycles/element";
+		}
+		else if (f == CSV)
+		{
+			if (!header)
+				std::cout << "suite,name,elements,median_ns,p99_ns,best_ns,cycles_per_element,samples,iterations" << std::endl;
+			header = true;
+			line << suite << "," << quoted(name) << "," << elements << ","
+				<< s.median << "," << s.p99 << "," << s.best << ","
+				<< std::setprecision(3) << s.cyclesPerElement << ","
+				<< s.samples << "," << s.iterations;
+		}
+		else
+		{
+			line << "{\"suite\": " << quoted(suite) << ", \"name\": " << quoted(name)
+				<< ", \"elements\": " << elements
+				<< ", \"median_ns\": " << s.median << ", \"p99_ns\": " << s.p99
+				<< ", \"best_ns\": " << s.best
+				<< ", \"cycles_per_element\": " << std::setprecision(3) << s.cyclesPerElement
+				<< ", \"samples\": " << s.samples << ", \"iterations\": " << s.iterations << "}";
+		}
+		std::cout << line.str() << std::endl;
+	}
+
+	// Section title, on text output only
+	inline void title(std::string const & text)
+	{
+		if (format() == TEXT)
+			std::cout << text << std::endl;
+	}
+
+	// sample() then record()
+	template <typename F>
+	void run(std::string const & suite, std::string const & name, size_t elements, F f)
+	{
+		record(suite, name, elements, sample(f, elements));
+	}
+}
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef PERFCOUNTER_HPP
+#define PERFCOUNTER_HPP
+
+#include <cstring>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+// Hardware event counter for the calling thread (Linux perf_event_open).
+// When the kernel refuses access (containers, perf_event_paranoid), the
+// counter reports available() == false and read() returns 0.
+namespace bench
+{
+	class PerfCounter
+	{
+		private:
+			int	_fd;
+
+			PerfCounter(PerfCounter const & src);
+			PerfCounter& operator=(PerfCounter const & rhs);
+
+		public:
+			// type/config as in perf_event_attr, e.g. PERF_TYPE_HARDWARE and
+			// PERF_COUNT_HW_CACHE_MISSES
+			PerfCounter(unsigned int type, unsigned long long config) : _fd(-1)
+			{
+				struct perf_event_attr attr;
+				std::memset(&attr, 0, sizeof(attr));
+				attr.size = sizeof(attr);
+				attr.type = type;
+				attr.config = config;
+				attr.disabled = 1;
+				attr.exclude_kernel = 1;
+				attr.exclude_hv = 1;
+				_fd = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+			}
+
+			~PerfCounter()
+			{
+				if (_fd >= 0)
+					close(_fd);
+			}
+
+			bool available() const { return _fd >= 0; }
+
+			void start()
+			{
+				if (_fd < 0)
+					return;
+				ioctl(_fd, PERF_EVENT_IOC_RESET, 0);
+				ioctl(_fd, PERF_EVENT_IOC_ENABLE, 0);
+			}
+
+			unsigned long long stop()
+			{
+				unsigned long long value = 0;
+				if (_fd < 0)
+					return 0;
+				ioctl(_fd, PERF_EVENT_IOC_DISABLE, 0);
+				if (::read(_fd, &value, sizeof(value)) != static_cast<ssize_t>(sizeof(value)))
+					return 0;
+				return value;
+			}
+	};
+}
+
+#endif
@@ -0,0 +1,152 @@
+#include <cstdlib>
+#include <string>
+#include <sstream>
+#include "../whatever.hpp"
+#include "../../bench/Bench.hpp"
+
+// Range min/max/minmax_element/swap_ranges against loops over the pair
+// versions, on ascending data (predictable branches) and on random data
+// (a mispredicted branch every other element for the scalar loops).
+
+static size_t const SIZE = 1u << 20;
+static size_t const ITERATIONS = 50;
+
+template <typename T>
+struct Data
+{
+	T*	a;
+	T*	b;
+	T*	out;
+
+	Data(bool random) : a(new T[SIZE]), b(new T[SIZE]), out(new T[SIZE])
+	{
+		std::srand(42);
+		for (size_t i = 0; i < SIZE; i++)
+		{
+			a[i] = static_cast<T>(random ? std::rand() % 1000000 : static_cast<int>(i));
+			b[i] = static_cast<T>(random ? std::rand() % 1000000 : static_cast<int>(i) + 1);
+		}
+	}
+
+	~Data()
+	{
+		delete[] a;
+		delete[] b;
+		delete[] out;
+	}
+};
+
+template <typename T>
+struct LoopMin
+{
+	Data<T>& d;
+	LoopMin(Data<T>& data) : d(data) {}
+	void operator()()
+	{
+		for (size_t i = 0; i < SIZE; i++)
+			d.out[i] = ::min(d.a[i], d.b[i]);
+		bench::clobberMemory();
+	}
+};
+
+template <typename T>
+struct RangeMin
+{
+	Data<T>& d;
+	RangeMin(Data<T>& data) : d(data) {}
+	void operator()() { ::min(d.a, d.b, d.out, SIZE); bench::clobberMemory(); }
+};
+
+// The usual hand-written search: branch on every comparison
+template <typename T>
+struct LoopMinMax
+{
+	Data<T>& d;
+	LoopMinMax(Data<T>& data) : d(data) {}
+	void operator()()
+	{
+		T const * lo = d.a;
+		T const * hi = d.a;
+		for (size_t i = 1; i < SIZE; i++)
+		{
+			if (d.a[i] < *lo)
+				lo = d.a + i;
+			if (!(d.a[i] < *hi))
+				hi = d.a + i;
+		}
+		bench::doNotOptimize(lo);
+		bench::doNotOptimize(hi);
+	}
+};
+
+template <typename T>
+struct RangeMinMax
+{
+	Data<T>& d;
+	RangeMinMax(Data<T>& data) : d(data) {}
+	void operator()()
+	{
+		std::pair<T const *, T const *> found = ::minmax_element(const_cast<T const *>(d.a), SIZE);
+		bench::doNotOptimize(found.first);
+		bench::doNotOptimize(found.second);
+	}
+};
+
+template <typename T>
+struct LoopSwap
+{
+	Data<T>& d;
+	LoopSwap(Data<T>& data) : d(data) {}
+	void operator()()
+	{
+		for (size_t i = 0; i < SIZE; i++)
+			::swap(d.a[i], d.b[i]);
+		bench::clobberMemory();
+	}
+};
+
+template <typename T>
+struct RangeSwap
+{
+	Data<T>& d;
+	RangeSwap(Data<T>& data) : d(data) {}
+	void operator()() { ::swap_ranges(d.a, d.b, SIZE); bench::clobberMemory(); }
+};
+
+template <typename Baseline, typename Range, typename T>
+static void compare(std::string const & name, Data<T>& data)
+{
+	Baseline baseline(data);
+	Range range(data);
+	double nsBaseline = bench::measure(baseline, ITERATIONS);
+	double nsRange = bench::measure(range, ITERATIONS);
+	std::ostringstream note;
+	note << std::fixed << std::setprecision(2) << nsBaseline / SIZE << " ns/element";
+	bench::report(name + ", pair loop", nsBaseline, note.str());
+	note.str("");
+	note << nsRange / SIZE << " ns/element, x" << nsBaseline / nsRange;
+	bench::report(name + ", range", nsRange, note.str());
+}
+
+template <typename T>
+static void run(std::string const & type)
+{
+	for (int random = 0; random < 2; random++)
+	{
+		Data<T> data(random != 0);
+		std::string label = type + (random ? " random" : " ascending");
+		std::cout << "-- " << label << " (n = 1M)" << std::endl;
+		compare<LoopMin<T>, RangeMin<T> >("min", data);
+		compare<LoopMinMax<T>, RangeMinMax<T> >("minmax_element", data);
+		compare<LoopSwap<T>, RangeSwap<T> >("swap_ranges", data);
+	}
+}
+
+int main(void)
+{
+	std::cout << "Range min/max/swap benchmark" << std::endl;
+	run<int>("int");
+	run<float>("float");
+	run<double>("double");
+	return 0;
+}
@@ -0,0 +1,137 @@
+#include <cstdlib>
+#include <string>
+#include <sstream>
+#include "../whatever.hpp"
+#include "../../bench/Bench.hpp"
+
+// Regression suite for whatever.hpp: the pair templates called over
+// arrays, and the range versions, per element type and size. Results
+// go through bench::record (BENCH_FORMAT=text|csv|json).
+
+template <typename T> T value(int i) { return static_cast<T>(i); }
+template <> std::string value<std::string>(int i)
+{
+	std::ostringstream out;
+	out << "key-" << i;
+	return out.str();
+}
+
+template <typename T>
+struct Data
+{
+	size_t	n;
+	T*		a;
+	T*		b;
+	T*		out;
+
+	Data(size_t count) : n(count), a(new T[count]), b(new T[count]), out(new T[count])
+	{
+		std::srand(42);
+		for (size_t i = 0; i < n; i++)
+		{
+			a[i] = value<T>(std::rand() % 1000000);
+			b[i] = value<T>(std::rand() % 1000000);
+		}
+	}
+
+	~Data()
+	{
+		delete[] a;
+		delete[] b;
+		delete[] out;
+	}
+
+	private:
+		Data(Data const & src);
+		Data& operator=(Data const & rhs);
+};
+
+template <typename T>
+struct PairSwap
+{
+	Data<T>& d;
+	PairSwap(Data<T>& data) : d(data) {}
+	void operator()()
+	{
+		for (size_t i = 0; i < d.n; i++)
+			::swap(d.a[i], d.b[i]);
+		bench::clobberMemory();
+	}
+};
+
+template <typename T>
+struct PairMin
+{
+	Data<T>& d;
+	PairMin(Data<T>& data) : d(data) {}
+	void operator()()
+	{
+		for (size_t i = 0; i < d.n; i++)
+			d.out[i] = ::min(d.a[i], d.b[i]);
+		bench::clobberMemory();
+	}
+};
+
+template <typename T>
+struct PairMax
+{
+	Data<T>& d;
+	PairMax(Data<T>& data) : d(data) {}
+	void operator()()
+	{
+		for (size_t i = 0; i < d.n; i++)
+			d.out[i] = ::max(d.a[i], d.b[i]);
+		bench::clobberMemory();
+	}
+};
+
+template <typename T>
+struct RangeMin
+{
+	Data<T>& d;
+	RangeMin(Data<T>& data) : d(data) {}
+	void operator()() { ::min(d.a, d.b, d.out, d.n); bench::clobberMemory(); }
+};
+
+template <typename T>
+struct RangeSwap
+{
+	Data<T>& d;
+	RangeSwap(Data<T>& data) : d(data) {}
+	void operator()() { ::swap_ranges(d.a, d.b, d.n); bench::clobberMemory(); }
+};
+
+template <typename T>
+struct MinmaxElement
+{
+	Data<T>& d;
+	MinmaxElement(Data<T>& data) : d(data) {}
+	void operator()() { bench::doNotOptimize(::minmax_element(d.a, d.n)); }
+};
+
+template <typename T>
+static void suite(std::string const & type, size_t n)
+{
+	Data<T> d(n);
+	std::ostringstream suffix;
+	suffix << "<" << type << "> n=" << n;
+	bench::run("whatever", "swap" + suffix.str(), n, PairSwap<T>(d));
+	bench::run("whatever", "min" + suffix.str(), n, PairMin<T>(d));
+	bench::run("whatever", "max" + suffix.str(), n, PairMax<T>(d));
+	bench::run("whatever", "range min" + suffix.str(), n, RangeMin<T>(d));
+	bench::run("whatever", "swap_ranges" + suffix.str(), n, RangeSwap<T>(d));
+	bench::run("whatever", "minmax_element" + suffix.str(), n, MinmaxElement<T>(d));
+}
+
+int main(void)
+{
+	bench::title("whatever.hpp suite (median, p99, TSC cycles/element)");
+	size_t const sizes[] = {1024, 1024 * 1024};
+	for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+	{
+		suite<int>("int", sizes[s]);
+		suite<double>("double", sizes[s]);
+		suite<std::string>("string", sizes[s] / 16);	// Heap-backed: fewer elements
+	}
+	return 0;
+}
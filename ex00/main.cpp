@@ -1,5 +1,6 @@
 #include <iostream>
 #include <string>
+#include <limits>
 #include "whatever.hpp"
 
 // ANSI Color codes
@@ -12,6 +13,58 @@
 #define CYAN    "\033[36m"
 #define BOLD    "\033[1m"
 
+// Helper function to print test results
+void printTest(std::string const & testName, bool success)
+{
+	if (success)
+		std::cout << GREEN << "✓ " << testName << RESET << std::endl;
+	else
+		std::cout << RED << "✗ " << testName << RESET << std::endl;
+}
+
+// Range results against the pair versions, element by element
+template <typename T>
+bool rangesMatchPairs(size_t n)
+{
+	T* a = new T[n];
+	T* b = new T[n];
+	T* lo = new T[n];
+	T* hi = new T[n];
+	for (size_t i = 0; i < n; i++)
+	{
+		a[i] = static_cast<T>((i * 37) % 101);
+		b[i] = static_cast<T>((i * 53) % 97);
+	}
+	::min(a, b, lo, n);
+	::max(a, b, hi, n);
+	bool ok = true;
+	for (size_t i = 0; i < n; i++)
+		ok = ok && lo[i] == ::min(a[i], b[i]) && hi[i] == ::max(a[i], b[i]);
+
+	// Scalar reference: first smallest, last largest
+	size_t first = 0;
+	size_t last = 0;
+	for (size_t i = 1; i < n; i++)
+	{
+		if (a[i] < a[first])
+			first = i;
+		if (!(a[i] < a[last]))
+			last = i;
+	}
+	std::pair<T const *, T const *> found = ::minmax_element(const_cast<T const *>(a), n);
+	ok = ok && found.first == a + first && found.second == a + last;
+
+	::swap_ranges(lo, hi, n);
+	for (size_t i = 0; i < n; i++)
+		ok = ok && lo[i] == ::max(a[i], b[i]) && hi[i] == ::min(a[i], b[i]);
+
+	delete[] a;
+	delete[] b;
+	delete[] lo;
+	delete[] hi;
+	return ok;
+}
+
 // Custom class for additional testing
 class Number
 {
@@ -26,6 +79,7 @@ class Number
 
 		bool operator<(Number const & rhs) const { return _value < rhs._value; }
 		bool operator>(Number const & rhs) const { return _value > rhs._value; }
+		bool operator==(Number const & rhs) const { return _value == rhs._value; }
 };
 
 std::ostream& operator<<(std::ostream& os, Number const & n)
@@ -111,6 +165,51 @@ int main(void)
 		std::cout << "max( n1, n2 ) = " << MAGENTA << ::max( n1, n2 ) << RESET << std::endl;
 	}
 
+	std::cout << BOLD << YELLOW << "\n=== Range versions ===" << RESET << std::endl;
+	{
+		int a[] = {5, 1, 9, 1, 7, 9, 3};
+		int b[] = {4, 2, 9, 0, 8, 6, 3};
+		int out[7];
+
+		::min(a, b, out, 7);
+		std::cout << "min(a, b):";
+		for (int i = 0; i < 7; i++)
+			std::cout << " " << BLUE << out[i] << RESET;
+		std::cout << std::endl;
+		printTest("Element-wise min", out[0] == 4 && out[3] == 0 && out[6] == 3);
+		::max(a, b, out, 7);
+		printTest("Element-wise max", out[0] == 5 && out[4] == 8 && out[5] == 9);
+
+		std::pair<int const *, int const *> mm = ::minmax_element(const_cast<int const *>(a), 7);
+		std::cout << "minmax_element: " << BLUE << *mm.first << RESET << " at " << mm.first - a
+			<< ", " << MAGENTA << *mm.second << RESET << " at " << mm.second - a << std::endl;
+		printTest("First smallest, last largest", mm.first == a + 1 && mm.second == a + 5);
+		printTest("Empty range gives end", ::minmax_element(a, 0).first == a);
+
+		printTest("int ranges (vector path + tail)", rangesMatchPairs<int>(1003));
+		printTest("char ranges", rangesMatchPairs<char>(77));
+		printTest("float ranges", rangesMatchPairs<float>(1003));
+		printTest("double ranges", rangesMatchPairs<double>(1003));
+		printTest("Number ranges (generic path)", rangesMatchPairs<Number>(101));
+
+		// NaN leaves the result unspecified, but it must stay inside the range
+		float const nan = std::numeric_limits<float>::quiet_NaN();
+		float withNan[] = {nan, 1, 2, 3, 4};
+		double manyNans[37];
+		for (int i = 0; i < 37; i++)
+			manyNans[i] = (i % 5 == 0) ? static_cast<double>(nan) : i;
+		std::pair<float const *, float const *> fm = ::minmax_element(const_cast<float const *>(withNan), 5);
+		std::pair<double const *, double const *> dm = ::minmax_element(const_cast<double const *>(manyNans), 37);
+		printTest("NaN data: positions stay inside the range", fm.first >= withNan && fm.first < withNan + 5
+			&& fm.second >= withNan && fm.second < withNan + 5 && dm.first >= manyNans && dm.first < manyNans + 37
+			&& dm.second >= manyNans && dm.second < manyNans + 37);
+
+		std::string s1[] = {"chaine1", "chaine2"};
+		std::string s2[] = {"autre1", "autre2"};
+		::swap_ranges(s1, s2, 2);
+		printTest("swap_ranges on strings", s1[1] == "autre2" && s2[0] == "chaine1");
+	}
+
 	std::cout << BOLD << GREEN << "\n✓ All tests completed!\n" << RESET << std::endl;
 
 	return 0;
@@ -1,6 +1,10 @@
 #ifndef WHATEVER_HPP
 #define WHATEVER_HPP
 
+#include <cstddef>
+#include <cstring>
+#include <utility>
+
 template <typename T>
 void swap(T& a, T& b)
 {
@@ -21,4 +25,287 @@ T const & max(T const & a, T const & b)
 	return (a > b) ? a : b;
 }
 
+// ==================== Range versions ====================
+
+// Same rules as the pair versions above, applied over whole ranges:
+//   ::min(a, b, out, n);               // out[i] = min(a[i], b[i])
+//   ::max(a, b, out, n);               // out[i] = max(a[i], b[i])
+//   ::minmax_element(a, n);            // first smallest, last largest
+//   ::swap_ranges(a, b, n);            // swap(a[i], b[i])
+// Arithmetic types go through branch-free vector code (GCC vector
+// extensions: 16-byte vectors, 32-byte when built with AVX2); other types
+// use plain loops. Ranges must not overlap, except out may be a or b.
+// Results are unspecified when floating-point data holds NaN (but
+// minmax_element still returns positions inside the range).
+
+namespace WhateverDetail
+{
+#if defined(__AVX2__)
+	size_t const VECTOR_BYTES = 32;
+#else
+	size_t const VECTOR_BYTES = 16;
+#endif
+
+	// Element types with a vector path
+	template <typename T>
+	struct Simd
+	{
+		static bool const value = false;
+	};
+
+#define WHATEVER_SIMD(T) \
+	template <> struct Simd<T> { static bool const value = true; };
+	WHATEVER_SIMD(char)
+	WHATEVER_SIMD(signed char)
+	WHATEVER_SIMD(unsigned char)
+	WHATEVER_SIMD(short)
+	WHATEVER_SIMD(unsigned short)
+	WHATEVER_SIMD(int)
+	WHATEVER_SIMD(unsigned int)
+	WHATEVER_SIMD(long)
+	WHATEVER_SIMD(unsigned long)
+	WHATEVER_SIMD(float)
+	WHATEVER_SIMD(double)
+#undef WHATEVER_SIMD
+
+	// One vector register worth of T. Loads and stores go through memcpy:
+	// no alignment requirement, compiled to a single unaligned move.
+	template <typename T>
+	struct Lanes
+	{
+		typedef T Reg __attribute__((vector_size(VECTOR_BYTES)));
+		enum { WIDTH = VECTOR_BYTES / sizeof(T) };
+
+		static Reg load(T const * p)
+		{
+			Reg r;
+			std::memcpy(&r, p, sizeof(r));
+			return r;
+		}
+
+		static void store(T* p, Reg const & r)
+		{
+			std::memcpy(p, &r, sizeof(r));
+		}
+
+		static Reg splat(T value)
+		{
+			T lane[WIDTH];
+			for (size_t k = 0; k < WIDTH; k++)
+				lane[k] = value;
+			return load(lane);
+		}
+
+		// True when any lane has a bit set
+		static bool any(Reg const & r)
+		{
+			unsigned long long words[VECTOR_BYTES / 8];
+			std::memcpy(words, &r, sizeof(words));
+			unsigned long long bits = 0;
+			for (size_t k = 0; k < VECTOR_BYTES / 8; k++)
+				bits |= words[k];
+			return bits != 0;
+		}
+	};
+
+	// Generic element types: plain loops over the pair versions
+	template <typename T, bool = Simd<T>::value>
+	struct Ranges
+	{
+		static void min(T const * a, T const * b, T* out, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+				out[i] = ::min(a[i], b[i]);
+		}
+
+		static void max(T const * a, T const * b, T* out, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+				out[i] = ::max(a[i], b[i]);
+		}
+
+		static std::pair<size_t, size_t> minmax(T const * a, size_t n)
+		{
+			size_t lo = 0;
+			size_t hi = 0;
+			for (size_t i = 1; i < n; i++)
+			{
+				if (a[i] < a[lo])
+					lo = i;
+				if (!(a[i] < a[hi]))
+					hi = i;
+			}
+			return std::make_pair(lo, hi);
+		}
+
+		static void swap(T* a, T* b, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+				::swap(a[i], b[i]);
+		}
+	};
+
+	// Arithmetic types: selects instead of branches, one vector at a time
+	template <typename T>
+	struct Ranges<T, true>
+	{
+		typedef Lanes<T> L;
+		typedef typename L::Reg Reg;
+
+		static void min(T const * a, T const * b, T* out, size_t n)
+		{
+			size_t const vectorEnd = n - n % L::WIDTH;
+			size_t i = 0;
+			for (; i < vectorEnd; i += L::WIDTH)
+			{
+				Reg x = L::load(a + i);
+				Reg y = L::load(b + i);
+				L::store(out + i, (x < y) ? x : y);
+			}
+			for (; i < n; i++)
+				out[i] = (a[i] < b[i]) ? a[i] : b[i];
+		}
+
+		static void max(T const * a, T const * b, T* out, size_t n)
+		{
+			size_t const vectorEnd = n - n % L::WIDTH;
+			size_t i = 0;
+			for (; i < vectorEnd; i += L::WIDTH)
+			{
+				Reg x = L::load(a + i);
+				Reg y = L::load(b + i);
+				L::store(out + i, (x > y) ? x : y);
+			}
+			for (; i < n; i++)
+				out[i] = (a[i] > b[i]) ? a[i] : b[i];
+		}
+
+		// Vector pass for the extreme values, then vector searches for their
+		// positions (first smallest, last largest)
+		static std::pair<size_t, size_t> minmax(T const * a, size_t n)
+		{
+			size_t const vectorEnd = n - n % L::WIDTH;
+			T lo = a[0];
+			T hi = a[0];
+			size_t i = 0;
+			if (vectorEnd > 0)
+			{
+				Reg vlo = L::load(a);
+				Reg vhi = vlo;
+				for (i = L::WIDTH; i < vectorEnd; i += L::WIDTH)
+				{
+					Reg x = L::load(a + i);
+					vlo = (x < vlo) ? x : vlo;
+					vhi = (x > vhi) ? x : vhi;
+				}
+				T lane[L::WIDTH];
+				L::store(lane, vlo);
+				lo = lane[0];
+				for (size_t k = 1; k < L::WIDTH; k++)
+					lo = (lane[k] < lo) ? lane[k] : lo;
+				L::store(lane, vhi);
+				hi = lane[0];
+				for (size_t k = 1; k < L::WIDTH; k++)
+					hi = (lane[k] > hi) ? lane[k] : hi;
+			}
+			for (; i < n; i++)
+			{
+				lo = (a[i] < lo) ? a[i] : lo;
+				hi = (a[i] > hi) ? a[i] : hi;
+			}
+			size_t first = findFirst(a, n, lo);
+			size_t last = findLast(a, n, hi);
+			if (first == n || last == n)	// NaN extreme: equal to nothing
+				return Ranges<T, false>::minmax(a, n);
+			return std::make_pair(first, last);
+		}
+
+		// Index of the first element equal to value, n when there is none
+		static size_t findFirst(T const * a, size_t n, T value)
+		{
+			size_t const vectorEnd = n - n % L::WIDTH;
+			Reg const v = L::splat(value);
+			Reg const one = L::splat(1);
+			Reg const zero = L::splat(0);
+			size_t i = 0;
+			for (; i < vectorEnd; i += L::WIDTH)
+				if (L::any((L::load(a + i) == v) ? one : zero))
+					break;
+			while (i < n && !(a[i] == value))
+				i++;
+			return i;
+		}
+
+		// Index of the last element equal to value, n when there is none
+		static size_t findLast(T const * a, size_t n, T value)
+		{
+			size_t const vectorEnd = n - n % L::WIDTH;
+			for (size_t i = n; i > vectorEnd; i--)
+				if (a[i - 1] == value)
+					return i - 1;
+			Reg const v = L::splat(value);
+			Reg const one = L::splat(1);
+			Reg const zero = L::splat(0);
+			size_t i = vectorEnd;
+			for (; i > 0; i -= L::WIDTH)
+				if (L::any((L::load(a + i - L::WIDTH) == v) ? one : zero))
+					break;
+			while (i > 0 && !(a[i - 1] == value))
+				i--;
+			return (i > 0) ? i - 1 : n;
+		}
+
+		static void swap(T* a, T* b, size_t n)
+		{
+			size_t const vectorEnd = n - n % L::WIDTH;
+			size_t i = 0;
+			for (; i < vectorEnd; i += L::WIDTH)
+			{
+				Reg x = L::load(a + i);
+				Reg y = L::load(b + i);
+				L::store(a + i, y);
+				L::store(b + i, x);
+			}
+			for (; i < n; i++)
+			{
+				T tmp = a[i];
+				a[i] = b[i];
+				b[i] = tmp;
+			}
+		}
+	};
+}
+
+// out[i] = min(a[i], b[i]) (b[i] when equal, like the pair version)
+template <typename T>
+void min(T const * a, T const * b, T* out, size_t n)
+{
+	WhateverDetail::Ranges<T>::min(a, b, out, n);
+}
+
+// out[i] = max(a[i], b[i]) (b[i] when equal, like the pair version)
+template <typename T>
+void max(T const * a, T const * b, T* out, size_t n)
+{
+	WhateverDetail::Ranges<T>::max(a, b, out, n);
+}
+
+// Pointers to the first smallest and the last largest element, like
+// std::minmax_element; both are a + n when n == 0
+template <typename T>
+std::pair<T const *, T const *> minmax_element(T const * a, size_t n)
+{
+	if (n == 0)
+		return std::make_pair(a + n, a + n);
+	std::pair<size_t, size_t> found = WhateverDetail::Ranges<T>::minmax(a, n);
+	return std::make_pair(a + found.first, a + found.second);
+}
+
+// swap(a[i], b[i]) for every i in [0, n)
+template <typename T>
+void swap_ranges(T* a, T* b, size_t n)
+{
+	WhateverDetail::Ranges<T>::swap(a, b, n);
+}
+
 #endif
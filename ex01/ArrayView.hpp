@@ -0,0 +1,160 @@
+#ifndef ARRAYVIEW_HPP
+#define ARRAYVIEW_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <stdexcept>
+
+// Non-owning views: a pointer and a length (plus a step for StridedView).
+// Copying a view never copies elements, and slicing never allocates.
+//   int raw[10];
+//   ArrayView<int> all(raw);                 // whole C array
+//   ArrayView<int> middle = all.slice(2, 8); // elements 2..7
+//   StridedView<int> even = all.stride(2);   // elements 0, 2, 4, ...
+//   ArrayView<int const> ro = all;           // read-only, implicit
+// Constness is that of T: ArrayView<int const> cannot modify elements,
+// whatever the constness of the view object itself. The viewed storage
+// must outlive the view.
+// operator[] is checked with assert() only; at() always checks and throws.
+
+template <typename T>
+class StridedView;
+
+namespace ViewDetail
+{
+	// Defines Type only when T is U const: the one conversion between
+	// views of different types
+	template <typename U, typename T>
+	struct Qualified
+	{
+	};
+	template <typename T>
+	struct Qualified<T, T const>
+	{
+		typedef void Type;
+	};
+}
+
+template <typename T>
+class ArrayView
+{
+	private:
+		T*		_data;
+		size_t	_size;
+
+	public:
+		ArrayView() : _data(NULL), _size(0) {}
+		ArrayView(T* data, size_t size) : _data(data), _size(size) {}
+
+		template <size_t N>
+		ArrayView(T (&array)[N]) : _data(array), _size(N) {}
+
+		// ArrayView<T> -> ArrayView<T const> only. No Derived -> Base:
+		// indexing would step by sizeof(Base) through Derived objects.
+		// `make conversions` checks that those are rejected.
+		template <typename U>
+		ArrayView(ArrayView<U> const & other, typename ViewDetail::Qualified<U, T>::Type* = 0)
+			: _data(other.data()), _size(other.size()) {}
+
+		T& operator[](size_t index) const
+		{
+			assert(index < _size);
+			return _data[index];
+		}
+
+		T& at(size_t index) const
+		{
+			if (index >= _size)
+				throw std::out_of_range("ArrayView: index out of bounds");
+			return _data[index];
+		}
+
+		T* data() const { return _data; }
+		T* begin() const { return _data; }
+		T* end() const { return _data + _size; }
+		size_t size() const { return _size; }
+		bool empty() const { return _size == 0; }
+
+		// Elements [begin, end)
+		ArrayView slice(size_t begin, size_t end) const
+		{
+			if (begin > end || end > _size)
+				throw std::out_of_range("ArrayView: slice out of bounds");
+			return ArrayView(_data + begin, end - begin);
+		}
+
+		ArrayView first(size_t count) const
+		{
+			return slice(0, count);
+		}
+
+		ArrayView last(size_t count) const
+		{
+			if (count > _size)
+				throw std::out_of_range("ArrayView: slice out of bounds");
+			return slice(_size - count, _size);
+		}
+
+		// Every step-th element, starting with the first
+		StridedView<T> stride(size_t step) const;
+};
+
+template <typename T>
+class StridedView
+{
+	private:
+		T*		_data;
+		size_t	_size;
+		size_t	_step;			// Distance between elements, in elements
+
+	public:
+		StridedView() : _data(NULL), _size(0), _step(1) {}
+		StridedView(T* data, size_t size, size_t step) : _data(data), _size(size), _step(step) {}
+
+		// StridedView<T> -> StridedView<T const> only, as for ArrayView
+		template <typename U>
+		StridedView(StridedView<U> const & other, typename ViewDetail::Qualified<U, T>::Type* = 0)
+			: _data(other.data()), _size(other.size()), _step(other.step()) {}
+
+		T& operator[](size_t index) const
+		{
+			assert(index < _size);
+			return _data[index * _step];
+		}
+
+		T& at(size_t index) const
+		{
+			if (index >= _size)
+				throw std::out_of_range("StridedView: index out of bounds");
+			return _data[index * _step];
+		}
+
+		T* data() const { return _data; }
+		size_t size() const { return _size; }
+		size_t step() const { return _step; }
+		bool empty() const { return _size == 0; }
+
+		StridedView slice(size_t begin, size_t end) const
+		{
+			if (begin > end || end > _size)
+				throw std::out_of_range("StridedView: slice out of bounds");
+			return StridedView(_data + begin * _step, end - begin, _step);
+		}
+
+		StridedView stride(size_t step) const
+		{
+			if (step == 0)
+				throw std::invalid_argument("StridedView: step must be positive");
+			return StridedView(_data, (_size + step - 1) / step, _step * step);
+		}
+};
+
+template <typename T>
+StridedView<T> ArrayView<T>::stride(size_t step) const
+{
+	if (step == 0)
+		throw std::invalid_argument("ArrayView: step must be positive");
+	return StridedView<T>(_data, (_size + step - 1) / step, step);
+}
+
+#endif
@@ -0,0 +1,257 @@
+#ifndef INSTRUMENT_HPP
+#define INSTRUMENT_HPP
+
+#include <pthread.h>
+#include <ctime>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+// Optional counters for Array and iter, compiled in with -DINSTRUMENT.
+// Without it the INSTRUMENT_* hooks below expand to nothing: no code, no
+// storage, no thread-local lookups.
+//
+// Each thread counts into its own block (no shared cache line, no locked
+// instruction); snapshot() sums the blocks of running threads plus the
+// totals left by threads that have exited.
+//   Instrument::Counters c = Instrument::snapshot();
+//   c[Instrument::DEEP_COPIES];              // copy ctor + copy assignment
+//   Instrument::publish();                   // snapshot -> exporter
+//   Instrument::setExporter(toStatsd, &ctx); // default: perf-style text on stderr
+//
+// A parallel iter counts one call per chunk.
+
+#ifdef INSTRUMENT
+# define INSTRUMENT_COUNT(event, n) Instrument::add(Instrument::event, (n))
+# define INSTRUMENT_ITER_SCOPE(length) Instrument::IterScope instrumentIterScope(length)
+#else
+# define INSTRUMENT_COUNT(event, n) ((void)0)
+# define INSTRUMENT_ITER_SCOPE(length) ((void)0)
+#endif
+
+class Instrument
+{
+	public:
+		enum Event
+		{
+			ALLOCATIONS,		// Array buffers allocated
+			ALLOCATED_BYTES,
+			DEEP_COPIES,		// Array copy constructions and copy assignments
+			BOUNDS_THROWS,		// Array::OutOfBoundsException thrown
+			ITER_CALLS,
+			ITER_ELEMENTS,
+			ITER_NS,			// Wall time spent inside iter
+			EVENTS
+		};
+
+		struct Counters
+		{
+			unsigned long long	value[EVENTS];
+
+			unsigned long long operator[](Event event) const { return value[event]; }
+		};
+
+		// Receives every publish(); context is passed back unchanged
+		typedef void (*Exporter)(Counters const & counters, void* context);
+
+	private:
+		// One per thread that counted something, linked into the registry
+		struct Block
+		{
+			unsigned long long	value[EVENTS];
+			Block*				next;
+		};
+
+		struct Registry
+		{
+			pthread_mutex_t		mutex;
+			Block*				live;
+			unsigned long long	retired[EVENTS];	// Totals of exited threads
+			Exporter			exporter;
+			void*				context;
+		};
+
+		static Registry& registry()
+		{
+			static Registry r = {PTHREAD_MUTEX_INITIALIZER, NULL, {0}, NULL, NULL};
+			return r;
+		}
+
+		static Block*& current()
+		{
+			static __thread Block* block = NULL;
+			return block;
+		}
+
+		// Thread exit: fold the block into the retired totals
+		static void retire(void* p)
+		{
+			Block* block = static_cast<Block*>(p);
+			Registry& r = registry();
+			pthread_mutex_lock(&r.mutex);
+			for (Block** link = &r.live; *link != NULL; link = &(*link)->next)
+			{
+				if (*link == block)
+				{
+					*link = block->next;
+					break;
+				}
+			}
+			for (int e = 0; e < EVENTS; e++)
+				r.retired[e] += __atomic_load_n(&block->value[e], __ATOMIC_RELAXED);
+			pthread_mutex_unlock(&r.mutex);
+			current() = NULL;
+			delete block;
+		}
+
+		static void createKey()
+		{
+			pthread_key_create(&key(), retire);
+		}
+
+		static pthread_key_t& key()
+		{
+			static pthread_key_t k;
+			return k;
+		}
+
+		static Block& attach()
+		{
+			static pthread_once_t once = PTHREAD_ONCE_INIT;
+			pthread_once(&once, createKey);
+			Block* block = new Block();
+			Registry& r = registry();
+			pthread_mutex_lock(&r.mutex);
+			block->next = r.live;
+			r.live = block;
+			pthread_mutex_unlock(&r.mutex);
+			pthread_setspecific(key(), block);
+			current() = block;
+			return *block;
+		}
+
+		static unsigned long long nowNs()
+		{
+			struct timespec ts;
+			clock_gettime(CLOCK_MONOTONIC, &ts);
+			return static_cast<unsigned long long>(ts.tv_sec) * 1000000000ULL
+				+ static_cast<unsigned long long>(ts.tv_nsec);
+		}
+
+		static void writeToStderr(Counters const & counters, void*)
+		{
+			writeText(std::cerr, counters);
+		}
+
+	public:
+		// Only the owning thread writes its block: a relaxed load and store
+		// (plain moves on x86) keep snapshot()'s concurrent reads race-free
+		static void add(Event event, unsigned long long n)
+		{
+			Block* block = current();
+			if (block == NULL)
+				block = &attach();
+			unsigned long long* slot = &block->value[event];
+			__atomic_store_n(slot, __atomic_load_n(slot, __ATOMIC_RELAXED) + n, __ATOMIC_RELAXED);
+		}
+
+		static Counters snapshot()
+		{
+			Counters c;
+			Registry& r = registry();
+			pthread_mutex_lock(&r.mutex);
+			for (int e = 0; e < EVENTS; e++)
+				c.value[e] = r.retired[e];
+			for (Block* b = r.live; b != NULL; b = b->next)
+				for (int e = 0; e < EVENTS; e++)
+					c.value[e] += __atomic_load_n(&b->value[e], __ATOMIC_RELAXED);
+			pthread_mutex_unlock(&r.mutex);
+			return c;
+		}
+
+		// Zeroes every counter. Counts made by other threads while this runs
+		// may survive it: call it while they are idle.
+		static void reset()
+		{
+			Registry& r = registry();
+			pthread_mutex_lock(&r.mutex);
+			for (int e = 0; e < EVENTS; e++)
+				r.retired[e] = 0;
+			for (Block* b = r.live; b != NULL; b = b->next)
+				for (int e = 0; e < EVENTS; e++)
+					__atomic_store_n(&b->value[e], 0ULL, __ATOMIC_RELAXED);
+			pthread_mutex_unlock(&r.mutex);
+		}
+
+		// NULL restores the default (writeText to std::cerr)
+		static void setExporter(Exporter exporter, void* context = NULL)
+		{
+			Registry& r = registry();
+			pthread_mutex_lock(&r.mutex);
+			r.exporter = exporter;
+			r.context = context;
+			pthread_mutex_unlock(&r.mutex);
+		}
+
+		// Hands a snapshot to the exporter
+		static void publish()
+		{
+			Registry& r = registry();
+			pthread_mutex_lock(&r.mutex);
+			Exporter exporter = (r.exporter != NULL) ? r.exporter : writeToStderr;
+			void* context = r.context;
+			pthread_mutex_unlock(&r.mutex);
+			exporter(snapshot(), context);
+		}
+
+		static char const * name(Event event)
+		{
+			static char const * const names[EVENTS] = {
+				"array.allocations", "array.allocated_bytes", "array.deep_copies",
+				"array.bounds_throws", "iter.calls", "iter.elements", "iter.ns"
+			};
+			return names[event];
+		}
+
+		// Laid out like `perf stat`: right-aligned counts with thousands
+		// separators, then the event name
+		static void writeText(std::ostream& out, Counters const & counters)
+		{
+			out << std::endl << " Instrumentation counter stats:" << std::endl << std::endl;
+			for (int e = 0; e < EVENTS; e++)
+			{
+				std::ostringstream digits;
+				digits << counters.value[e];
+				std::string grouped = digits.str();
+				for (size_t i = grouped.size(); i > 3; i -= 3)
+					grouped.insert(i - 3, ",");
+				out << std::setw(20) << grouped << "      " << name(static_cast<Event>(e)) << std::endl;
+			}
+			out << std::endl;
+		}
+
+		// Times one iter call and counts its elements
+		class IterScope
+		{
+			private:
+				size_t				_length;
+				unsigned long long	_start;
+
+				IterScope(IterScope const & src);
+				IterScope& operator=(IterScope const & rhs);
+
+			public:
+				explicit IterScope(size_t length) : _length(length), _start(nowNs()) {}
+
+				~IterScope()
+				{
+					add(ITER_CALLS, 1);
+					add(ITER_ELEMENTS, _length);
+					add(ITER_NS, nowNs() - _start);
+				}
+		};
+};
+
+#endif
@@ -0,0 +1,133 @@
+#ifndef PARALLELITER_HPP
+#define PARALLELITER_HPP
+
+#include <cstddef>
+#include "iter.hpp"
+#include "ThreadPool.hpp"
+
+// Execution policy for the parallel iter overload:
+//   iter(par, array, length, func);                 // automatic grain
+//   iter(ParallelPolicy(4096), array, length, func); // 4096 elements per chunk
+// func is called concurrently from several threads, so it must not modify
+// shared state without synchronization.
+struct ParallelPolicy
+{
+	size_t		grain;			// Elements per chunk, 0 = automatic
+	ThreadPool*	pool;			// NULL = ThreadPool::shared()
+
+	explicit ParallelPolicy(size_t grainSize = 0, ThreadPool* threadPool = NULL)
+		: grain(grainSize), pool(threadPool)
+	{
+	}
+};
+
+ParallelPolicy const par = ParallelPolicy();
+
+namespace IterDetail
+{
+	size_t const CACHE_LINE = 64;
+
+	// Below this many elements a parallel split costs more than it saves
+	size_t const SERIAL_THRESHOLD = 4096;
+
+	// Chunk i covers [begin(i), begin(i + 1)). Every chunk but the first
+	// starts on a cache-line boundary, so no two threads write to the same line.
+	struct Chunks
+	{
+		size_t	length;
+		size_t	head;			// Elements before the first aligned address
+		size_t	chunk;			// Elements per chunk (whole cache lines)
+
+		size_t begin(size_t index) const
+		{
+			if (index == 0)
+				return 0;
+			size_t start = head + (index - 1) * chunk;
+			if (head == 0)
+				start += chunk;
+			return (start < length) ? start : length;
+		}
+
+		size_t count() const
+		{
+			size_t n = (head > 0) ? 1 : 0;
+			if (length > head)
+				n += (length - head + chunk - 1) / chunk;
+			return n;
+		}
+	};
+
+	// Splits [0, length) of array for `threads` threads. Chunk sizes are
+	// whole cache lines when T divides a line evenly; grain 0 gives about
+	// 8 chunks per thread for balance.
+	template <typename T>
+	Chunks alignedChunks(T const * array, size_t length, size_t grain, size_t threads)
+	{
+		size_t line = (CACHE_LINE % sizeof(T) == 0) ? CACHE_LINE / sizeof(T) : 1;
+		if (grain == 0)
+			grain = length / (threads * 8);
+		if (grain < line)
+			grain = line;
+		grain = (grain + line - 1) / line * line;
+
+		size_t misalign = reinterpret_cast<size_t>(array) % CACHE_LINE;
+		size_t head = 0;
+		if (line > 1 && misalign != 0 && misalign % sizeof(T) == 0)
+			head = (CACHE_LINE - misalign) / sizeof(T);
+		if (head > length)
+			head = length;
+
+		Chunks chunks = {length, head, grain};
+		return chunks;
+	}
+
+	template <typename T, typename F>
+	struct ChunkTask
+	{
+		T*		array;
+		Chunks	chunks;
+		F&		func;
+
+		ChunkTask(T* a, Chunks const & c, F& f) : array(a), chunks(c), func(f)
+		{
+		}
+
+		void operator()(size_t index)
+		{
+			size_t end = chunks.begin(index + 1);
+			INSTRUMENT_ITER_SCOPE(end - chunks.begin(index));
+			for (size_t i = chunks.begin(index); i < end; i++)
+				func(array[i]);
+		}
+	};
+}
+
+// Parallel iter: splits [0, length) into cache-line-aligned chunks and runs
+// them on the policy's pool. Falls back to the sequential iter for short
+// ranges or single-thread pools. The first exception thrown by func is
+// rethrown here once all chunks have run.
+template <typename T, typename F>
+void iter(ParallelPolicy const & policy, T* array, size_t length, F func)
+{
+	if (array == NULL)
+		return;
+
+	ThreadPool& pool = (policy.pool != NULL) ? *policy.pool : ThreadPool::shared();
+	if (length < IterDetail::SERIAL_THRESHOLD || pool.size() == 1)
+	{
+		::iter(array, length, func);
+		return;
+	}
+
+	IterDetail::Chunks chunks = IterDetail::alignedChunks(array, length, policy.grain, pool.size());
+	IterDetail::ChunkTask<T, F> task(array, chunks, func);
+	pool.run(task, chunks.count());
+}
+
+template <typename T, typename F>
+void iter(ParallelPolicy const & policy, ArrayView<T> view, F func)
+{
+	::iter(policy, view.data(), view.size(), func);
+}
+
+#endif
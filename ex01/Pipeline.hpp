@@ -0,0 +1,373 @@
+#ifndef PIPELINE_HPP
+#define PIPELINE_HPP
+
+#include <cstddef>
+#include <vector>
+#include "iter.hpp"
+#include "ArrayView.hpp"
+#include "ParallelIter.hpp"
+
+// Lazy pipelines: stages are recorded, nothing runs until a terminal
+// operation, which then makes ONE pass over the array and sends each
+// element through every stage before moving to the next element.
+//   pipeline(array, length)
+//       .apply(incrementElement<int>)      // f(x) in place
+//       .apply(doubleValue<int>)
+//       .each(printElement<int>);          // one pass instead of three iter
+//
+//   long sum = pipeline(view)
+//       .map(square)                       // x -> f(x), any result type
+//       .filter(isEven)                    // drops x when !pred(x)
+//       .reduce(0L, add);                  // add(add(0, x0), x1)...
+//
+//   size_t n = pipeline(view).filter(isEven).into(out);   // compacted copy
+//
+// apply() on source elements writes to the array; after a map() it works
+// on the mapped value. Stages are functions or functors copied into the
+// pipeline; every stage is a template parameter, so the whole chain
+// compiles to a single loop. Functors inline into it; plain functions
+// are called through a pointer unless the compiler can prove the target,
+// which keeps hot loops from vectorizing.
+//
+// each() and reduce() also take a ParallelPolicy: the array is split into
+// chunks run on the policy's pool, with the same short-range fallback as
+// the parallel iter. Stage functions are then called concurrently. The
+// parallel reduce starts every chunk from `identity`, so it must be op's
+// identity (0 for +) and op must be associative; chunk results are
+// combined in index order.
+
+namespace PipelineDetail
+{
+	// Sinks receive every value that reaches their stage and pass the
+	// result on to Next. Values arrive as lvalues (source elements, which
+	// apply() may modify) or as const references (results of a map).
+	// finish() runs once after the last element.
+
+	template <typename F, typename Next>
+	struct MapSink
+	{
+		F		f;
+		Next	next;
+
+		MapSink(F fn, Next const & n) : f(fn), next(n) {}
+
+		template <typename V>
+		void operator()(V& value) { next(f(value)); }
+		template <typename V>
+		void operator()(V const & value) { next(f(value)); }
+
+		void finish() { next.finish(); }
+	};
+
+	template <typename F, typename Next>
+	struct FilterSink
+	{
+		F		pred;
+		Next	next;
+
+		FilterSink(F fn, Next const & n) : pred(fn), next(n) {}
+
+		template <typename V>
+		void operator()(V& value)
+		{
+			if (pred(value))
+				next(value);
+		}
+		template <typename V>
+		void operator()(V const & value)
+		{
+			if (pred(value))
+				next(value);
+		}
+
+		void finish() { next.finish(); }
+	};
+
+	// Mapped values are temporaries: they are modified through a copy
+	template <typename F, typename Next>
+	struct ApplySink
+	{
+		F		f;
+		Next	next;
+
+		ApplySink(F fn, Next const & n) : f(fn), next(n) {}
+
+		template <typename V>
+		void operator()(V& value)
+		{
+			f(value);
+			next(value);
+		}
+		template <typename V>
+		void operator()(V const & value)
+		{
+			V copy(value);
+			f(copy);
+			next(copy);
+		}
+
+		void finish() { next.finish(); }
+	};
+
+	// ==================== Terminals ====================
+
+	template <typename F>
+	struct EachSink
+	{
+		F	func;
+
+		EachSink(F fn) : func(fn) {}
+
+		template <typename V>
+		void operator()(V& value) { func(value); }
+		template <typename V>
+		void operator()(V const & value) { func(value); }
+
+		void finish() {}
+	};
+
+	// Terminals keep their state in the sink, where the compiler can hold
+	// it in registers during the loop; finish() stores it for the caller
+	template <typename A, typename Op>
+	struct ReduceSink
+	{
+		A	acc;
+		Op	op;
+		A*	result;
+
+		ReduceSink(A* out, Op fn) : acc(*out), op(fn), result(out) {}
+
+		template <typename V>
+		void operator()(V const & value) { acc = op(acc, value); }
+
+		void finish() { *result = acc; }
+	};
+
+	template <typename U>
+	struct IntoSink
+	{
+		U*	cursor;
+		U**	result;
+
+		IntoSink(U** out) : cursor(*out), result(out) {}
+
+		template <typename V>
+		void operator()(V const & value) { *cursor++ = value; }
+
+		void finish() { *result = cursor; }
+	};
+
+	// ==================== Stage lists ====================
+
+	// No stage: values go straight to the terminal
+	struct Source
+	{
+		template <typename Sink>
+		struct Bound
+		{
+			typedef Sink Type;
+		};
+
+		template <typename Sink>
+		Sink bind(Sink const & sink) const
+		{
+			return sink;
+		}
+	};
+
+	// Prev's stages followed by one SinkType stage running f. bind() wraps
+	// a terminal from the last stage back to the first, giving the sink
+	// that the source elements are pushed into.
+	template <typename Prev, template <typename, typename> class SinkType, typename F>
+	struct Stage
+	{
+		Prev	prev;
+		F		f;
+
+		Stage(Prev const & p, F fn) : prev(p), f(fn) {}
+
+		template <typename Sink>
+		struct Bound
+		{
+			typedef typename Prev::template Bound<SinkType<F, Sink> >::Type Type;
+		};
+
+		template <typename Sink>
+		typename Bound<Sink>::Type bind(Sink const & sink) const
+		{
+			return prev.bind(SinkType<F, Sink>(f, sink));
+		}
+	};
+
+	// Pushes [begin, end) through a freshly bound chain
+	template <typename T, typename Stages, typename Terminal>
+	void run(T* data, size_t begin, size_t end, Stages const & stages, Terminal const & terminal)
+	{
+		typename Stages::template Bound<Terminal>::Type sink = stages.bind(terminal);
+		for (size_t i = begin; i < end; i++)
+			sink(data[i]);
+		sink.finish();
+	}
+
+	// Parallel terminals split the source like iter(par, ...) does
+	// (IterDetail::alignedChunks), so chunks start on cache lines
+	inline bool runsSerially(ThreadPool& pool, size_t length)
+	{
+		return length < IterDetail::SERIAL_THRESHOLD || pool.size() == 1;
+	}
+
+	template <typename T, typename Stages, typename F>
+	struct EachChunk
+	{
+		T*					data;
+		IterDetail::Chunks	chunks;
+		Stages const &		stages;
+		F const &			func;
+
+		EachChunk(T* d, IterDetail::Chunks const & c, Stages const & s, F const & f)
+			: data(d), chunks(c), stages(s), func(f)
+		{
+		}
+
+		void operator()(size_t index)
+		{
+			run(data, chunks.begin(index), chunks.begin(index + 1), stages, EachSink<F>(func));
+		}
+	};
+
+	// Chunk i reduces into partials[i]
+	template <typename T, typename Stages, typename A, typename Op>
+	struct ReduceChunk
+	{
+		T*					data;
+		IterDetail::Chunks	chunks;
+		Stages const &		stages;
+		Op const &			op;
+		std::vector<A>&		partials;
+
+		ReduceChunk(T* d, IterDetail::Chunks const & c, Stages const & s, Op const & o, std::vector<A>& p)
+			: data(d), chunks(c), stages(s), op(o), partials(p)
+		{
+		}
+
+		void operator()(size_t index)
+		{
+			run(data, chunks.begin(index), chunks.begin(index + 1), stages,
+				ReduceSink<A, Op>(&partials[index], op));
+		}
+	};
+}
+
+template <typename T, typename Stages = PipelineDetail::Source>
+class Pipeline
+{
+	private:
+		T*		_data;
+		size_t	_size;
+		Stages	_stages;
+
+		ThreadPool& poolOf(ParallelPolicy const & policy) const
+		{
+			return (policy.pool != NULL) ? *policy.pool : ThreadPool::shared();
+		}
+
+	public:
+		Pipeline(T* data, size_t size, Stages const & stages = Stages())
+			: _data(data), _size(size), _stages(stages)
+		{
+		}
+
+		// ==================== Stages (lazy) ====================
+
+		template <typename F>
+		Pipeline<T, PipelineDetail::Stage<Stages, PipelineDetail::MapSink, F> > map(F f) const
+		{
+			typedef PipelineDetail::Stage<Stages, PipelineDetail::MapSink, F> Next;
+			return Pipeline<T, Next>(_data, _size, Next(_stages, f));
+		}
+
+		template <typename F>
+		Pipeline<T, PipelineDetail::Stage<Stages, PipelineDetail::FilterSink, F> > filter(F pred) const
+		{
+			typedef PipelineDetail::Stage<Stages, PipelineDetail::FilterSink, F> Next;
+			return Pipeline<T, Next>(_data, _size, Next(_stages, pred));
+		}
+
+		template <typename F>
+		Pipeline<T, PipelineDetail::Stage<Stages, PipelineDetail::ApplySink, F> > apply(F f) const
+		{
+			typedef PipelineDetail::Stage<Stages, PipelineDetail::ApplySink, F> Next;
+			return Pipeline<T, Next>(_data, _size, Next(_stages, f));
+		}
+
+		// ==================== Terminals (one pass) ====================
+
+		template <typename F>
+		void each(F func) const
+		{
+			if (_data != NULL)
+				PipelineDetail::run(_data, 0, _size, _stages, PipelineDetail::EachSink<F>(func));
+		}
+
+		template <typename A, typename Op>
+		A reduce(A init, Op op) const
+		{
+			if (_data != NULL)
+				PipelineDetail::run(_data, 0, _size, _stages, PipelineDetail::ReduceSink<A, Op>(&init, op));
+			return init;
+		}
+
+		// Writes the surviving values to out[0], out[1]...; returns their count
+		template <typename U>
+		size_t into(U* out) const
+		{
+			U* cursor = out;
+			if (_data != NULL)
+				PipelineDetail::run(_data, 0, _size, _stages, PipelineDetail::IntoSink<U>(&cursor));
+			return static_cast<size_t>(cursor - out);
+		}
+
+		template <typename F>
+		void each(ParallelPolicy const & policy, F func) const
+		{
+			ThreadPool& pool = poolOf(policy);
+			if (_data == NULL || PipelineDetail::runsSerially(pool, _size))
+			{
+				each(func);
+				return;
+			}
+			IterDetail::Chunks chunks = IterDetail::alignedChunks(_data, _size, policy.grain, pool.size());
+			PipelineDetail::EachChunk<T, Stages, F> task(_data, chunks, _stages, func);
+			pool.run(task, chunks.count());
+		}
+
+		template <typename A, typename Op>
+		A reduce(ParallelPolicy const & policy, A identity, Op op) const
+		{
+			ThreadPool& pool = poolOf(policy);
+			if (_data == NULL || PipelineDetail::runsSerially(pool, _size))
+				return reduce(identity, op);
+			IterDetail::Chunks chunks = IterDetail::alignedChunks(_data, _size, policy.grain, pool.size());
+			std::vector<A> partials(chunks.count(), identity);
+			PipelineDetail::ReduceChunk<T, Stages, A, Op> task(_data, chunks, _stages, op, partials);
+			pool.run(task, partials.size());
+			A result = identity;
+			for (size_t i = 0; i < partials.size(); i++)
+				result = op(result, partials[i]);
+			return result;
+		}
+};
+
+template <typename T>
+Pipeline<T> pipeline(T* array, size_t length)
+{
+	return Pipeline<T>(array, length);
+}
+
+template <typename T>
+Pipeline<T> pipeline(ArrayView<T> view)
+{
+	return Pipeline<T>(view.data(), view.size());
+}
+
+#endif
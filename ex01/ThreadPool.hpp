@@ -0,0 +1,561 @@
+#ifndef THREADPOOL_HPP
+#define THREADPOOL_HPP
+
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <cstddef>
+#include <deque>
+#include <stdexcept>
+#include <string>
+#if __cplusplus >= 201103L
+# include <exception>
+#endif
+
+// Work-stealing scheduler with a fork-join API (C++98 + pthreads + GCC
+// __atomic builtins).
+//
+// Every worker owns a deque: it pushes and pops spawned tasks at the bottom
+// (LIFO, cache-warm) while idle workers steal from the top (FIFO, the largest
+// pieces of work) without taking a lock. Tasks spawned from outside the pool
+// go through a small mutex-protected injection queue. Waiting threads execute
+// pending tasks instead of blocking, so fork-join nests freely.
+//
+//   ThreadPool pool(4);
+//   pool.parallelFor(0, n, 1024, body);        // body(begin, end) per range
+//   pool.run(task, count);                     // task(i) for i in [0, count)
+//
+//   TaskGroup group(pool);                     // explicit fork-join
+//   group.spawn(someTask);                     // Task subclass, must outlive wait()
+//   group.wait();
+
+class ThreadPool;
+class TaskGroup;
+
+// Exception rethrown by TaskGroup::wait when a task failed (C++98 builds).
+// C++11 builds rethrow the original exception object instead.
+class ParallelError : public std::runtime_error
+{
+	public:
+		explicit ParallelError(std::string const & message) : std::runtime_error(message) {}
+};
+
+// Unit of work. The spawner owns the object and keeps it alive until the
+// group it was spawned in has been waited on.
+class Task
+{
+	private:
+		TaskGroup*	_group;
+
+		friend class TaskGroup;
+		friend class ThreadPool;
+
+	public:
+		Task() : _group(NULL) {}
+		virtual ~Task() {}
+		virtual void execute() = 0;
+};
+
+// Set of spawned tasks that can be waited for together
+class TaskGroup
+{
+	private:
+		ThreadPool&	_pool;
+		long		_pending;			// Spawned but not finished (atomic)
+		int			_failed;			// First failure claimed (atomic)
+#if __cplusplus >= 201103L
+		std::exception_ptr	_error;
+#else
+		std::string	_message;
+#endif
+
+		TaskGroup(TaskGroup const & src);			// Non-copyable
+		TaskGroup& operator=(TaskGroup const & rhs);
+
+		friend class ThreadPool;
+		void recordError();
+		void finish();
+		void helpUntilDone();
+
+	public:
+		explicit TaskGroup(ThreadPool& pool);
+		~TaskGroup();
+
+		void spawn(Task& task);
+
+		// Runs pending work until every spawned task has finished, then
+		// rethrows the first exception one of them threw
+		void wait();
+};
+
+// Single-owner deque of Chase & Lev ("Dynamic Circular Work-Stealing Deque",
+// SPAA 2005), fixed capacity: push() fails when full and the caller runs the
+// task itself. The store/load pairs that must not be reordered use seq_cst
+// operations rather than standalone fences (ThreadSanitizer cannot model
+// fences).
+class WorkDeque
+{
+	private:
+		enum { CAPACITY = 4096 };		// Power of two
+
+		long	_top;					// Next slot to steal (atomic)
+		char	_pad[64 - sizeof(long)];	// Keep thieves off the owner's line
+		long	_bottom;				// Next slot to push (atomic, owner writes)
+		Task*	_slots[CAPACITY];
+
+	public:
+		WorkDeque() : _top(0), _bottom(0)
+		{
+		}
+
+		// Owner only
+		bool push(Task* task)
+		{
+			long b = __atomic_load_n(&_bottom, __ATOMIC_RELAXED);
+			long t = __atomic_load_n(&_top, __ATOMIC_ACQUIRE);
+			if (b - t >= CAPACITY)
+				return false;
+			__atomic_store_n(&_slots[b & (CAPACITY - 1)], task, __ATOMIC_RELAXED);
+			__atomic_store_n(&_bottom, b + 1, __ATOMIC_SEQ_CST);
+			return true;
+		}
+
+		// Owner only: most recently pushed task, or NULL
+		Task* pop()
+		{
+			long b = __atomic_load_n(&_bottom, __ATOMIC_RELAXED) - 1;
+			__atomic_store_n(&_bottom, b, __ATOMIC_SEQ_CST);
+			long t = __atomic_load_n(&_top, __ATOMIC_SEQ_CST);
+			if (t > b)
+			{
+				__atomic_store_n(&_bottom, b + 1, __ATOMIC_RELAXED);
+				return NULL;
+			}
+			Task* task = __atomic_load_n(&_slots[b & (CAPACITY - 1)], __ATOMIC_RELAXED);
+			if (t == b)
+			{
+				// Last element: race against thieves for it
+				if (!__atomic_compare_exchange_n(&_top, &t, t + 1, false,
+						__ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+					task = NULL;
+				__atomic_store_n(&_bottom, b + 1, __ATOMIC_RELAXED);
+			}
+			return task;
+		}
+
+		// Any thread: oldest task, or NULL if empty or the race was lost
+		Task* steal()
+		{
+			long t = __atomic_load_n(&_top, __ATOMIC_SEQ_CST);
+			long b = __atomic_load_n(&_bottom, __ATOMIC_SEQ_CST);
+			if (t >= b)
+				return NULL;
+			Task* task = __atomic_load_n(&_slots[t & (CAPACITY - 1)], __ATOMIC_RELAXED);
+			if (!__atomic_compare_exchange_n(&_top, &t, t + 1, false,
+					__ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+				return NULL;
+			return task;
+		}
+
+		bool empty() const
+		{
+			return __atomic_load_n(&_top, __ATOMIC_SEQ_CST) >= __atomic_load_n(&_bottom, __ATOMIC_SEQ_CST);
+		}
+};
+
+class ThreadPool
+{
+	private:
+		struct Worker
+		{
+			WorkDeque		deque;
+			ThreadPool*		pool;
+			unsigned int	index;
+			unsigned int	seed;			// Victim selection (xorshift)
+			pthread_t		thread;
+		};
+
+		Worker*				_workers;
+		unsigned int		_workerCount;	// Atomic: grows while workers start
+		pthread_mutex_t		_mutex;			// Guards _injected and sleeping
+		pthread_cond_t		_wake;
+		std::deque<Task*>	_injected;		// Tasks spawned by outside threads
+		int					_injectedCount;	// Atomic mirror of _injected.size()
+		int					_sleepers;		// Atomic
+		int					_stopping;		// Atomic
+
+		ThreadPool(ThreadPool const & src);			// Non-copyable
+		ThreadPool& operator=(ThreadPool const & rhs);
+
+		friend class TaskGroup;
+
+		// Worker record of the calling thread, NULL outside any pool
+		static Worker*& currentWorker()
+		{
+			static __thread Worker* current = NULL;
+			return current;
+		}
+
+		Worker* self()
+		{
+			Worker* w = currentWorker();
+			return (w != NULL && w->pool == this) ? w : NULL;
+		}
+
+		unsigned int workers() const
+		{
+			return __atomic_load_n(&_workerCount, __ATOMIC_ACQUIRE);
+		}
+
+		void push(Task* task)
+		{
+			Worker* w = self();
+			if (w != NULL)
+			{
+				if (!w->deque.push(task))
+				{
+					execute(task);			// Deque full: run it now
+					return;
+				}
+			}
+			else
+			{
+				pthread_mutex_lock(&_mutex);
+				_injected.push_back(task);
+				__atomic_add_fetch(&_injectedCount, 1, __ATOMIC_SEQ_CST);
+				pthread_mutex_unlock(&_mutex);
+			}
+			// Publishing stores above are seq_cst, so this load cannot be
+			// reordered before them (pairs with the increment in idle())
+			if (__atomic_load_n(&_sleepers, __ATOMIC_SEQ_CST) > 0)
+			{
+				pthread_mutex_lock(&_mutex);
+				pthread_cond_signal(&_wake);
+				pthread_mutex_unlock(&_mutex);
+			}
+		}
+
+		Task* takeInjected()
+		{
+			if (__atomic_load_n(&_injectedCount, __ATOMIC_ACQUIRE) == 0)
+				return NULL;
+			Task* task = NULL;
+			pthread_mutex_lock(&_mutex);
+			if (!_injected.empty())
+			{
+				task = _injected.front();
+				_injected.pop_front();
+				__atomic_sub_fetch(&_injectedCount, 1, __ATOMIC_SEQ_CST);
+			}
+			pthread_mutex_unlock(&_mutex);
+			return task;
+		}
+
+		// Own deque first, then a sweep over the other workers starting at a
+		// random victim, then the injection queue
+		Task* findTask(Worker* w)
+		{
+			Task* task = NULL;
+			if (w != NULL && (task = w->deque.pop()) != NULL)
+				return task;
+
+			unsigned int count = workers();
+			unsigned int start = 0;
+			if (w != NULL)
+			{
+				w->seed ^= w->seed << 13;
+				w->seed ^= w->seed >> 17;
+				w->seed ^= w->seed << 5;
+				start = w->seed;
+			}
+			for (unsigned int i = 0; i < count; i++)
+			{
+				Worker& victim = _workers[(start + i) % count];
+				if (&victim != w && (task = victim.deque.steal()) != NULL)
+					return task;
+			}
+			return takeInjected();
+		}
+
+		bool hasWork() const
+		{
+			if (__atomic_load_n(&_injectedCount, __ATOMIC_ACQUIRE) > 0)
+				return true;
+			unsigned int count = workers();
+			for (unsigned int i = 0; i < count; i++)
+				if (!_workers[i].deque.empty())
+					return true;
+			return false;
+		}
+
+		void execute(Task* task)
+		{
+			TaskGroup* group = task->_group;
+			try
+			{
+				task->execute();
+			}
+			catch (...)
+			{
+				group->recordError();
+			}
+			group->finish();
+		}
+
+		// Spin briefly, then sleep until a spawn signals new work. The sleeper
+		// count is published before the final check, and spawners check it
+		// after publishing their task, so a wake-up cannot be lost.
+		void idle(unsigned int& spins)
+		{
+			if (++spins < 64)
+			{
+				sched_yield();
+				return;
+			}
+			spins = 0;
+			pthread_mutex_lock(&_mutex);
+			__atomic_add_fetch(&_sleepers, 1, __ATOMIC_SEQ_CST);
+			if (!__atomic_load_n(&_stopping, __ATOMIC_ACQUIRE) && !hasWork())
+				pthread_cond_wait(&_wake, &_mutex);
+			__atomic_sub_fetch(&_sleepers, 1, __ATOMIC_SEQ_CST);
+			pthread_mutex_unlock(&_mutex);
+		}
+
+		static void* workerMain(void* arg)
+		{
+			Worker* w = static_cast<Worker*>(arg);
+			ThreadPool& pool = *w->pool;
+			currentWorker() = w;
+			unsigned int spins = 0;
+
+			while (!__atomic_load_n(&pool._stopping, __ATOMIC_ACQUIRE))
+			{
+				Task* task = pool.findTask(w);
+				if (task != NULL)
+				{
+					pool.execute(task);
+					spins = 0;
+				}
+				else
+					pool.idle(spins);
+			}
+			return NULL;
+		}
+
+		// Forks the upper half of the range as a stealable task and recurses
+		// into the lower half until ranges are at most `grain` long
+		template <typename Body>
+		struct RangeTask : public Task
+		{
+			ThreadPool&	pool;
+			Body&		body;
+			size_t		begin;
+			size_t		end;
+			size_t		grain;
+
+			RangeTask(ThreadPool& p, Body& b, size_t first, size_t last, size_t g)
+				: pool(p), body(b), begin(first), end(last), grain(g)
+			{
+			}
+
+			virtual void execute()
+			{
+				pool.parallelFor(begin, end, grain, body);
+			}
+		};
+
+		// Adapts a per-index task to parallelFor's per-range body
+		template <typename IndexTask>
+		struct EachIndex
+		{
+			IndexTask&	task;
+			EachIndex(IndexTask& t) : task(t) {}
+			void operator()(size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; i++)
+					task(i);
+			}
+		};
+
+	public:
+		// threads counts the calling thread: ThreadPool(4) starts 3 workers.
+		// 0 means one thread per online CPU.
+		explicit ThreadPool(unsigned int threads = 0)
+			: _workers(NULL), _workerCount(0), _injectedCount(0), _sleepers(0), _stopping(0)
+		{
+			if (threads == 0)
+				threads = hardwareThreads();
+			pthread_mutex_init(&_mutex, NULL);
+			pthread_cond_init(&_wake, NULL);
+
+			_workers = new Worker[threads];
+			for (unsigned int i = 0; i + 1 < threads; i++)
+			{
+				Worker& w = _workers[_workerCount];
+				w.pool = this;
+				w.index = _workerCount;
+				w.seed = 2654435761u * (_workerCount + 1);
+				if (pthread_create(&w.thread, NULL, workerMain, &w) != 0)
+					break;
+				__atomic_store_n(&_workerCount, _workerCount + 1, __ATOMIC_RELEASE);
+			}
+		}
+
+		~ThreadPool()
+		{
+			pthread_mutex_lock(&_mutex);
+			__atomic_store_n(&_stopping, 1, __ATOMIC_RELEASE);
+			pthread_cond_broadcast(&_wake);
+			pthread_mutex_unlock(&_mutex);
+			for (unsigned int i = 0; i < _workerCount; i++)
+				pthread_join(_workers[i].thread, NULL);
+			delete[] _workers;
+			pthread_cond_destroy(&_wake);
+			pthread_mutex_destroy(&_mutex);
+		}
+
+		// Threads taking part in parallel work, including the caller
+		unsigned int size() const
+		{
+			return _workerCount + 1;
+		}
+
+		// Index of the calling worker thread in [0, size() - 1), -1 outside the pool
+		int currentIndex()
+		{
+			Worker* w = self();
+			return (w != NULL) ? static_cast<int>(w->index) : -1;
+		}
+
+		// Calls body(b, e) over sub-ranges of [begin, end) no longer than grain.
+		// body must be safe to call concurrently. Rethrows the first exception.
+		template <typename Body>
+		void parallelFor(size_t begin, size_t end, size_t grain, Body& body)
+		{
+			if (grain == 0)
+				grain = 1;
+			if (end <= begin)
+				return;
+			if (end - begin <= grain || workers() == 0)
+			{
+				body(begin, end);
+				return;
+			}
+
+			size_t middle = begin + (end - begin) / 2;
+			TaskGroup group(*this);
+			RangeTask<Body> upper(*this, body, middle, end, grain);
+			group.spawn(upper);
+			try
+			{
+				parallelFor(begin, middle, grain, body);
+			}
+			catch (...)
+			{
+				group.helpUntilDone();		// upper lives on this stack frame
+				throw;
+			}
+			group.wait();
+		}
+
+		// Calls task(i) for i in [0, count), one index per stealable piece
+		template <typename IndexTask>
+		void run(IndexTask& task, size_t count)
+		{
+			EachIndex<IndexTask> body(task);
+			parallelFor(0, count, 1, body);
+		}
+
+		static unsigned int hardwareThreads()
+		{
+			long count = sysconf(_SC_NPROCESSORS_ONLN);
+			return (count > 0) ? static_cast<unsigned int>(count) : 1;
+		}
+
+		// Process-wide pool sized to the machine, created on first use
+		static ThreadPool& shared()
+		{
+			static ThreadPool pool;
+			return pool;
+		}
+};
+
+// ==================== TaskGroup ====================
+
+inline TaskGroup::TaskGroup(ThreadPool& pool) : _pool(pool), _pending(0), _failed(0)
+{
+}
+
+// Never leaves tasks running that may reference a dying stack frame
+inline TaskGroup::~TaskGroup()
+{
+	helpUntilDone();
+}
+
+inline void TaskGroup::spawn(Task& task)
+{
+	task._group = this;
+	__atomic_add_fetch(&_pending, 1, __ATOMIC_RELAXED);
+	_pool.push(&task);
+}
+
+inline void TaskGroup::recordError()
+{
+	int expected = 0;
+	if (!__atomic_compare_exchange_n(&_failed, &expected, 1, false,
+			__ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+		return;
+#if __cplusplus >= 201103L
+	_error = std::current_exception();
+#else
+	try
+	{
+		throw;
+	}
+	catch (std::exception const & e)
+	{
+		_message = e.what();
+	}
+	catch (...)
+	{
+		_message = "unknown exception in parallel task";
+	}
+#endif
+}
+
+// Release: the error (if any) is visible once the waiter sees _pending drop
+inline void TaskGroup::finish()
+{
+	__atomic_sub_fetch(&_pending, 1, __ATOMIC_RELEASE);
+}
+
+inline void TaskGroup::helpUntilDone()
+{
+	ThreadPool::Worker* w = _pool.self();
+	while (__atomic_load_n(&_pending, __ATOMIC_ACQUIRE) > 0)
+	{
+		Task* task = _pool.findTask(w);
+		if (task != NULL)
+			_pool.execute(task);
+		else
+			sched_yield();
+	}
+}
+
+inline void TaskGroup::wait()
+{
+	helpUntilDone();
+	if (__atomic_load_n(&_failed, __ATOMIC_ACQUIRE))
+	{
+		_failed = 0;
+#if __cplusplus >= 201103L
+		std::exception_ptr error = _error;
+		_error = std::exception_ptr();
+		std::rethrow_exception(error);
+#else
+		throw ParallelError(_message);
+#endif
+	}
+}
+
+#endif
@@ -0,0 +1,105 @@
+#include <string>
+#include <sstream>
+#include "../iter.hpp"
+#include "../../bench/Bench.hpp"
+
+// Regression suite for iter(): the same element operation passed in every
+// form iter accepts, from cache-resident to memory-bound sizes. Results
+// go through bench::record (BENCH_FORMAT=text|csv|json).
+//   function pointer:   iter(data, n, increment) - F deduced as void(*)(int&)
+//   template function:  iter(data, n, increment<int>)
+//   functor:            a struct with operator(), inlined through F
+//   stateful functor:   read-only pass accumulating into a member pointer
+//   lambda:             C++11 builds only
+
+static size_t const MAX_SIZE = 16u * 1024u * 1024u;
+
+static void increment(int& n) { ++n; }
+
+template <typename T>
+static void incrementTemplate(T& n) { ++n; }
+
+struct Increment
+{
+	void operator()(int& n) const { ++n; }
+};
+
+struct Sum
+{
+	long*	total;
+	void operator()(int const & n) const { *total += n; }
+};
+
+struct FunctionPointer
+{
+	int*	data;
+	size_t	n;
+	void operator()() { ::iter(data, n, increment); bench::clobberMemory(); }
+};
+
+struct TemplateFunction
+{
+	int*	data;
+	size_t	n;
+	void operator()() { ::iter(data, n, incrementTemplate<int>); bench::clobberMemory(); }
+};
+
+struct Functor
+{
+	int*	data;
+	size_t	n;
+	void operator()() { ::iter(data, n, Increment()); bench::clobberMemory(); }
+};
+
+struct StatefulFunctor
+{
+	int const *	data;
+	size_t		n;
+	void operator()()
+	{
+		long total = 0;
+		Sum sum = {&total};
+		::iter(data, n, sum);
+		bench::doNotOptimize(total);
+	}
+};
+
+#if __cplusplus >= 201103L
+struct Lambda
+{
+	int*	data;
+	size_t	n;
+	void operator()() { ::iter(data, n, [](int& v) { ++v; }); bench::clobberMemory(); }
+};
+#endif
+
+int main(void)
+{
+	bench::title("iter suite (median, p99, TSC cycles/element)");
+	int* data = new int[MAX_SIZE];
+	for (size_t i = 0; i < MAX_SIZE; i++)
+		data[i] = static_cast<int>(i % 1000);
+
+	size_t const sizes[] = {1024, 64 * 1024, MAX_SIZE};
+	for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+	{
+		size_t n = sizes[s];
+		std::ostringstream suffix;
+		suffix << " n=" << n;
+		FunctionPointer pointer = {data, n};
+		TemplateFunction instance = {data, n};
+		Functor functor = {data, n};
+		StatefulFunctor stateful = {data, n};
+		bench::run("iter", "function pointer" + suffix.str(), n, pointer);
+		bench::run("iter", "template function" + suffix.str(), n, instance);
+		bench::run("iter", "functor" + suffix.str(), n, functor);
+		bench::run("iter", "stateful functor (read)" + suffix.str(), n, stateful);
+#if __cplusplus >= 201103L
+		Lambda lambda = {data, n};
+		bench::run("iter", "lambda" + suffix.str(), n, lambda);
+#endif
+	}
+
+	delete[] data;
+	return 0;
+}
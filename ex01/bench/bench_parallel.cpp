@@ -0,0 +1,75 @@
+#include <cmath>
+#include <string>
+#include <sstream>
+#include "../ParallelIter.hpp"
+#include "../../bench/Bench.hpp"
+
+// Scaling of parallel iter over 1..8 threads with an expensive per-element
+// functor, plus the sequential fallback on short ranges.
+
+static size_t const LARGE = 1u << 20;
+static size_t const SMALL = 1000;
+
+// ~100 ns of floating-point work per element
+void heavy(double & x)
+{
+	for (int i = 0; i < 20; i++)
+		x = std::sqrt(x + 1.0);
+}
+
+struct SerialIter
+{
+	double*	data;
+	size_t	length;
+	SerialIter(double* d, size_t n) : data(d), length(n) {}
+	void operator()() { ::iter(data, length, heavy); bench::clobberMemory(); }
+};
+
+struct ParIter
+{
+	double*		data;
+	size_t		length;
+	ThreadPool&	pool;
+	ParIter(double* d, size_t n, ThreadPool& p) : data(d), length(n), pool(p) {}
+	void operator()() { ::iter(ParallelPolicy(0, &pool), data, length, heavy); bench::clobberMemory(); }
+};
+
+static void report(std::string const & name, double ns, size_t length, double baseline)
+{
+	std::ostringstream note;
+	note << std::fixed << std::setprecision(2) << ns / length << " ns/element, speedup x" << baseline / ns;
+	bench::report(name, ns, note.str());
+}
+
+int main(void)
+{
+	std::cout << "Parallel iter benchmark (" << ThreadPool::hardwareThreads()
+		<< " CPUs online)" << std::endl;
+	double* data = new double[LARGE];
+	for (size_t i = 0; i < LARGE; i++)
+		data[i] = static_cast<double>(i);
+
+	SerialIter serial(data, LARGE);
+	double baseline = bench::measure(serial, 1, 3);
+	report("serial iter (n = 1M)", baseline, LARGE, baseline);
+
+	unsigned int const threads[] = {1, 2, 4, 8};
+	for (size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); t++)
+	{
+		ThreadPool pool(threads[t]);
+		ParIter parallel(data, LARGE, pool);
+		std::ostringstream name;
+		name << "parallel iter, " << threads[t] << " threads (n = 1M)";
+		report(name.str(), bench::measure(parallel, 1, 3), LARGE, baseline);
+	}
+
+	SerialIter serialSmall(data, SMALL);
+	double smallBaseline = bench::measure(serialSmall, 1000);
+	report("serial iter (n = 1000)", smallBaseline, SMALL, smallBaseline);
+	ThreadPool pool(4);
+	ParIter parallelSmall(data, SMALL, pool);
+	report("parallel iter fallback (n = 1000)", bench::measure(parallelSmall, 1000), SMALL, smallBaseline);
+
+	delete[] data;
+	return 0;
+}
@@ -0,0 +1,164 @@
+#include <cmath>
+#include <string>
+#include <sstream>
+#include "../ThreadPool.hpp"
+#include "../../bench/Bench.hpp"
+
+// Work-stealing scheduler: spawn/wait overhead of an empty task, and load
+// balance on a skewed workload (element i costs ~i units) comparing a static
+// one-block-per-thread split with parallelFor's stealable ranges.
+
+static size_t const ELEMENTS = 1u << 14;
+static unsigned int const THREADS = 4;
+
+struct EmptyTask : public Task
+{
+	virtual void execute() {}
+};
+
+// One spawn + wait from the thread that owns the group
+struct SpawnWait
+{
+	ThreadPool&	pool;
+	EmptyTask	task;
+	SpawnWait(ThreadPool& p) : pool(p) {}
+	void operator()()
+	{
+		TaskGroup group(pool);
+		group.spawn(task);
+		group.wait();
+	}
+};
+
+// Runs SpawnWait `count` times from inside a worker (own-deque path)
+struct SpawnWaitInside : public Task
+{
+	ThreadPool&	pool;
+	size_t		count;
+	SpawnWaitInside(ThreadPool& p, size_t n) : pool(p), count(n) {}
+	virtual void execute()
+	{
+		SpawnWait once(pool);
+		for (size_t i = 0; i < count; i++)
+			once();
+	}
+};
+
+struct InsideBench
+{
+	ThreadPool&		pool;
+	SpawnWaitInside	inside;
+	InsideBench(ThreadPool& p, size_t n) : pool(p), inside(p, n) {}
+	void operator()()
+	{
+		TaskGroup group(pool);
+		group.spawn(inside);
+		group.wait();
+	}
+};
+
+// Skewed work: element i costs i / 64 square roots. Records how many
+// elements each thread processed (slot 0 = calling thread).
+struct SkewedWork
+{
+	double*		data;
+	ThreadPool&	pool;
+	size_t		perThread[THREADS];
+
+	SkewedWork(double* d, ThreadPool& p) : data(d), pool(p)
+	{
+		reset();
+	}
+
+	void reset()
+	{
+		for (unsigned int t = 0; t < THREADS; t++)
+			perThread[t] = 0;
+	}
+
+	void operator()(size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			double x = data[i];
+			for (size_t k = 0; k < i / 64; k++)
+				x = std::sqrt(x + 1.0);
+			data[i] = x;
+		}
+		__atomic_add_fetch(&perThread[pool.currentIndex() + 1], end - begin, __ATOMIC_RELAXED);
+	}
+};
+
+// Static partition: one contiguous block per thread, no stealing possible
+struct StaticBlocks
+{
+	SkewedWork&	work;
+	size_t		blocks;
+	StaticBlocks(SkewedWork& w, size_t n) : work(w), blocks(n) {}
+	void operator()(size_t index)
+	{
+		size_t size = ELEMENTS / blocks;
+		work(index * size, (index + 1 == blocks) ? ELEMENTS : (index + 1) * size);
+	}
+};
+
+struct RunStatic
+{
+	ThreadPool&		pool;
+	StaticBlocks	blocks;
+	RunStatic(ThreadPool& p, SkewedWork& w) : pool(p), blocks(w, p.size()) {}
+	void operator()() { pool.run(blocks, blocks.blocks); }
+};
+
+struct RunStealing
+{
+	ThreadPool&	pool;
+	SkewedWork&	work;
+	RunStealing(ThreadPool& p, SkewedWork& w) : pool(p), work(w) {}
+	void operator()() { pool.parallelFor(0, ELEMENTS, 64, work); }
+};
+
+static std::string distribution(SkewedWork const & work)
+{
+	std::ostringstream out;
+	size_t total = 0;
+	for (unsigned int t = 0; t < THREADS; t++)
+		total += work.perThread[t];
+	out << "elements/thread %:";
+	for (unsigned int t = 0; t < THREADS; t++)
+		out << " " << (total ? work.perThread[t] * 100 / total : 0);
+	return out.str();
+}
+
+int main(void)
+{
+	std::cout << "Scheduler benchmark (" << ThreadPool::hardwareThreads()
+		<< " CPUs online, " << THREADS << " threads)" << std::endl;
+	ThreadPool pool(THREADS);
+
+	SpawnWait outside(pool);
+	bench::report("spawn + wait, external thread", bench::measure(outside, 10000), "injection queue");
+	size_t const inner = 10000;
+	InsideBench inside(pool, inner);
+	bench::report("spawn + wait, inside a worker", bench::measure(inside, 1) / inner, "own deque");
+
+	double* data = new double[ELEMENTS];
+	for (size_t i = 0; i < ELEMENTS; i++)
+		data[i] = static_cast<double>(i);
+
+	SkewedWork work(data, pool);
+	RunStatic staticRun(pool, work);
+	bench::report("skewed, static blocks", bench::measure(staticRun, 1, 3));
+	work.reset();
+	staticRun();
+	std::cout << "  " << distribution(work) << std::endl;
+
+	RunStealing stealingRun(pool, work);
+	bench::report("skewed, parallelFor (grain 64)", bench::measure(stealingRun, 1, 3));
+	work.reset();
+	stealingRun();
+	std::cout << "  " << distribution(work) << std::endl;
+
+	delete[] data;
+	return 0;
+}
@@ -2,6 +2,12 @@
 #define ITER_HPP
 
 #include <cstddef>
+#include "ArrayView.hpp"
+#include "Instrument.hpp"
+
+// Defined in ex02/Array.hpp; only needed when that header is included too
+template <typename T, typename Alloc, typename Bounds>
+class Array;
 
 // Generic template that works with any function type
 // This allows both const and non-const function parameters
@@ -11,10 +17,45 @@ void iter(T* array, size_t length, F func)
 	if (array == NULL)
 		return;
 
+	INSTRUMENT_ITER_SCOPE(length);
 	for (size_t i = 0; i < length; i++)
 	{
 		func(array[i]);
 	}
 }
 
+// Views: sub-ranges of any array, without copying
+//   iter(ArrayView<int>(array, length).slice(10, 20), func);
+template <typename T, typename F>
+void iter(ArrayView<T> view, F func)
+{
+	::iter(view.data(), view.size(), func);
+}
+
+// Arrays directly: T cannot be deduced through the view conversion
+//   iter(array, func);
+template <typename T, typename Alloc, typename Bounds, typename F>
+void iter(Array<T, Alloc, Bounds>& array, F func)
+{
+	::iter(array.view(), func);
+}
+
+template <typename T, typename Alloc, typename Bounds, typename F>
+void iter(Array<T, Alloc, Bounds> const & array, F func)
+{
+	::iter(array.view(), func);
+}
+
+template <typename T, typename F>
+void iter(StridedView<T> view, F func)
+{
+	if (view.data() == NULL)
+		return;
+
+	INSTRUMENT_ITER_SCOPE(view.size());
+	T* element = view.data();
+	for (size_t i = 0; i < view.size(); i++, element += view.step())
+		func(*element);
+}
+
 #endif
@@ -1,6 +1,9 @@
 #include <iostream>
 #include <string>
+#include <stdexcept>
 #include "iter.hpp"
+#include "ParallelIter.hpp"
+#include "Pipeline.hpp"
 
 // ANSI Color codes
 #define RESET   "\033[0m"
@@ -12,6 +15,15 @@
 #define CYAN    "\033[36m"
 #define BOLD    "\033[1m"
 
+// Helper function to print test results
+void printTest(std::string const & testName, bool success)
+{
+	if (success)
+		std::cout << GREEN << "✓ " << testName << RESET << std::endl;
+	else
+		std::cout << RED << "✗ " << testName << RESET << std::endl;
+}
+
 // ==================== Template functions ====================
 
 // Template function that takes const reference (read-only)
@@ -109,6 +121,92 @@ void multiplyByFive(Number & n)
 	n *= 5;
 }
 
+// Throws on one specific value (exception forwarding from parallel iter)
+void failOnSeven(int & n)
+{
+	if (n == 7)
+		throw std::runtime_error("seven is not allowed");
+}
+
+// Nested fork-join: fib(n) spawns fib(n - 1) and computes fib(n - 2) itself
+struct FibTask : public Task
+{
+	ThreadPool&	pool;
+	int			n;
+	long		result;
+
+	FibTask(ThreadPool& p, int value) : pool(p), n(value), result(0) {}
+
+	virtual void execute()
+	{
+		if (n < 2)
+		{
+			result = n;
+			return;
+		}
+		FibTask left(pool, n - 1);
+		FibTask right(pool, n - 2);
+		TaskGroup group(pool);
+		group.spawn(left);
+		right.execute();
+		group.wait();
+		result = left.result + right.result;
+	}
+};
+
+// parallelFor body: adds up indices and counts the ranges it was given
+struct RangeSum
+{
+	long	total;		// Atomic
+	long	ranges;		// Atomic
+
+	RangeSum() : total(0), ranges(0) {}
+
+	void operator()(size_t begin, size_t end)
+	{
+		long sum = 0;
+		for (size_t i = begin; i < end; i++)
+			sum += static_cast<long>(i);
+		__atomic_add_fetch(&total, sum, __ATOMIC_RELAXED);
+		__atomic_add_fetch(&ranges, 1, __ATOMIC_RELAXED);
+	}
+};
+
+// parallelFor body failing on the range that contains index 777
+struct FailingRange
+{
+	void operator()(size_t begin, size_t end)
+	{
+		if (begin <= 777 && 777 < end)
+			throw std::runtime_error("range containing 777 failed");
+	}
+};
+
+// Pipeline stages
+long square(int const & n)
+{
+	return static_cast<long>(n) * n;
+}
+
+bool isEven(long n)
+{
+	return n % 2 == 0;
+}
+
+long add(long a, long b)
+{
+	return a + b;
+}
+
+// Appends its tag to *log on every call: shows the order stages run in
+struct Trace
+{
+	std::string*	log;
+	char			tag;
+
+	void operator()(int const &) const { *log += tag; }
+};
+
 // ==================== Helper function ====================
 
 template <typename T>
@@ -245,6 +343,197 @@ int main(void)
 		std::cout << GREEN << "(no crash - OK)" << RESET << std::endl;
 	}
 
+	// ========== Test 8: Parallel iter ==========
+	std::cout << BOLD << YELLOW << "\n[8] Parallel iter (thread pool)" << RESET << std::endl;
+	{
+		ThreadPool pool(4);
+		std::cout << "Pool threads: " << CYAN << pool.size() << RESET << std::endl;
+
+		size_t const size = 100000;
+		int* numbers = new int[size];
+		for (size_t i = 0; i < size; i++)
+			numbers[i] = static_cast<int>(i);
+
+		::iter(ParallelPolicy(1000, &pool), numbers, size, incrementElement<int>);
+		bool allIncremented = true;
+		for (size_t i = 0; i < size; i++)
+			if (numbers[i] != static_cast<int>(i) + 1)
+				allIncremented = false;
+		printTest("Every element visited exactly once", allIncremented);
+
+		// Unaligned start: the first chunk runs up to the next cache line
+		::iter(ParallelPolicy(0, &pool), numbers + 3, size - 3, doubleValue<int>);
+		bool unalignedOk = numbers[2] == 3 && numbers[3] == 8 && numbers[size - 1] == static_cast<int>(size) * 2;
+		printTest("Unaligned sub-range handled", unalignedOk);
+
+		bool exceptionCaught = false;
+		try
+		{
+			numbers[50000] = 7;
+			::iter(ParallelPolicy(1000, &pool), numbers, size, failOnSeven);
+		}
+		catch (std::exception const & e)
+		{
+			exceptionCaught = true;
+			std::cout << RED << "Exception forwarded: " << e.what() << RESET << std::endl;
+		}
+		printTest("Exception forwarded to caller", exceptionCaught);
+
+		int small[] = {1, 2, 3};
+		::iter(par, small, 3, addTen);
+		displayArray(small, 3, "Small array (serial fallback)");
+
+		delete[] numbers;
+	}
+
+	// ========== Test 9: Work-stealing scheduler ==========
+	std::cout << BOLD << YELLOW << "\n[9] Work-stealing scheduler (fork-join)" << RESET << std::endl;
+	{
+		ThreadPool pool(4);
+
+		FibTask fib(pool, 20);
+		fib.execute();
+		std::cout << "fib(20) with nested spawns: " << CYAN << fib.result << RESET << std::endl;
+		printTest("Nested fork-join result", fib.result == 6765);
+
+		RangeSum sum;
+		pool.parallelFor(0, 10000, 100, sum);
+		std::cout << "Ranges executed: " << CYAN << sum.ranges << RESET << std::endl;
+		printTest("parallelFor covers the range exactly once", sum.total == 10000L * 9999 / 2);
+		printTest("parallelFor respects the grain", sum.ranges >= 100);
+
+		bool exceptionCaught = false;
+		try
+		{
+			FailingRange failing;
+			pool.parallelFor(0, 10000, 10, failing);
+		}
+		catch (std::exception const & e)
+		{
+			exceptionCaught = true;
+			std::cout << RED << "Exception forwarded: " << e.what() << RESET << std::endl;
+		}
+		printTest("Exception from a stolen range forwarded", exceptionCaught);
+
+		RangeSum after;
+		pool.parallelFor(0, 1000, 10, after);
+		printTest("Pool usable after a failure", after.total == 1000L * 999 / 2);
+	}
+
+	// ========== Test 10: Views ==========
+	std::cout << BOLD << YELLOW << "\n[10] ArrayView and StridedView" << RESET << std::endl;
+	{
+		int values[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+		ArrayView<int> all(values);
+		printTest("View over a C array has its length", all.size() == 10 && all.data() == values);
+
+		::iter(all.slice(2, 5), addTen);
+		displayArray(values, 10, "After iter on slice(2, 5)");
+		printTest("Only the slice is modified", values[1] == 1 && values[2] == 12
+			&& values[4] == 14 && values[5] == 5);
+
+		::iter(all.stride(3), incrementElement<int>);
+		displayArray(values, 10, "After iter on stride(3)");
+		printTest("Only every third element is modified", values[0] == 1 && values[3] == 14
+			&& values[9] == 10 && values[1] == 1 && values[8] == 8);
+
+		StridedView<int> odd = all.slice(1, 10).stride(2);
+		printTest("Strided slice size and step", odd.size() == 5 && odd.step() == 2 && odd[4] == 10);
+		printTest("Stride of a stride multiplies steps", odd.stride(2).step() == 4 && odd.stride(2).size() == 3);
+
+		ArrayView<int const> readOnly = all;
+		std::cout << "Read-only last(3): ";
+		::iter(readOnly.last(3), printElement<int>);
+		std::cout << std::endl;
+		printTest("Const view shares the storage", readOnly.data() == values && readOnly.last(3)[0] == 7);
+
+		bool sliceThrows = false;
+		try
+		{
+			all.slice(4, 11);
+		}
+		catch (std::out_of_range const &)
+		{
+			sliceThrows = true;
+		}
+		bool atThrows = false;
+		try
+		{
+			odd.at(5);
+		}
+		catch (std::out_of_range const &)
+		{
+			atThrows = true;
+		}
+		printTest("Out-of-range slice and at() throw", sliceThrows && atThrows);
+
+		ArrayView<int> empty;
+		::iter(empty, addTen);
+		printTest("Empty view is a no-op", empty.empty() && all.first(0).empty());
+
+		int* numbers = new int[10000];
+		for (int i = 0; i < 10000; i++)
+			numbers[i] = i;
+		::iter(par, ArrayView<int>(numbers, 10000).slice(1000, 9000), addTen);
+		printTest("Parallel iter over a slice", numbers[999] == 999 && numbers[1000] == 1010
+			&& numbers[8999] == 9009 && numbers[9000] == 9000);
+		delete[] numbers;
+	}
+
+	// ========== Test 11: Fused pipelines ==========
+	std::cout << BOLD << YELLOW << "\n[11] Fused pipelines (one pass, lazy stages)" << RESET << std::endl;
+	{
+		int values[] = {1, 2, 3, 4, 5};
+		std::cout << "increment, double, print in one pass: ";
+		pipeline(values, 5).apply(incrementElement<int>).apply(doubleValue<int>).each(printElement<int>);
+		std::cout << std::endl;
+		printTest("apply() stages write back to the array", values[0] == 4 && values[4] == 12);
+
+		std::string log;
+		Trace a = {&log, 'a'};
+		Trace b = {&log, 'b'};
+		pipeline(values, 3).apply(a).apply(b);
+		bool nothingRan = log.empty();
+		pipeline(values, 3).apply(a).apply(b).each(a);
+		printTest("Stages are lazy, then run element by element", nothingRan && log == "abaabaaba");
+
+		int numbers[] = {1, 2, 3, 4, 5, 6};
+		long evenSquares = pipeline(numbers, 6).map(square).filter(isEven).reduce(0L, add);
+		long kept[6];
+		size_t count = pipeline(ArrayView<int>(numbers, 6)).map(square).filter(isEven).into(kept);
+		printTest("map/filter/reduce and into()", evenSquares == 4 + 16 + 36
+			&& count == 3 && kept[0] == 4 && kept[2] == 36 && numbers[1] == 2);
+
+		ThreadPool pool(4);
+		size_t const size = 100000;
+		int* big = new int[size];
+		for (size_t i = 0; i < size; i++)
+			big[i] = static_cast<int>(i);
+		pipeline(big, size).apply(incrementElement<int>).each(ParallelPolicy(1000, &pool), addTen);
+		long serial = pipeline(big, size).map(square).filter(isEven).reduce(0L, add);
+		long parallel = pipeline(big, size).map(square).filter(isEven).reduce(ParallelPolicy(1000, &pool), 0L, add);
+		printTest("Parallel each and reduce match the serial pass", big[0] == 11 && big[size - 1] == static_cast<int>(size) + 10
+			&& serial == parallel);
+		long serialTail = pipeline(big + 3, size - 3).map(square).reduce(0L, add);
+		long parallelTail = pipeline(big + 3, size - 3).map(square).reduce(ParallelPolicy(0, &pool), 0L, add);
+		printTest("Parallel reduce from a misaligned start", serialTail == parallelTail);
+		delete[] big;
+
+		printTest("NULL source is a no-op", pipeline(static_cast<int*>(NULL), 10).map(square).reduce(5L, add) == 5);
+	}
+
+	// ========== Test 12: Instrumentation ==========
+	std::cout << BOLD << YELLOW << "\n[12] Instrumentation compiled out" << RESET << std::endl;
+	{
+		// Exact counts: make instrument-test (instrument_test.cpp, -DINSTRUMENT)
+		int values[10] = {0};
+		Instrument::reset();
+		::iter(values, 10, incrementElement<int>);
+		Instrument::Counters c = Instrument::snapshot();
+		printTest("Default build: iter counts nothing", c[Instrument::ITER_CALLS] == 0
+			&& c[Instrument::ITER_ELEMENTS] == 0 && values[9] == 1);
+	}
+
 	std::cout << BOLD << GREEN << "\n✓ All iter tests completed!\n" << RESET << std::endl;
 
 	return 0;
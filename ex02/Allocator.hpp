@@ -0,0 +1,419 @@
+#ifndef ALLOCATOR_HPP
+#define ALLOCATOR_HPP
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <sys/mman.h>
+
+// Allocators used by Array<T, Alloc>. An allocator is a small copyable handle:
+//   void* allocate(size_t bytes, size_t alignment);	// throws std::bad_alloc
+//   void  deallocate(void* p, size_t bytes, size_t alignment);
+// deallocate() gets back the bytes and alignment given to allocate().
+// Copies of a handle share the same underlying memory.
+
+// ==================== HeapAllocator ====================
+
+// Alignment of every block from the global operator new
+#ifdef __STDCPP_DEFAULT_NEW_ALIGNMENT__
+size_t const HEAP_ALIGNMENT = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+#else
+size_t const HEAP_ALIGNMENT = 2 * sizeof(void*);
+#endif
+
+// Default: global operator new/delete (what Array always used). Larger
+// alignments (over-aligned types) come from posix_memalign and go back to
+// free, which is why deallocate() needs the alignment too.
+class HeapAllocator
+{
+	public:
+		void* allocate(size_t bytes, size_t alignment)
+		{
+			if (alignment <= HEAP_ALIGNMENT)
+				return ::operator new(bytes);
+			void* p = NULL;
+			if (::posix_memalign(&p, alignment, bytes) != 0)
+				throw std::bad_alloc();
+			return p;
+		}
+
+		void deallocate(void* p, size_t bytes, size_t alignment)
+		{
+			(void)bytes;
+			if (alignment <= HEAP_ALIGNMENT)
+				::operator delete(p);
+			else
+				std::free(p);
+		}
+};
+
+// ==================== Aligned ====================
+
+// Storage aligned to Alignment bytes (a power of two, at least
+// sizeof(void*)): 32 for AVX loads, 64 for whole cache lines. Block sizes
+// are rounded up to a multiple of Alignment as well, so two arrays never
+// share a cache line (no false sharing between per-thread arrays).
+//   Array<float, AlignedAllocator<64> > arr(n);   // arr.data() % 64 == 0
+template <size_t Alignment>
+class AlignedAllocator
+{
+	public:
+		void* allocate(size_t bytes, size_t alignment)
+		{
+			typedef char RequiresPowerOfTwo[(Alignment >= sizeof(void*)
+				&& (Alignment & (Alignment - 1)) == 0) ? 1 : -1];
+			(void)sizeof(RequiresPowerOfTwo);
+
+			if (alignment < Alignment)
+				alignment = Alignment;
+			if (bytes > static_cast<size_t>(-1) - alignment)
+				throw std::bad_alloc();
+			void* p = NULL;
+			if (::posix_memalign(&p, alignment, (bytes + alignment - 1) & ~(alignment - 1)) != 0)
+				throw std::bad_alloc();
+			return p;
+		}
+
+		void deallocate(void* p, size_t bytes, size_t alignment)
+		{
+			(void)bytes;
+			(void)alignment;
+			std::free(p);
+		}
+};
+
+// Alignment of every block an allocator returns for elements of type T,
+// which Array hands to the compiler through data() (see Array::ALIGNMENT).
+// Default: alignof(T), but no more than operator new guarantees (allocators
+// that ignore larger requests); HeapAllocator honours alignof(T) whatever
+// it is, and AlignedAllocator raises it.
+template <typename Alloc, typename T>
+struct StorageAlignment
+{
+	static size_t const value = (__alignof__(T) < HEAP_ALIGNMENT) ? __alignof__(T) : HEAP_ALIGNMENT;
+};
+
+template <typename T>
+struct StorageAlignment<HeapAllocator, T>
+{
+	static size_t const value = __alignof__(T);
+};
+
+template <size_t Alignment, typename T>
+struct StorageAlignment<AlignedAllocator<Alignment>, T>
+{
+	static size_t const value = (Alignment > __alignof__(T)) ? Alignment : __alignof__(T);
+};
+
+// ==================== Huge pages ====================
+
+size_t const HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+// Blocks of HUGE_PAGE_SIZE bytes and more get their own 2 MiB-aligned
+// mapping, advised MADV_HUGEPAGE so that transparent huge pages back them:
+// one TLB entry then covers 2 MiB instead of 4 KiB, which pays off for
+// random access over very large arrays. Smaller blocks use operator new.
+// The kernel decides in the end: with THP disabled (see
+// /sys/kernel/mm/transparent_hugepage/enabled) this only costs the alignment.
+class HugePageAllocator
+{
+	private:
+		static size_t mappedSize(size_t bytes)
+		{
+			return (bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+		}
+
+	public:
+		void* allocate(size_t bytes, size_t alignment)
+		{
+			(void)alignment;
+			if (bytes < HUGE_PAGE_SIZE)
+				return ::operator new(bytes);
+			if (bytes > static_cast<size_t>(-1) - 2 * HUGE_PAGE_SIZE)
+				throw std::bad_alloc();
+
+			// Over-map by one huge page, then trim both ends to the alignment
+			size_t size = mappedSize(bytes);
+			void* raw = ::mmap(NULL, size + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE,
+				MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if (raw == MAP_FAILED)
+				throw std::bad_alloc();
+			char* start = static_cast<char*>(raw);
+			char* aligned = reinterpret_cast<char*>(
+				(reinterpret_cast<size_t>(start) + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1));
+			if (aligned > start)
+				::munmap(start, static_cast<size_t>(aligned - start));
+			if (start + HUGE_PAGE_SIZE > aligned)
+				::munmap(aligned + size, static_cast<size_t>(start + HUGE_PAGE_SIZE - aligned));
+#ifdef MADV_HUGEPAGE
+			::madvise(aligned, size, MADV_HUGEPAGE);
+#endif
+			return aligned;
+		}
+
+		void deallocate(void* p, size_t bytes, size_t alignment)
+		{
+			(void)alignment;
+			if (bytes < HUGE_PAGE_SIZE)
+				::operator delete(p);
+			else
+				::munmap(p, mappedSize(bytes));
+		}
+};
+
+// ==================== Arena ====================
+
+// Bump allocator: allocation is a pointer increment, individual frees are
+// (almost) no-ops, and reset() releases everything allocated so far at once.
+// Chunks are kept across reset() so a steady-state request allocates nothing
+// from the heap. Not thread-safe: use one arena per thread or per request.
+// Every Array allocated from an arena must be destroyed before reset().
+class Arena
+{
+	private:
+		struct Chunk
+		{
+			Chunk*	next;
+			size_t	size;		// Usable bytes following the header
+		};
+
+		Chunk*	_head;
+		Chunk*	_current;
+		char*	_cursor;
+		char*	_end;
+		size_t	_chunkSize;
+
+		Arena(Arena const & src);				// Non-copyable
+		Arena& operator=(Arena const & rhs);
+
+		static char* dataOf(Chunk* chunk)
+		{
+			return reinterpret_cast<char*>(chunk) + sizeof(Chunk);
+		}
+
+		static char* alignUp(char* p, size_t alignment)
+		{
+			size_t mask = alignment - 1;
+			return reinterpret_cast<char*>((reinterpret_cast<size_t>(p) + mask) & ~mask);
+		}
+
+		void enter(Chunk* chunk)
+		{
+			_current = chunk;
+			_cursor = dataOf(chunk);
+			_end = _cursor + chunk->size;
+		}
+
+		// Moves to the next chunk that fits, allocating one if needed
+		void nextChunk(size_t bytes, size_t alignment)
+		{
+			size_t needed = bytes + alignment;
+			Chunk* next = (_current != NULL) ? _current->next : _head;
+			while (next != NULL && next->size < needed)
+				next = next->next;
+			if (next == NULL)
+			{
+				size_t size = (needed > _chunkSize) ? needed : _chunkSize;
+				next = static_cast<Chunk*>(::operator new(sizeof(Chunk) + size));
+				next->size = size;
+				if (_current == NULL)
+				{
+					next->next = _head;
+					_head = next;
+				}
+				else
+				{
+					next->next = _current->next;
+					_current->next = next;
+				}
+			}
+			enter(next);
+		}
+
+	public:
+		explicit Arena(size_t chunkSize = 64 * 1024)
+			: _head(NULL), _current(NULL), _cursor(NULL), _end(NULL), _chunkSize(chunkSize)
+		{
+		}
+
+		~Arena()
+		{
+			while (_head != NULL)
+			{
+				Chunk* next = _head->next;
+				::operator delete(_head);
+				_head = next;
+			}
+		}
+
+		void* allocate(size_t bytes, size_t alignment)
+		{
+			char* p = alignUp(_cursor, alignment);
+			if (_cursor == NULL || p + bytes > _end)
+			{
+				nextChunk(bytes, alignment);
+				p = alignUp(_cursor, alignment);
+			}
+			_cursor = p + bytes;
+			return p;
+		}
+
+		// Only the most recent block is reclaimed (typical when an Array grows)
+		void deallocate(void* p, size_t bytes, size_t alignment)
+		{
+			(void)alignment;
+			if (static_cast<char*>(p) + bytes == _cursor)
+				_cursor = static_cast<char*>(p);
+		}
+
+		// Frees every block at once; chunks are kept for the next request
+		void reset()
+		{
+			if (_head != NULL)
+				enter(_head);
+		}
+
+		// Total chunk memory owned by the arena
+		size_t bytesReserved() const
+		{
+			size_t total = 0;
+			for (Chunk* c = _head; c != NULL; c = c->next)
+				total += c->size;
+			return total;
+		}
+};
+
+// ==================== Pool ====================
+
+// Segregated free lists for power-of-two size classes (8 to 1024 bytes),
+// carved out of an internal Arena. Freed blocks are recycled by later
+// allocations of the same class; larger blocks come straight from the arena.
+// reset() drops everything at once. Not thread-safe: one pool per thread.
+class Pool
+{
+	private:
+		enum
+		{
+			MIN_SHIFT = 3,				// Smallest class: 8 bytes
+			CLASS_COUNT = 8,			// Largest class: 1024 bytes
+			MAX_ALIGNMENT = 16
+		};
+
+		struct FreeBlock
+		{
+			FreeBlock*	next;
+		};
+
+		Arena		_arena;
+		FreeBlock*	_free[CLASS_COUNT];
+
+		Pool(Pool const & src);					// Non-copyable
+		Pool& operator=(Pool const & rhs);
+
+		// Size class index, or CLASS_COUNT when the block is too large
+		static size_t classOf(size_t bytes)
+		{
+			size_t index = 0;
+			size_t classSize = static_cast<size_t>(1) << MIN_SHIFT;
+			while (index < CLASS_COUNT && classSize < bytes)
+			{
+				classSize <<= 1;
+				index++;
+			}
+			return index;
+		}
+
+		static size_t classSize(size_t index)
+		{
+			return static_cast<size_t>(1) << (index + MIN_SHIFT);
+		}
+
+	public:
+		explicit Pool(size_t chunkSize = 64 * 1024) : _arena(chunkSize)
+		{
+			for (size_t i = 0; i < CLASS_COUNT; i++)
+				_free[i] = NULL;
+		}
+
+		void* allocate(size_t bytes, size_t alignment)
+		{
+			size_t index = classOf(bytes);
+			if (index == CLASS_COUNT)
+				return _arena.allocate(bytes, alignment);
+
+			size_t size = classSize(index);
+			if (alignment > MAX_ALIGNMENT)
+				return _arena.allocate(size, alignment);
+
+			FreeBlock* block = _free[index];
+			if (block != NULL)
+			{
+				_free[index] = block->next;
+				return block;
+			}
+			size_t const maxAlignment = MAX_ALIGNMENT;
+			return _arena.allocate(size, (size < maxAlignment) ? size : maxAlignment);
+		}
+
+		void deallocate(void* p, size_t bytes, size_t alignment)
+		{
+			size_t index = classOf(bytes);
+			if (index == CLASS_COUNT)
+			{
+				_arena.deallocate(p, bytes, alignment);
+				return;
+			}
+			FreeBlock* block = static_cast<FreeBlock*>(p);
+			block->next = _free[index];
+			_free[index] = block;
+		}
+
+		void reset()
+		{
+			for (size_t i = 0; i < CLASS_COUNT; i++)
+				_free[i] = NULL;
+			_arena.reset();
+		}
+
+		size_t bytesReserved() const
+		{
+			return _arena.bytesReserved();
+		}
+};
+
+// ==================== Handles ====================
+
+// Copyable reference to an Arena or a Pool, suitable as Array's Alloc:
+//   Arena arena;
+//   Array<int, ArenaAllocator> arr(16, ArenaAllocator(arena));
+// There is no default constructor: an Array with one of these as Alloc
+// must be given the handle (Array<int, ArenaAllocator> arr; does not build).
+template <typename Resource>
+class ResourceAllocator
+{
+	private:
+		Resource*	_resource;
+
+	public:
+		ResourceAllocator(Resource& resource) : _resource(&resource) {}
+
+		void* allocate(size_t bytes, size_t alignment)
+		{
+			return _resource->allocate(bytes, alignment);
+		}
+
+		void deallocate(void* p, size_t bytes, size_t alignment)
+		{
+			_resource->deallocate(p, bytes, alignment);
+		}
+
+		Resource* resource() const
+		{
+			return _resource;
+		}
+};
+
+typedef ResourceAllocator<Arena>	ArenaAllocator;
+typedef ResourceAllocator<Pool>		PoolAllocator;
+
+#endif
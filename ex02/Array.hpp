@@ -2,34 +2,154 @@
 #define ARRAY_HPP
 
 #include <exception>
+#include <stdexcept>
 #include <cstddef>
+#include "TypeTraits.hpp"
+#include "Allocator.hpp"
+#include "Bounds.hpp"
+#include "../ex01/ArrayView.hpp"
+#include "../ex01/Instrument.hpp"
 
-template <typename T>
+namespace ExprDetail
+{
+	template <typename E>
+	struct Expr;
+}
+
+// Alloc supplies the raw storage (see Allocator.hpp); the default uses the
+// global operator new/delete. Bounds selects how operator[] checks indices
+// (see Bounds.hpp).
+template <typename T, typename Alloc = HeapAllocator, typename Bounds = ARRAY_DEFAULT_BOUNDS>
 class Array
 {
 	private:
 		T*				_array;
-		unsigned int	_size;
+		size_t			_size;			// Number of constructed elements
+		size_t			_capacity;		// Number of slots in the raw buffer
+		Alloc			_alloc;
+
+		// Raw storage: allocation never constructs, deallocation never destroys
+		T*			allocate(size_t n);
+		void		deallocate(T* p, size_t n);
+		static void	destroy(T* first, T* last);
+		void		copyFrom(Array const & src);
+
+		// Copy-constructs n elements into raw memory (rolls back on throw)
+		static void	uninitializedCopy(T const * src, size_t n, T* dst);
+
+		// Moves (or copies) our elements into dst, then frees the old buffer
+		void		relocateTo(T* dst, size_t newCapacity);
+		size_t		grownCapacity(size_t needed) const;
+
+		// Appends the element built by construct(void* slot), growing if full
+		template <typename Construct>
+		T&			emplaceWith(Construct const & construct);
 
 	public:
+		// Guaranteed alignment of data() in bytes (see StorageAlignment):
+		// alignof(T), or more with an AlignedAllocator. data() and begin()
+		// carry it as a compiler hint (__builtin_assume_aligned), so loops
+		// over them can use aligned vector loads without peeling.
+		static size_t const ALIGNMENT = StorageAlignment<Alloc, T>::value;
+
 		// Orthodox Canonical Form
 		Array();									// Default constructor
-		Array(unsigned int n);						// Parametric constructor
+		Array(size_t n, Alloc const & alloc = Alloc());	// Parametric constructor
 		Array(Array const & src);					// Copy constructor
 		Array& operator=(Array const & rhs);		// Assignment operator
 		~Array();									// Destructor
 
+		// Skips value-initialization: every element must be written before use
+		Array(size_t n, UninitializedTag, Alloc const & alloc = Alloc());
+
+		// Storage from a specific allocator (e.g. an ArenaAllocator)
+		explicit Array(Alloc const & alloc);
+		Array(Array const & src, Alloc const & alloc);
+		Alloc get_allocator() const;
+
+#if __cplusplus >= 201103L
+		// Move semantics (C++11 and later): steal the buffer, no allocation
+		Array(Array&& src) noexcept;
+		Array& operator=(Array&& rhs) noexcept;
+#endif
+
+		// Element-wise expressions (see ArrayExpr.hpp), evaluated in one loop
+		//   Array<int> c = a * 2 + b;   c = c + a;
+		//   Array<int, ArenaAllocator> d(a + b, ArenaAllocator(arena));
+		template <typename E>
+		Array(ExprDetail::Expr<E> const & expr, Alloc const & alloc = Alloc());
+		template <typename E>
+		Array& operator=(ExprDetail::Expr<E> const & expr);
+
+		// Exchange contents in O(1) (C++98 fallback for moves)
+		void swap(Array& other) throw();
+
 		// Subscript operator (two versions: const and non-const)
-		T& operator[](unsigned int index);
-		T const & operator[](unsigned int index) const;
+		// Checked according to the Bounds policy
+		T& operator[](size_t index);
+		T const & operator[](size_t index) const;
+
+		// Always checked, whatever the Bounds policy
+		T& at(size_t index);
+		T const & at(size_t index) const;
+
+		// Raw access for tight loops: [begin(), end()) holds size() elements
+		T* data();
+		T const * data() const;
+		T* begin();
+		T const * begin() const;
+		T* end();
+		T const * end() const;
+
+		// Non-owning views (shared with iter, see ../ex01/ArrayView.hpp),
+		// valid until the array is resized, reallocated or destroyed.
+		// slice() covers [begin, end) and throws std::out_of_range.
+		operator ArrayView<T>();
+		operator ArrayView<T const>() const;
+		ArrayView<T> view();
+		ArrayView<T const> view() const;
+		ArrayView<T> slice(size_t begin, size_t end);
+		ArrayView<T const> slice(size_t begin, size_t end) const;
 
 		// Member function
-		unsigned int size() const;
+		size_t size() const;
+
+		// Capacity management (growth is geometric: amortized O(1) appends).
+		// Requests above max_size() elements throw std::length_error.
+		size_t capacity() const;
+		size_t max_size() const;
+		bool empty() const;
+		void reserve(size_t n);
+		void resize(size_t n);
+		void resize(size_t n, T const & value);
+		void resize(size_t n, UninitializedTag);
+		void shrink_to_fit();
+		void clear();
 
-		// Exception class
+		// Appending and removing at the end
+		void push_back(T const & value);
+		void pop_back();
+#if __cplusplus >= 201103L
+		void push_back(T&& value);
+		template <typename... Args>
+		T& emplace_back(Args&&... args);
+#else
+		T& emplace_back();
+		template <typename A1>
+		T& emplace_back(A1 const & a1);
+		template <typename A1, typename A2>
+		T& emplace_back(A1 const & a1, A2 const & a2);
+#endif
+
+		// Exception class (construction counts as a bounds throw)
 		class OutOfBoundsException : public std::exception
 		{
 			public:
+				OutOfBoundsException()
+				{
+					INSTRUMENT_COUNT(BOUNDS_THROWS, 1);
+				}
+
 				virtual const char* what() const throw()
 				{
 					return "Error: Index out of bounds";
@@ -37,6 +157,10 @@ class Array
 		};
 };
 
+// Non-member swap so that `swap(a, b)` picks the O(1) version
+template <typename T, typename Alloc, typename Bounds>
+void swap(Array<T, Alloc, Bounds>& a, Array<T, Alloc, Bounds>& b) throw();
+
 #include "Array.tpp"
 
 #endif
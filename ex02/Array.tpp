@@ -2,98 +2,788 @@
 #define ARRAY_TPP
 
 #include "Array.hpp"
+#include <new>
+#include <cstring>
+#if __cplusplus >= 201103L
+# include <utility>
+#endif
+
+// ==================== Raw storage helpers ====================
+
+// Storage is raw memory: only the first _size slots hold live objects, the
+// remaining (_capacity - _size) slots are never constructed.
+
+template <typename T, typename Alloc, typename Bounds>
+T* Array<T, Alloc, Bounds>::allocate(size_t n)
+{
+	if (n == 0)
+		return NULL;
+	if (n > max_size())
+		throw std::length_error("Array: requested size is too large");
+	INSTRUMENT_COUNT(ALLOCATIONS, 1);
+	INSTRUMENT_COUNT(ALLOCATED_BYTES, n * sizeof(T));
+	return static_cast<T*>(_alloc.allocate(n * sizeof(T), __alignof__(T)));
+}
+
+template <typename T, typename Alloc, typename Bounds>
+void Array<T, Alloc, Bounds>::deallocate(T* p, size_t n)
+{
+	if (p != NULL)
+		_alloc.deallocate(p, n * sizeof(T), __alignof__(T));
+}
+
+template <typename T, typename Alloc, typename Bounds>
+void Array<T, Alloc, Bounds>::destroy(T* first, T* last)
+{
+	// Trivially copyable types have no-op destructors; skipping the loop
+	// matters for unoptimized builds, which would still walk every element
+	if (TypeTraits<T>::trivialCopy)
+		return;
+	for (; first != last; ++first)
+		first->~T();
+}
+
+// Bulk paths: trivially copyable (or relocatable, or zero-initializable)
+// element types move through memcpy/memset instead of per-element loops.
+// Pointers are passed as void* so the calls compile for every T; the
+// condition is a compile-time constant and the other branch disappears.
+
+namespace ArrayDetail
+{
+	template <typename T>
+	bool zeroBytes(T const & value)
+	{
+		unsigned char const * bytes = reinterpret_cast<unsigned char const *>(&value);
+		for (size_t i = 0; i < sizeof(T); i++)
+			if (bytes[i] != 0)
+				return false;
+		return true;
+	}
+
+	// n copies of a trivially copyable value: one memset when the value is a
+	// single byte or all zero bytes, a plain (vectorizable) loop otherwise
+	template <typename T>
+	void fillTrivial(T* dst, size_t n, T const & value)
+	{
+		if (n == 0)
+			return;
+		if (sizeof(T) == 1 || zeroBytes(value))
+		{
+			std::memset(static_cast<void*>(dst), *reinterpret_cast<unsigned char const *>(&value), n * sizeof(T));
+			return;
+		}
+		for (size_t i = 0; i < n; i++)
+			new (dst + i) T(value);
+	}
+}
+
+template <typename T, typename Alloc, typename Bounds>
+void Array<T, Alloc, Bounds>::uninitializedCopy(T const * src, size_t n, T* dst)
+{
+	if (TypeTraits<T>::trivialCopy)
+	{
+		if (n > 0)
+			std::memcpy(static_cast<void*>(dst), static_cast<void const *>(src), n * sizeof(T));
+		return;
+	}
+
+	size_t i = 0;
+	try
+	{
+		for (; i < n; i++)
+			new (dst + i) T(src[i]);
+	}
+	catch (...)
+	{
+		destroy(dst, dst + i);
+		throw;
+	}
+}
+
+// Moves elements when T's move constructor cannot throw, copies otherwise,
+// so a throwing copy leaves the original buffer intact (strong guarantee)
+// Relocatable types are moved as bytes: nothing to construct, nothing to
+// destroy, and nothing that can throw.
+template <typename T, typename Alloc, typename Bounds>
+void Array<T, Alloc, Bounds>::relocateTo(T* dst, size_t newCapacity)
+{
+	if (TypeTraits<T>::trivialRelocate)
+	{
+		if (_size > 0)
+			std::memcpy(static_cast<void*>(dst), static_cast<void const *>(_array), _size * sizeof(T));
+		deallocate(_array, _capacity);
+		_array = dst;
+		_capacity = newCapacity;
+		return;
+	}
+
+#if __cplusplus >= 201103L
+	size_t i = 0;
+	try
+	{
+		for (; i < _size; i++)
+			new (dst + i) T(std::move_if_noexcept(_array[i]));
+	}
+	catch (...)
+	{
+		destroy(dst, dst + i);
+		throw;
+	}
+#else
+	uninitializedCopy(_array, _size, dst);
+#endif
+	destroy(_array, _array + _size);
+	deallocate(_array, _capacity);
+	_array = dst;
+	_capacity = newCapacity;
+}
+
+// Doubles the capacity (at least `needed`), saturating at max_size()
+template <typename T, typename Alloc, typename Bounds>
+size_t Array<T, Alloc, Bounds>::grownCapacity(size_t needed) const
+{
+	size_t const maxCapacity = max_size();
+	if (needed < _capacity || needed > maxCapacity)
+		throw std::length_error("Array: size overflow");
+	size_t grown = (_capacity > maxCapacity / 2) ? maxCapacity : _capacity * 2;
+	if (grown < 4)
+		grown = 4;
+	return (grown < needed) ? needed : grown;
+}
 
 // ==================== Constructors ====================
 
 // Default constructor: creates an empty array
-template <typename T>
-Array<T>::Array() : _array(NULL), _size(0)
+template <typename T, typename Alloc, typename Bounds>
+Array<T, Alloc, Bounds>::Array() : _array(NULL), _size(0), _capacity(0), _alloc()
+{
+}
+
+// Empty array that will allocate from `alloc` (e.g. an ArenaAllocator)
+template <typename T, typename Alloc, typename Bounds>
+Array<T, Alloc, Bounds>::Array(Alloc const & alloc) : _array(NULL), _size(0), _capacity(0), _alloc(alloc)
 {
 }
 
 // Parametric constructor: creates an array of n elements initialized by default
-// Note: new T() ensures default initialization (0 for int, 0.0 for float, etc.)
-template <typename T>
-Array<T>::Array(unsigned int n) : _array(NULL), _size(n)
+// Note: T() ensures default initialization (0 for int, 0.0 for float, etc.)
+template <typename T, typename Alloc, typename Bounds>
+Array<T, Alloc, Bounds>::Array(size_t n, Alloc const & alloc)
+	: _array(NULL), _size(0), _capacity(0), _alloc(alloc)
+{
+	try
+	{
+		resize(n);
+	}
+	catch (...)
+	{
+		destroy(_array, _array + _size);
+		deallocate(_array, _capacity);
+		throw;
+	}
+}
+
+// For-overwrite constructor: same as Array(n) without the zero-fill pass
+template <typename T, typename Alloc, typename Bounds>
+Array<T, Alloc, Bounds>::Array(size_t n, UninitializedTag, Alloc const & alloc)
+	: _array(NULL), _size(0), _capacity(0), _alloc(alloc)
 {
-	if (n > 0)
-		_array = new T[n]();
+	try
+	{
+		resize(n, uninitialized);
+	}
+	catch (...)
+	{
+		destroy(_array, _array + _size);
+		deallocate(_array, _capacity);
+		throw;
+	}
+}
+
+// Copy constructor: deep copy, allocated from the same allocator as src
+template <typename T, typename Alloc, typename Bounds>
+Array<T, Alloc, Bounds>::Array(Array const & src)
+	: _array(NULL), _size(0), _capacity(0), _alloc(src._alloc)
+{
+	INSTRUMENT_COUNT(DEEP_COPIES, 1);
+	copyFrom(src);
 }
 
-// Copy constructor: deep copy
-template <typename T>
-Array<T>::Array(Array const & src) : _array(NULL), _size(0)
+// Deep copy of src allocated from another allocator
+template <typename T, typename Alloc, typename Bounds>
+Array<T, Alloc, Bounds>::Array(Array const & src, Alloc const & alloc)
+	: _array(NULL), _size(0), _capacity(0), _alloc(alloc)
 {
-	*this = src;
+	INSTRUMENT_COUNT(DEEP_COPIES, 1);
+	copyFrom(src);
 }
 
+// Elements are copy-constructed straight into raw memory (no default
+// construction pass); if a copy throws, the buffer is released before rethrowing
+template <typename T, typename Alloc, typename Bounds>
+void Array<T, Alloc, Bounds>::copyFrom(Array const & src)
+{
+	if (src._size == 0)
+		return;
+
+	T* buffer = allocate(src._size);
+	try
+	{
+		uninitializedCopy(src._array, src._size, buffer);
+	}
+	catch (...)
+	{
+		deallocate(buffer, src._size);
+		throw;
+	}
+	_array = buffer;
+	_size = src._size;
+	_capacity = src._size;
+}
+
+#if __cplusplus >= 201103L
+// Move constructor: takes ownership of src's buffer (and allocator), leaves src empty
+template <typename T, typename Alloc, typename Bounds>
+Array<T, Alloc, Bounds>::Array(Array&& src) noexcept
+	: _array(src._array), _size(src._size), _capacity(src._capacity), _alloc(src._alloc)
+{
+	src._array = NULL;
+	src._size = 0;
+	src._capacity = 0;
+}
+#endif
+
 // ==================== Destructor ====================
 
-template <typename T>
-Array<T>::~Array()
+template <typename T, typename Alloc, typename Bounds>
+Array<T, Alloc, Bounds>::~Array()
 {
-	if (_array != NULL)
-		delete[] _array;
+	destroy(_array, _array + _size);
+	deallocate(_array, _capacity);
 }
 
 // ==================== Assignment operator ====================
 
-template <typename T>
-Array<T>& Array<T>::operator=(Array const & rhs)
+// Strong exception guarantee: if copying throws, *this is left unchanged.
+// When rhs fits in our capacity and copying an element cannot throw, the
+// existing buffer is reused and no allocation happens at all.
+// Otherwise the copy is built first, then swapped in (copy-and-swap).
+// The allocator is not propagated: *this keeps allocating from its own.
+template <typename T, typename Alloc, typename Bounds>
+Array<T, Alloc, Bounds>& Array<T, Alloc, Bounds>::operator=(Array const & rhs)
 {
 	// Self-assignment protection
-	if (this != &rhs)
+	if (this == &rhs)
+		return *this;
+
+	if (rhs._size <= _capacity && TypeTraits<T>::trivialCopy)
+	{
+		INSTRUMENT_COUNT(DEEP_COPIES, 1);	// The other branch counts in Array(rhs, _alloc)
+		destroy(_array, _array + _size);
+		_size = 0;
+		uninitializedCopy(rhs._array, rhs._size, _array);
+		_size = rhs._size;
+	}
+	else
 	{
-		// Delete old array
-		if (_array != NULL)
-			delete[] _array;
+		Array tmp(rhs, _alloc);
+		swap(tmp);
+	}
+	return *this;
+}
 
-		// Copy size
+#if __cplusplus >= 201103L
+// Move assignment: releases our buffer and takes rhs's, along with the
+// allocator that owns it
+template <typename T, typename Alloc, typename Bounds>
+Array<T, Alloc, Bounds>& Array<T, Alloc, Bounds>::operator=(Array&& rhs) noexcept
+{
+	if (this != &rhs)
+	{
+		destroy(_array, _array + _size);
+		deallocate(_array, _capacity);
+		_array = rhs._array;
 		_size = rhs._size;
+		_capacity = rhs._capacity;
+		_alloc = rhs._alloc;
+		rhs._array = NULL;
+		rhs._size = 0;
+		rhs._capacity = 0;
+	}
+	return *this;
+}
+#endif
 
-		// Allocate new array
-		if (_size > 0)
-		{
-			_array = new T[_size]();
+// ==================== Expressions ====================
 
-			// Deep copy elements
-			for (unsigned int i = 0; i < _size; i++)
-				_array[i] = rhs._array[i];
-		}
-		else
-		{
-			_array = NULL;
-		}
+template <typename T, typename Alloc, typename Bounds>
+template <typename E>
+Array<T, Alloc, Bounds>::Array(ExprDetail::Expr<E> const & expr, Alloc const & alloc)
+	: _array(NULL), _size(0), _capacity(0), _alloc(alloc)
+{
+	try
+	{
+		E const & e = expr.self();
+		resize(e.size(), uninitialized);
+		T* out = data();
+		for (size_t i = 0; i < _size; i++)
+			out[i] = e[i];
+	}
+	catch (...)
+	{
+		destroy(_array, _array + _size);
+		deallocate(_array, _capacity);
+		throw;
+	}
+}
+
+// Element i of the result reads only element i of each operand, so the
+// expression may read this array: equal sizes are evaluated in place.
+// Any other size means we are not an operand, and get a new buffer.
+template <typename T, typename Alloc, typename Bounds>
+template <typename E>
+Array<T, Alloc, Bounds>& Array<T, Alloc, Bounds>::operator=(ExprDetail::Expr<E> const & expr)
+{
+	E const & e = expr.self();
+	if (e.size() != _size)
+	{
+		Array tmp(e.size(), uninitialized, _alloc);
+		swap(tmp);
 	}
+	T* out = data();
+	for (size_t i = 0; i < _size; i++)
+		out[i] = e[i];
 	return *this;
 }
 
+// ==================== Swap ====================
+
+// Buffers travel with the allocator that owns them
+template <typename T, typename Alloc, typename Bounds>
+void Array<T, Alloc, Bounds>::swap(Array& other) throw()
+{
+	T* tmpArray = _array;
+	_array = other._array;
+	other._array = tmpArray;
+
+	size_t tmpSize = _size;
+	_size = other._size;
+	other._size = tmpSize;
+
+	size_t tmpCapacity = _capacity;
+	_capacity = other._capacity;
+	other._capacity = tmpCapacity;
+
+	Alloc tmpAlloc = _alloc;
+	_alloc = other._alloc;
+	other._alloc = tmpAlloc;
+}
+
+template <typename T, typename Alloc, typename Bounds>
+void swap(Array<T, Alloc, Bounds>& a, Array<T, Alloc, Bounds>& b) throw()
+{
+	a.swap(b);
+}
+
 // ==================== Subscript operator ====================
 
 // Non-const version: allows modification
-template <typename T>
-T& Array<T>::operator[](unsigned int index)
+template <typename T, typename Alloc, typename Bounds>
+T& Array<T, Alloc, Bounds>::operator[](size_t index)
 {
-	if (index >= _size)
+	if (Bounds::outOfRange(index, _size))
 		throw OutOfBoundsException();
 	return _array[index];
 }
 
 // Const version: read-only access
-template <typename T>
-T const & Array<T>::operator[](unsigned int index) const
+template <typename T, typename Alloc, typename Bounds>
+T const & Array<T, Alloc, Bounds>::operator[](size_t index) const
+{
+	if (Bounds::outOfRange(index, _size))
+		throw OutOfBoundsException();
+	return _array[index];
+}
+
+template <typename T, typename Alloc, typename Bounds>
+T& Array<T, Alloc, Bounds>::at(size_t index)
 {
 	if (index >= _size)
 		throw OutOfBoundsException();
 	return _array[index];
 }
 
+template <typename T, typename Alloc, typename Bounds>
+T const & Array<T, Alloc, Bounds>::at(size_t index) const
+{
+	if (index >= _size)
+		throw OutOfBoundsException();
+	return _array[index];
+}
+
+// ==================== Raw access ====================
+
+template <typename T, typename Alloc, typename Bounds>
+size_t const Array<T, Alloc, Bounds>::ALIGNMENT;
+
+// NULL (empty array) satisfies any alignment, so the hint always holds
+template <typename T, typename Alloc, typename Bounds>
+T* Array<T, Alloc, Bounds>::data()
+{
+	return static_cast<T*>(__builtin_assume_aligned(_array, ALIGNMENT));
+}
+
+template <typename T, typename Alloc, typename Bounds>
+T const * Array<T, Alloc, Bounds>::data() const
+{
+	return static_cast<T const *>(__builtin_assume_aligned(_array, ALIGNMENT));
+}
+
+template <typename T, typename Alloc, typename Bounds>
+T* Array<T, Alloc, Bounds>::begin()
+{
+	return data();
+}
+
+template <typename T, typename Alloc, typename Bounds>
+T const * Array<T, Alloc, Bounds>::begin() const
+{
+	return data();
+}
+
+template <typename T, typename Alloc, typename Bounds>
+T* Array<T, Alloc, Bounds>::end()
+{
+	return _array + _size;
+}
+
+template <typename T, typename Alloc, typename Bounds>
+T const * Array<T, Alloc, Bounds>::end() const
+{
+	return _array + _size;
+}
+
+// ==================== Views ====================
+
+template <typename T, typename Alloc, typename Bounds>
+Array<T, Alloc, Bounds>::operator ArrayView<T>()
+{
+	return ArrayView<T>(_array, _size);
+}
+
+template <typename T, typename Alloc, typename Bounds>
+Array<T, Alloc, Bounds>::operator ArrayView<T const>() const
+{
+	return ArrayView<T const>(_array, _size);
+}
+
+template <typename T, typename Alloc, typename Bounds>
+ArrayView<T> Array<T, Alloc, Bounds>::view()
+{
+	return ArrayView<T>(_array, _size);
+}
+
+template <typename T, typename Alloc, typename Bounds>
+ArrayView<T const> Array<T, Alloc, Bounds>::view() const
+{
+	return ArrayView<T const>(_array, _size);
+}
+
+template <typename T, typename Alloc, typename Bounds>
+ArrayView<T> Array<T, Alloc, Bounds>::slice(size_t begin, size_t end)
+{
+	return view().slice(begin, end);
+}
+
+template <typename T, typename Alloc, typename Bounds>
+ArrayView<T const> Array<T, Alloc, Bounds>::slice(size_t begin, size_t end) const
+{
+	return view().slice(begin, end);
+}
+
 // ==================== Member function ====================
 
-template <typename T>
-unsigned int Array<T>::size() const
+template <typename T, typename Alloc, typename Bounds>
+size_t Array<T, Alloc, Bounds>::size() const
 {
 	return _size;
 }
 
+template <typename T, typename Alloc, typename Bounds>
+Alloc Array<T, Alloc, Bounds>::get_allocator() const
+{
+	return _alloc;
+}
+
+// ==================== Capacity ====================
+
+template <typename T, typename Alloc, typename Bounds>
+size_t Array<T, Alloc, Bounds>::capacity() const
+{
+	return _capacity;
+}
+
+// Largest byte count whose pointer differences still fit in ptrdiff_t
+template <typename T, typename Alloc, typename Bounds>
+size_t Array<T, Alloc, Bounds>::max_size() const
+{
+	return static_cast<size_t>(-1) / 2 / sizeof(T);
+}
+
+template <typename T, typename Alloc, typename Bounds>
+bool Array<T, Alloc, Bounds>::empty() const
+{
+	return _size == 0;
+}
+
+// Grows the buffer to hold at least n elements; never shrinks
+template <typename T, typename Alloc, typename Bounds>
+void Array<T, Alloc, Bounds>::reserve(size_t n)
+{
+	if (n <= _capacity)
+		return;
+
+	T* buffer = allocate(n);
+	try
+	{
+		relocateTo(buffer, n);
+	}
+	catch (...)
+	{
+		deallocate(buffer, n);
+		throw;
+	}
+}
+
+// New elements are value-initialized (0 for int, like Array(n))
+template <typename T, typename Alloc, typename Bounds>
+void Array<T, Alloc, Bounds>::resize(size_t n)
+{
+	if (n <= _size)
+	{
+		destroy(_array + n, _array + _size);
+		_size = n;
+		return;
+	}
+	reserve(n);
+	if (TypeTraits<T>::zeroInit)
+	{
+		std::memset(static_cast<void*>(_array + _size), 0, (n - _size) * sizeof(T));
+		_size = n;
+		return;
+	}
+	for (; _size < n; _size++)
+		new (_array + _size) T();
+}
+
+template <typename T, typename Alloc, typename Bounds>
+void Array<T, Alloc, Bounds>::resize(size_t n, T const & value)
+{
+	if (n <= _size)
+	{
+		destroy(_array + n, _array + _size);
+		_size = n;
+		return;
+	}
+	if (TypeTraits<T>::trivialCopy)
+	{
+		T copy(value);
+		reserve(n);
+		ArrayDetail::fillTrivial(_array + _size, n - _size, copy);
+		_size = n;
+		return;
+	}
+	if (n > _capacity)
+	{
+		// value may live in our buffer: copy it before relocating
+		T copy(value);
+		reserve(n);
+		for (; _size < n; _size++)
+			new (_array + _size) T(copy);
+		return;
+	}
+	for (; _size < n; _size++)
+		new (_array + _size) T(value);
+}
+
+// New elements are default-initialized: left indeterminate when T is
+// trivially constructible, constructed with T's default constructor otherwise
+template <typename T, typename Alloc, typename Bounds>
+void Array<T, Alloc, Bounds>::resize(size_t n, UninitializedTag)
+{
+	if (n <= _size)
+	{
+		destroy(_array + n, _array + _size);
+		_size = n;
+		return;
+	}
+	reserve(n);
+	if (TypeTraits<T>::trivialDefault)
+	{
+		_size = n;
+		return;
+	}
+	for (; _size < n; _size++)
+		new (_array + _size) T;
+}
+
+// Releases unused capacity (reallocates to exactly size() elements)
+template <typename T, typename Alloc, typename Bounds>
+void Array<T, Alloc, Bounds>::shrink_to_fit()
+{
+	if (_capacity == _size)
+		return;
+	if (_size == 0)
+	{
+		deallocate(_array, _capacity);
+		_array = NULL;
+		_capacity = 0;
+		return;
+	}
+
+	T* buffer = allocate(_size);
+	try
+	{
+		relocateTo(buffer, _size);
+	}
+	catch (...)
+	{
+		deallocate(buffer, _size);
+		throw;
+	}
+}
+
+// Destroys every element but keeps the capacity
+template <typename T, typename Alloc, typename Bounds>
+void Array<T, Alloc, Bounds>::clear()
+{
+	destroy(_array, _array + _size);
+	_size = 0;
+}
+
+// ==================== Appending ====================
+
+// The new element is constructed in the new buffer *before* the old one is
+// released, so pushing a reference to one of our own elements stays valid.
+// `Construct` is a functor that placement-constructs the element at an address.
+
+namespace ArrayDetail
+{
+	template <typename T>
+	struct CopyConstruct
+	{
+		T const & value;
+		CopyConstruct(T const & v) : value(v) {}
+		void operator()(void* p) const { new (p) T(value); }
+	};
+
+#if __cplusplus < 201103L
+	template <typename T>
+	struct DefaultConstruct
+	{
+		void operator()(void* p) const { new (p) T(); }
+	};
+
+	template <typename T, typename A1>
+	struct Construct1
+	{
+		A1 const & a1;
+		Construct1(A1 const & a) : a1(a) {}
+		void operator()(void* p) const { new (p) T(a1); }
+	};
+
+	template <typename T, typename A1, typename A2>
+	struct Construct2
+	{
+		A1 const & a1;
+		A2 const & a2;
+		Construct2(A1 const & a, A2 const & b) : a1(a), a2(b) {}
+		void operator()(void* p) const { new (p) T(a1, a2); }
+	};
+#endif
+}
+
+template <typename T, typename Alloc, typename Bounds>
+template <typename Construct>
+T& Array<T, Alloc, Bounds>::emplaceWith(Construct const & construct)
+{
+	if (_size < _capacity)
+	{
+		construct(_array + _size);
+		return _array[_size++];
+	}
+
+	size_t newCapacity = grownCapacity(_size + 1);
+	T* buffer = allocate(newCapacity);
+	try
+	{
+		construct(buffer + _size);
+	}
+	catch (...)
+	{
+		deallocate(buffer, newCapacity);
+		throw;
+	}
+	try
+	{
+		relocateTo(buffer, newCapacity);
+	}
+	catch (...)
+	{
+		buffer[_size].~T();
+		deallocate(buffer, newCapacity);
+		throw;
+	}
+	return _array[_size++];
+}
+
+template <typename T, typename Alloc, typename Bounds>
+void Array<T, Alloc, Bounds>::push_back(T const & value)
+{
+	emplaceWith(ArrayDetail::CopyConstruct<T>(value));
+}
+
+#if __cplusplus >= 201103L
+template <typename T, typename Alloc, typename Bounds>
+void Array<T, Alloc, Bounds>::push_back(T&& value)
+{
+	emplaceWith([&](void* p) { new (p) T(std::move(value)); });
+}
+
+template <typename T, typename Alloc, typename Bounds>
+template <typename... Args>
+T& Array<T, Alloc, Bounds>::emplace_back(Args&&... args)
+{
+	return emplaceWith([&](void* p) { new (p) T(std::forward<Args>(args)...); });
+}
+#else
+template <typename T, typename Alloc, typename Bounds>
+T& Array<T, Alloc, Bounds>::emplace_back()
+{
+	return emplaceWith(ArrayDetail::DefaultConstruct<T>());
+}
+
+template <typename T, typename Alloc, typename Bounds>
+template <typename A1>
+T& Array<T, Alloc, Bounds>::emplace_back(A1 const & a1)
+{
+	return emplaceWith(ArrayDetail::Construct1<T, A1>(a1));
+}
+
+template <typename T, typename Alloc, typename Bounds>
+template <typename A1, typename A2>
+T& Array<T, Alloc, Bounds>::emplace_back(A1 const & a1, A2 const & a2)
+{
+	return emplaceWith(ArrayDetail::Construct2<T, A1, A2>(a1, a2));
+}
+#endif
+
+template <typename T, typename Alloc, typename Bounds>
+void Array<T, Alloc, Bounds>::pop_back()
+{
+	if (_size == 0)
+		throw OutOfBoundsException();
+	_array[--_size].~T();
+}
+
 #endif
@@ -0,0 +1,260 @@
+#ifndef ARRAYEXPR_HPP
+#define ARRAYEXPR_HPP
+
+#include <cstddef>
+#include <stdexcept>
+#include "Array.hpp"
+#include "../ex01/ParallelIter.hpp"
+
+// Element-wise arithmetic on Arrays with expression templates. Operators
+// build a small expression object instead of computing anything; the
+// assignment then evaluates the whole expression in one loop, with no
+// temporary arrays:
+//   c = a * 2 + b;                 // c[i] = a[i] * 2 + b[i], one pass
+//   a = a + b;                     // fine: element i only reads element i
+//   a -= b * 0.5;                  // compound forms of + - * /
+//   Array<int> d = -(a + b) / 3;
+//   evaluate(par, c, a * 2 + b);   // the same loop split over a thread pool
+// Operands are Arrays of the same element type and size (a mismatch
+// throws std::invalid_argument when the expression is built) or scalars,
+// converted to the element type. Expressions refer to their Arrays: build
+// and assign them in one statement.
+//
+// The loop reads plain pointers, so the compiler vectorizes it like a
+// hand-written one.
+
+namespace ExprDetail
+{
+	// Base of every expression node, so the operators below only match
+	// Arrays, expressions and scalars
+	template <typename E>
+	struct Expr
+	{
+		E const & self() const
+		{
+			return static_cast<E const &>(*this);
+		}
+	};
+
+	// Makes a parameter non-deducible: scalars take the element type
+	template <typename T>
+	struct Identity
+	{
+		typedef T Type;
+	};
+
+	// Array operand (its data pointer and size)
+	template <typename T>
+	struct Leaf : public Expr<Leaf<T> >
+	{
+		typedef T Value;
+		static bool const SCALAR = false;
+
+		T const *	data;
+		size_t		length;
+
+		template <typename A, typename B>
+		Leaf(Array<T, A, B> const & array) : data(array.data()), length(array.size()) {}
+
+		size_t size() const { return length; }
+		T operator[](size_t i) const { return data[i]; }
+	};
+
+	// Scalar operand: the same value at every index, no size of its own
+	template <typename T>
+	struct Scalar : public Expr<Scalar<T> >
+	{
+		typedef T Value;
+		static bool const SCALAR = true;
+
+		T	value;
+
+		Scalar(T v) : value(v) {}
+
+		size_t size() const { return 0; }
+		T operator[](size_t) const { return value; }
+	};
+
+	struct Plus { template <typename T> static T apply(T a, T b) { return a + b; } };
+	struct Minus { template <typename T> static T apply(T a, T b) { return a - b; } };
+	struct Multiplies { template <typename T> static T apply(T a, T b) { return a * b; } };
+	struct Divides { template <typename T> static T apply(T a, T b) { return a / b; } };
+
+	// Children are held by value: nodes are a few pointers and scalars
+	template <typename L, typename R, typename Op>
+	struct Binary : public Expr<Binary<L, R, Op> >
+	{
+		typedef typename L::Value Value;
+		static bool const SCALAR = false;
+
+		L		left;
+		R		right;
+		size_t	length;
+
+		Binary(L const & l, R const & r) : left(l), right(r), length(l.size())
+		{
+			if (L::SCALAR)
+				length = r.size();
+			else if (!R::SCALAR && r.size() != length)
+				throw std::invalid_argument("Array expression: sizes differ");
+		}
+
+		size_t size() const { return length; }
+		Value operator[](size_t i) const { return Op::apply(left[i], right[i]); }
+	};
+
+	template <typename E>
+	struct Negate : public Expr<Negate<E> >
+	{
+		typedef typename E::Value Value;
+		static bool const SCALAR = false;
+
+		E	operand;
+
+		Negate(E const & e) : operand(e) {}
+
+		size_t size() const { return operand.size(); }
+		Value operator[](size_t i) const { return -operand[i]; }
+	};
+
+	// out[i] = e[i] for i in [begin, end)
+	template <typename T, typename E>
+	void evaluateRange(T* out, E const & e, size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+			out[i] = e[i];
+	}
+
+	// ThreadPool::run task: chunk index of dst
+	template <typename T, typename E>
+	struct ChunkEvaluation
+	{
+		T*					out;
+		E const &			e;
+		IterDetail::Chunks	chunks;
+
+		ChunkEvaluation(T* o, E const & expr, IterDetail::Chunks const & c) : out(o), e(expr), chunks(c) {}
+
+		void operator()(size_t index)
+		{
+			evaluateRange(out, e, chunks.begin(index), chunks.begin(index + 1));
+		}
+	};
+}
+
+// ==================== Operators ====================
+
+// Every combination of Array, expression and scalar operands
+#define ARRAY_EXPR_OPERATOR(OP, COMPOUND, Op) \
+	template <typename L, typename R> \
+	ExprDetail::Binary<L, R, ExprDetail::Op> \
+	operator OP(ExprDetail::Expr<L> const & l, ExprDetail::Expr<R> const & r) \
+	{ \
+		return ExprDetail::Binary<L, R, ExprDetail::Op>(l.self(), r.self()); \
+	} \
+	template <typename T, typename A, typename B, typename R> \
+	ExprDetail::Binary<ExprDetail::Leaf<T>, R, ExprDetail::Op> \
+	operator OP(Array<T, A, B> const & l, ExprDetail::Expr<R> const & r) \
+	{ \
+		return ExprDetail::Binary<ExprDetail::Leaf<T>, R, ExprDetail::Op>(l, r.self()); \
+	} \
+	template <typename L, typename T, typename A, typename B> \
+	ExprDetail::Binary<L, ExprDetail::Leaf<T>, ExprDetail::Op> \
+	operator OP(ExprDetail::Expr<L> const & l, Array<T, A, B> const & r) \
+	{ \
+		return ExprDetail::Binary<L, ExprDetail::Leaf<T>, ExprDetail::Op>(l.self(), r); \
+	} \
+	template <typename T, typename A1, typename B1, typename A2, typename B2> \
+	ExprDetail::Binary<ExprDetail::Leaf<T>, ExprDetail::Leaf<T>, ExprDetail::Op> \
+	operator OP(Array<T, A1, B1> const & l, Array<T, A2, B2> const & r) \
+	{ \
+		return ExprDetail::Binary<ExprDetail::Leaf<T>, ExprDetail::Leaf<T>, ExprDetail::Op>(l, r); \
+	} \
+	template <typename T, typename A, typename B> \
+	ExprDetail::Binary<ExprDetail::Leaf<T>, ExprDetail::Scalar<T>, ExprDetail::Op> \
+	operator OP(Array<T, A, B> const & l, typename ExprDetail::Identity<T>::Type const & r) \
+	{ \
+		return ExprDetail::Binary<ExprDetail::Leaf<T>, ExprDetail::Scalar<T>, ExprDetail::Op>(l, r); \
+	} \
+	template <typename T, typename A, typename B> \
+	ExprDetail::Binary<ExprDetail::Scalar<T>, ExprDetail::Leaf<T>, ExprDetail::Op> \
+	operator OP(typename ExprDetail::Identity<T>::Type const & l, Array<T, A, B> const & r) \
+	{ \
+		return ExprDetail::Binary<ExprDetail::Scalar<T>, ExprDetail::Leaf<T>, ExprDetail::Op>(l, r); \
+	} \
+	template <typename L> \
+	ExprDetail::Binary<L, ExprDetail::Scalar<typename L::Value>, ExprDetail::Op> \
+	operator OP(ExprDetail::Expr<L> const & l, typename L::Value const & r) \
+	{ \
+		typedef ExprDetail::Scalar<typename L::Value> S; \
+		return ExprDetail::Binary<L, S, ExprDetail::Op>(l.self(), S(r)); \
+	} \
+	template <typename R> \
+	ExprDetail::Binary<ExprDetail::Scalar<typename R::Value>, R, ExprDetail::Op> \
+	operator OP(typename R::Value const & l, ExprDetail::Expr<R> const & r) \
+	{ \
+		typedef ExprDetail::Scalar<typename R::Value> S; \
+		return ExprDetail::Binary<S, R, ExprDetail::Op>(S(l), r.self()); \
+	} \
+	template <typename T, typename A, typename B, typename E> \
+	Array<T, A, B>& operator COMPOUND(Array<T, A, B>& a, ExprDetail::Expr<E> const & e) \
+	{ \
+		return a = a OP e; \
+	} \
+	template <typename T, typename A1, typename B1, typename A2, typename B2> \
+	Array<T, A1, B1>& operator COMPOUND(Array<T, A1, B1>& a, Array<T, A2, B2> const & b) \
+	{ \
+		return a = a OP b; \
+	} \
+	template <typename T, typename A, typename B> \
+	Array<T, A, B>& operator COMPOUND(Array<T, A, B>& a, typename ExprDetail::Identity<T>::Type const & s) \
+	{ \
+		return a = a OP s; \
+	}
+
+ARRAY_EXPR_OPERATOR(+, +=, Plus)
+ARRAY_EXPR_OPERATOR(-, -=, Minus)
+ARRAY_EXPR_OPERATOR(*, *=, Multiplies)
+ARRAY_EXPR_OPERATOR(/, /=, Divides)
+
+#undef ARRAY_EXPR_OPERATOR
+
+template <typename E>
+ExprDetail::Negate<E> operator-(ExprDetail::Expr<E> const & e)
+{
+	return ExprDetail::Negate<E>(e.self());
+}
+
+template <typename T, typename A, typename B>
+ExprDetail::Negate<ExprDetail::Leaf<T> > operator-(Array<T, A, B> const & a)
+{
+	return ExprDetail::Negate<ExprDetail::Leaf<T> >(ExprDetail::Leaf<T>(a));
+}
+
+// ==================== Parallel evaluation ====================
+
+// dst = e, with the loop split on the policy's pool into the chunks of
+// the parallel iter: every chunk but the first starts on a cache line of
+// dst. Short arrays and single-thread pools run it inline.
+template <typename T, typename A, typename B, typename E>
+void evaluate(ParallelPolicy const & policy, Array<T, A, B>& dst, ExprDetail::Expr<E> const & e)
+{
+	size_t n = e.self().size();
+	ThreadPool& pool = (policy.pool != NULL) ? *policy.pool : ThreadPool::shared();
+	if (n < IterDetail::SERIAL_THRESHOLD || pool.size() == 1)
+	{
+		dst = e;
+		return;
+	}
+	if (dst.size() != n)
+	{
+		Array<T, A, B> tmp(n, uninitialized, dst.get_allocator());
+		dst.swap(tmp);
+	}
+
+	IterDetail::Chunks chunks = IterDetail::alignedChunks(dst.data(), n, policy.grain, pool.size());
+	ExprDetail::ChunkEvaluation<T, E> task(dst.data(), e.self(), chunks);
+	pool.run(task, chunks.count());
+}
+
+#endif
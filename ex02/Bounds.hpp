@@ -0,0 +1,47 @@
+#ifndef BOUNDS_HPP
+#define BOUNDS_HPP
+
+#include <cassert>
+#include <cstddef>
+
+// Bounds-checking policies for Array::operator[]. outOfRange() returning true
+// makes operator[] throw OutOfBoundsException; at() always checks.
+//   Array<int>                                    -> build default (checked)
+//   Array<int, HeapAllocator, UncheckedBounds>    -> per instantiation
+// The build default can be changed with -DARRAY_DEFAULT_BOUNDS=AssertBounds.
+
+// Throws on every out-of-range access (the original behaviour)
+struct CheckedBounds
+{
+	static bool outOfRange(size_t index, size_t size)
+	{
+		return index >= size;
+	}
+};
+
+// assert() in debug builds, no check at all with -DNDEBUG
+struct AssertBounds
+{
+	static bool outOfRange(size_t index, size_t size)
+	{
+		assert(index < size);
+		(void)index;
+		(void)size;
+		return false;
+	}
+};
+
+// No check: lets the compiler vectorize loops over operator[]
+struct UncheckedBounds
+{
+	static bool outOfRange(size_t, size_t)
+	{
+		return false;
+	}
+};
+
+#ifndef ARRAY_DEFAULT_BOUNDS
+# define ARRAY_DEFAULT_BOUNDS CheckedBounds
+#endif
+
+#endif
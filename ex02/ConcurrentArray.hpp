@@ -0,0 +1,109 @@
+#ifndef CONCURRENTARRAY_HPP
+#define CONCURRENTARRAY_HPP
+
+#include <cstddef>
+#include <stdexcept>
+#include "Array.hpp"
+
+// Append-only array shared by many producer threads, without a lock
+// (GCC __atomic builtins). T must be trivially copyable.
+//
+// Storage is a list of segments that never move: segment k holds
+// FIRST_SEGMENT << k elements, so 54 segments cover the whole 64-bit
+// index range and growth never copies. push_back() claims an index with
+// one atomic increment, installs the segment if it is the first one
+// there (the losers of that race free theirs), copies the value and marks
+// the slot ready. Elements then become visible in index order:
+// size() is the length of the prefix whose slots are all ready. The
+// last producer to finish advances it, so no producer ever waits for
+// another.
+//
+//   ConcurrentArray<Event> log;
+//   log.push_back(event);                      // any thread
+//   for (size_t i = 0; i < log.size(); i++)    // any thread, wait-free
+//       use(log[i]);
+//   ConcurrentArray<Event>::Snapshot s = log.snapshot();
+//   iter(s.segment(0), func);                  // zero-copy views
+//   Array<Event> copy = s.toArray();           // or one contiguous copy
+//
+// Published elements are never modified or moved, so references from
+// operator[] stay valid for the lifetime of the array. Destruction must
+// not overlap with other calls.
+template <typename T>
+class ConcurrentArray
+{
+	public:
+		static size_t const FIRST_SHIFT = 10;
+		static size_t const FIRST_SEGMENT = static_cast<size_t>(1) << FIRST_SHIFT;
+		static size_t const MAX_SEGMENTS = sizeof(size_t) * 8 - FIRST_SHIFT;
+
+		// Consistent view of the first size() elements at the time it was
+		// taken; later pushes do not change it. Valid while the array lives.
+		class Snapshot
+		{
+			private:
+				ConcurrentArray const *	_owner;
+				size_t					_size;
+
+			public:
+				Snapshot(ConcurrentArray const & owner, size_t size);
+
+				size_t size() const;
+				T const & operator[](size_t index) const;	// Always checked
+
+				// Contiguous pieces, in index order
+				size_t segments() const;
+				ArrayView<T const> segment(size_t k) const;
+
+				Array<T> toArray() const;
+		};
+
+	private:
+		// Producers hammer _claimed; readers poll _published: separate lines
+		size_t			_claimed __attribute__((aligned(64)));
+		size_t			_published __attribute__((aligned(64)));
+		T*				_segments[MAX_SEGMENTS] __attribute__((aligned(64)));
+
+		// posix_memalign at alignof(T): over-aligned element types included
+		typedef AlignedAllocator<sizeof(void*)> SegmentAllocator;
+
+		ConcurrentArray(ConcurrentArray const & src);			// Non-copyable
+		ConcurrentArray& operator=(ConcurrentArray const & rhs);
+
+		static size_t segmentOf(size_t index);
+		static size_t segmentStart(size_t k);
+		static size_t segmentSize(size_t k);
+		static size_t segmentBytes(size_t k);
+		static unsigned char* readyFlags(T* segment, size_t k);
+
+		T* installSegment(size_t k);
+		void advancePublished();
+
+	public:
+		ConcurrentArray();
+		~ConcurrentArray();
+
+		// Lock-free; returns the index the value was stored at
+		size_t push_back(T const & value);
+
+		// Wait-free. Elements below size() are published: fully written and
+		// visible to the calling thread.
+		size_t size() const;
+		bool empty() const;
+		T const & operator[](size_t index) const;	// Always checked
+
+		Snapshot snapshot() const;
+
+		class OutOfBoundsException : public std::exception
+		{
+			public:
+				virtual const char* what() const throw()
+				{
+					return "Error: Index out of bounds";
+				}
+		};
+};
+
+#include "ConcurrentArray.tpp"
+
+#endif
@@ -0,0 +1,215 @@
+#ifndef CONCURRENTARRAY_TPP
+#define CONCURRENTARRAY_TPP
+
+#include "ConcurrentArray.hpp"
+#include <cstring>
+#include <new>
+
+template <typename T>
+size_t const ConcurrentArray<T>::FIRST_SHIFT;
+template <typename T>
+size_t const ConcurrentArray<T>::FIRST_SEGMENT;
+template <typename T>
+size_t const ConcurrentArray<T>::MAX_SEGMENTS;
+
+// ==================== Segments ====================
+
+// Segment k covers [FIRST << k, FIRST << (k + 1)) - FIRST: the position of
+// the highest bit of index + FIRST names it
+template <typename T>
+size_t ConcurrentArray<T>::segmentOf(size_t index)
+{
+	size_t biased = index + FIRST_SEGMENT;
+	size_t highest = sizeof(unsigned long) * 8 - 1 - static_cast<size_t>(__builtin_clzl(biased));
+	return highest - FIRST_SHIFT;
+}
+
+template <typename T>
+size_t ConcurrentArray<T>::segmentStart(size_t k)
+{
+	return (FIRST_SEGMENT << k) - FIRST_SEGMENT;
+}
+
+template <typename T>
+size_t ConcurrentArray<T>::segmentSize(size_t k)
+{
+	return FIRST_SEGMENT << k;
+}
+
+// Elements, then one ready flag per element
+template <typename T>
+size_t ConcurrentArray<T>::segmentBytes(size_t k)
+{
+	return segmentSize(k) * (sizeof(T) + 1);
+}
+
+// One ready flag per element, stored after the elements
+template <typename T>
+unsigned char* ConcurrentArray<T>::readyFlags(T* segment, size_t k)
+{
+	return reinterpret_cast<unsigned char*>(segment + segmentSize(k));
+}
+
+// The first thread to need the segment publishes its block (flags already
+// cleared); the others free theirs and use the winner's. Nobody waits.
+template <typename T>
+T* ConcurrentArray<T>::installSegment(size_t k)
+{
+	size_t n = segmentSize(k);
+	if (n > (static_cast<size_t>(-1) / 2) / (sizeof(T) + 1))
+		throw std::length_error("ConcurrentArray: too many elements");
+	T* block = static_cast<T*>(SegmentAllocator().allocate(segmentBytes(k), __alignof__(T)));
+	std::memset(readyFlags(block, k), 0, n);
+
+	T* installed = NULL;
+	if (__atomic_compare_exchange_n(&_segments[k], &installed, block, false,
+			__ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+		return block;
+	SegmentAllocator().deallocate(block, segmentBytes(k), __alignof__(T));
+	return installed;
+}
+
+// Moves _published past every ready slot. The store of a ready flag and
+// the reload of _published (and the CAS and the flag load here) are
+// sequentially consistent, so of two producers finishing around the same
+// index at least one sees the other's work: no slot is left behind.
+template <typename T>
+void ConcurrentArray<T>::advancePublished()
+{
+	size_t published = __atomic_load_n(&_published, __ATOMIC_SEQ_CST);
+	for (;;)
+	{
+		size_t k = segmentOf(published);
+		T* segment = __atomic_load_n(&_segments[k], __ATOMIC_SEQ_CST);
+		if (segment == NULL
+			|| __atomic_load_n(&readyFlags(segment, k)[published - segmentStart(k)], __ATOMIC_SEQ_CST) == 0)
+			return;
+		if (__atomic_compare_exchange_n(&_published, &published, published + 1, false,
+				__ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST))
+			published++;
+	}
+}
+
+// ==================== Construction ====================
+
+template <typename T>
+ConcurrentArray<T>::ConcurrentArray() : _claimed(0), _published(0)
+{
+	typedef char RequiresTriviallyCopyable[TypeTraits<T>::trivialCopy ? 1 : -1];
+	(void)sizeof(RequiresTriviallyCopyable);
+	for (size_t k = 0; k < MAX_SEGMENTS; k++)
+		_segments[k] = NULL;
+}
+
+// Trivially copyable elements need no destructor call: only blocks are freed
+template <typename T>
+ConcurrentArray<T>::~ConcurrentArray()
+{
+	for (size_t k = 0; k < MAX_SEGMENTS; k++)
+		if (_segments[k] != NULL)
+			SegmentAllocator().deallocate(_segments[k], segmentBytes(k), __alignof__(T));
+}
+
+// ==================== Appending ====================
+
+template <typename T>
+size_t ConcurrentArray<T>::push_back(T const & value)
+{
+	size_t index = __atomic_fetch_add(&_claimed, 1, __ATOMIC_RELAXED);
+	size_t k = segmentOf(index);
+	T* segment = __atomic_load_n(&_segments[k], __ATOMIC_ACQUIRE);
+	if (segment == NULL)
+		segment = installSegment(k);
+	size_t offset = index - segmentStart(k);
+	std::memcpy(static_cast<void*>(segment + offset), &value, sizeof(T));
+	__atomic_store_n(&readyFlags(segment, k)[offset], 1, __ATOMIC_SEQ_CST);
+	advancePublished();
+	return index;
+}
+
+// ==================== Reading ====================
+
+template <typename T>
+size_t ConcurrentArray<T>::size() const
+{
+	return __atomic_load_n(&_published, __ATOMIC_ACQUIRE);
+}
+
+template <typename T>
+bool ConcurrentArray<T>::empty() const
+{
+	return size() == 0;
+}
+
+// The acquire load in size() orders the element's bytes before us
+template <typename T>
+T const & ConcurrentArray<T>::operator[](size_t index) const
+{
+	if (index >= size())
+		throw OutOfBoundsException();
+	size_t k = segmentOf(index);
+	return __atomic_load_n(&_segments[k], __ATOMIC_ACQUIRE)[index - segmentStart(k)];
+}
+
+template <typename T>
+typename ConcurrentArray<T>::Snapshot ConcurrentArray<T>::snapshot() const
+{
+	return Snapshot(*this, size());
+}
+
+// ==================== Snapshot ====================
+
+template <typename T>
+ConcurrentArray<T>::Snapshot::Snapshot(ConcurrentArray const & owner, size_t size)
+	: _owner(&owner), _size(size)
+{
+}
+
+template <typename T>
+size_t ConcurrentArray<T>::Snapshot::size() const
+{
+	return _size;
+}
+
+template <typename T>
+T const & ConcurrentArray<T>::Snapshot::operator[](size_t index) const
+{
+	if (index >= _size)
+		throw OutOfBoundsException();
+	return (*_owner)[index];
+}
+
+template <typename T>
+size_t ConcurrentArray<T>::Snapshot::segments() const
+{
+	return (_size == 0) ? 0 : segmentOf(_size - 1) + 1;
+}
+
+// The last segment is cut at the snapshot's size
+template <typename T>
+ArrayView<T const> ConcurrentArray<T>::Snapshot::segment(size_t k) const
+{
+	if (k >= segments())
+		throw OutOfBoundsException();
+	size_t start = segmentStart(k);
+	size_t count = segmentSize(k);
+	if (count > _size - start)
+		count = _size - start;
+	return ArrayView<T const>(__atomic_load_n(&_owner->_segments[k], __ATOMIC_ACQUIRE), count);
+}
+
+template <typename T>
+Array<T> ConcurrentArray<T>::Snapshot::toArray() const
+{
+	Array<T> result(_size, uninitialized);
+	T* out = result.data();
+	for (size_t k = 0; k < segments(); k++)
+	{
+		ArrayView<T const> piece = segment(k);
+		std::memcpy(static_cast<void*>(out), piece.data(), piece.size() * sizeof(T));
+		out += piece.size();
+	}
+	return result;
+}
+
+#endif
@@ -0,0 +1,153 @@
+// Kernel loops shared by every instruction set. No include guard on purpose:
+// Kernels.tpp includes this file once per instruction-set namespace, after
+// defining that namespace's Vec<T> register traits (and, for instruction
+// sets beyond the build's baseline, inside a matching `#pragma GCC target`).
+//
+// Vec<T> provides: Reg, WIDTH, load/store (unaligned), set1, add, mul, min
+// and max.
+
+// Horizontal reductions: once per call, so a round trip through memory is fine
+template <typename T>
+T reduceAdd(typename Vec<T>::Reg r)
+{
+	T lane[Vec<T>::WIDTH];
+	Vec<T>::store(lane, r);
+	T total = lane[0];
+	for (size_t i = 1; i < Vec<T>::WIDTH; i++)
+		total += lane[i];
+	return total;
+}
+
+template <typename T>
+T reduceMin(typename Vec<T>::Reg r)
+{
+	T lane[Vec<T>::WIDTH];
+	Vec<T>::store(lane, r);
+	T best = lane[0];
+	for (size_t i = 1; i < Vec<T>::WIDTH; i++)
+		best = (lane[i] < best) ? lane[i] : best;
+	return best;
+}
+
+template <typename T>
+T reduceMax(typename Vec<T>::Reg r)
+{
+	T lane[Vec<T>::WIDTH];
+	Vec<T>::store(lane, r);
+	T best = lane[0];
+	for (size_t i = 1; i < Vec<T>::WIDTH; i++)
+		best = (best < lane[i]) ? lane[i] : best;
+	return best;
+}
+
+template <typename T>
+void fill(T* dst, size_t n, T value)
+{
+	typedef Vec<T> V;
+	typename V::Reg r = V::set1(value);
+	size_t i = 0;
+	for (; i + 2 * V::WIDTH <= n; i += 2 * V::WIDTH)
+	{
+		V::store(dst + i, r);
+		V::store(dst + i + V::WIDTH, r);
+	}
+	for (; i < n; i++)
+		dst[i] = value;
+}
+
+template <typename T>
+void scale(T* x, size_t n, T factor)
+{
+	typedef Vec<T> V;
+	typename V::Reg f = V::set1(factor);
+	size_t i = 0;
+	for (; i + V::WIDTH <= n; i += V::WIDTH)
+		V::store(x + i, V::mul(V::load(x + i), f));
+	for (; i < n; i++)
+		x[i] *= factor;
+}
+
+template <typename T>
+void add(T* dst, T const * a, T const * b, size_t n)
+{
+	typedef Vec<T> V;
+	size_t i = 0;
+	for (; i + V::WIDTH <= n; i += V::WIDTH)
+		V::store(dst + i, V::add(V::load(a + i), V::load(b + i)));
+	for (; i < n; i++)
+		dst[i] = a[i] + b[i];
+}
+
+template <typename T>
+void axpy(T* y, T const * x, size_t n, T alpha)
+{
+	typedef Vec<T> V;
+	typename V::Reg a = V::set1(alpha);
+	size_t i = 0;
+	for (; i + V::WIDTH <= n; i += V::WIDTH)
+		V::store(y + i, V::add(V::load(y + i), V::mul(a, V::load(x + i))));
+	for (; i < n; i++)
+		y[i] += alpha * x[i];
+}
+
+// Four independent accumulators hide the latency of the vector adds
+template <typename T>
+T sum(T const * x, size_t n)
+{
+	typedef Vec<T> V;
+	typename V::Reg s0 = V::set1(T());
+	typename V::Reg s1 = s0;
+	typename V::Reg s2 = s0;
+	typename V::Reg s3 = s0;
+	size_t i = 0;
+	for (; i + 4 * V::WIDTH <= n; i += 4 * V::WIDTH)
+	{
+		s0 = V::add(s0, V::load(x + i));
+		s1 = V::add(s1, V::load(x + i + V::WIDTH));
+		s2 = V::add(s2, V::load(x + i + 2 * V::WIDTH));
+		s3 = V::add(s3, V::load(x + i + 3 * V::WIDTH));
+	}
+	for (; i + V::WIDTH <= n; i += V::WIDTH)
+		s0 = V::add(s0, V::load(x + i));
+	T total = reduceAdd<T>(V::add(V::add(s0, s1), V::add(s2, s3)));
+	for (; i < n; i++)
+		total += x[i];
+	return total;
+}
+
+// n > 0 (checked by the caller)
+template <typename T>
+T minValue(T const * x, size_t n)
+{
+	typedef Vec<T> V;
+	typename V::Reg m0 = V::set1(x[0]);
+	typename V::Reg m1 = m0;
+	size_t i = 0;
+	for (; i + 2 * V::WIDTH <= n; i += 2 * V::WIDTH)
+	{
+		m0 = V::min(m0, V::load(x + i));
+		m1 = V::min(m1, V::load(x + i + V::WIDTH));
+	}
+	T best = reduceMin<T>(V::min(m0, m1));
+	for (; i < n; i++)
+		best = (x[i] < best) ? x[i] : best;
+	return best;
+}
+
+template <typename T>
+T maxValue(T const * x, size_t n)
+{
+	typedef Vec<T> V;
+	typename V::Reg m0 = V::set1(x[0]);
+	typename V::Reg m1 = m0;
+	size_t i = 0;
+	for (; i + 2 * V::WIDTH <= n; i += 2 * V::WIDTH)
+	{
+		m0 = V::max(m0, V::load(x + i));
+		m1 = V::max(m1, V::load(x + i + V::WIDTH));
+	}
+	T best = reduceMax<T>(V::max(m0, m1));
+	for (; i < n; i++)
+		best = (best < x[i]) ? x[i] : best;
+	return best;
+}
@@ -0,0 +1,142 @@
+#ifndef KERNELS_HPP
+#define KERNELS_HPP
+
+#include <cstddef>
+#include <stdexcept>
+#include "Array.hpp"
+
+// Bulk operations over contiguous elements. int, float and double run
+// SSE2 or AVX2 kernels picked at runtime from the CPU's features; any other
+// element type (or a non-x86 build) uses the portable scalar loops.
+//   Kernels::fill(arr, 0.0f);
+//   Kernels::axpy(y, x, 2.0f);          // y[i] += 2 * x[i]
+//   float total = Kernels::sum(arr);
+// Floating-point reductions add in a different order than a plain loop, so
+// results may differ in the last bits. Integer overflow wraps in the SIMD
+// kernels and is undefined in the scalar path: keep int data in range.
+// min/max results are unspecified when the data holds NaN.
+namespace Kernels
+{
+	enum Level
+	{
+		SCALAR,
+		SSE2,
+		AVX2
+	};
+
+	// Best level the running CPU (and OS) supports
+	inline Level supportedLevel();
+
+	// Level used by the dispatcher, supportedLevel() unless changed.
+	// setLevel() clamps to what is supported; meant for tests and
+	// benchmarks, not to be called while kernels run on other threads.
+	inline Level level();
+	inline void setLevel(Level requested);
+	inline char const* levelName(Level l);
+
+	// Keeps the value parameters out of template argument deduction, so
+	// fill(floats, n, 0) deduces T = float from the pointer alone
+	template <typename T>
+	struct Value
+	{
+		typedef T Type;
+	};
+
+	// Element type of a view: ArrayView<float const> holds floats
+	template <typename T>
+	struct Element
+	{
+		typedef T Type;
+	};
+	template <typename T>
+	struct Element<T const>
+	{
+		typedef T Type;
+	};
+
+	// ==================== Raw ranges ====================
+
+	// dst[i] = value
+	template <typename T>
+	void fill(T* dst, size_t n, typename Value<T>::Type const & value);
+
+	// x[i] *= factor
+	template <typename T>
+	void scale(T* x, size_t n, typename Value<T>::Type const & factor);
+
+	// dst[i] = a[i] + b[i] (dst may be a or b)
+	template <typename T>
+	void add(T* dst, T const * a, T const * b, size_t n);
+
+	// y[i] += alpha * x[i]
+	template <typename T>
+	void axpy(T* y, T const * x, size_t n, typename Value<T>::Type const & alpha);
+
+	// dst[i] = func(src[i]) for arbitrary functors (scalar loop, left to the
+	// compiler's auto-vectorizer)
+	template <typename T, typename U, typename F>
+	void transform(U* dst, T const * src, size_t n, F func);
+
+	// Reductions. minValue/maxValue throw std::invalid_argument when n == 0.
+	template <typename T>
+	T sum(T const * x, size_t n);
+	template <typename T>
+	T minValue(T const * x, size_t n);
+	template <typename T>
+	T maxValue(T const * x, size_t n);
+
+	// ==================== Arrays ====================
+
+	// Element-wise operations on two or three arrays throw
+	// std::invalid_argument when the sizes differ.
+	template <typename T, typename A, typename B>
+	void fill(Array<T, A, B>& arr, typename Value<T>::Type const & value);
+	template <typename T, typename A, typename B>
+	void scale(Array<T, A, B>& arr, typename Value<T>::Type const & factor);
+	template <typename T, typename A, typename B>
+	void add(Array<T, A, B>& dst, Array<T, A, B> const & a, Array<T, A, B> const & b);
+	template <typename T, typename A, typename B>
+	void axpy(Array<T, A, B>& y, Array<T, A, B> const & x, typename Value<T>::Type const & alpha);
+	template <typename T, typename A, typename B>
+	T sum(Array<T, A, B> const & arr);
+	template <typename T, typename A, typename B>
+	T minValue(Array<T, A, B> const & arr);
+	template <typename T, typename A, typename B>
+	T maxValue(Array<T, A, B> const & arr);
+
+	// ==================== Views ====================
+
+	// Sub-ranges without copying: Arrays convert to read-only views
+	// implicitly, so a, b and x accept Arrays and views alike.
+	//   Kernels::scale(arr.slice(100, 200), 2.0f);
+	//   Kernels::add(out.slice(0, n), a.slice(0, n), b.slice(n, 2 * n));
+	// Size mismatches throw std::invalid_argument, as for Arrays.
+	template <typename T>
+	void fill(ArrayView<T> dst, typename Value<T>::Type const & value);
+	template <typename T>
+	void scale(ArrayView<T> x, typename Value<T>::Type const & factor);
+	template <typename T>
+	void add(ArrayView<T> dst, ArrayView<typename Value<T>::Type const> a,
+		ArrayView<typename Value<T>::Type const> b);
+	template <typename T>
+	void axpy(ArrayView<T> y, ArrayView<typename Value<T>::Type const> x,
+		typename Value<T>::Type const & alpha);
+	template <typename T>
+	typename Element<T>::Type sum(ArrayView<T> x);
+	template <typename T>
+	typename Element<T>::Type minValue(ArrayView<T> x);
+	template <typename T>
+	typename Element<T>::Type maxValue(ArrayView<T> x);
+
+	// Strided views are not contiguous: plain scalar loops
+	template <typename T>
+	void fill(StridedView<T> dst, typename Value<T>::Type const & value);
+	template <typename T>
+	void scale(StridedView<T> x, typename Value<T>::Type const & factor);
+	template <typename T>
+	typename Element<T>::Type sum(StridedView<T> x);
+}
+
+#include "Kernels.tpp"
+
+#endif
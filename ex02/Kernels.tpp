@@ -0,0 +1,504 @@
+#ifndef KERNELS_TPP
+#define KERNELS_TPP
+
+#include "Kernels.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+# define KERNELS_X86 1
+# include <immintrin.h>
+#else
+# define KERNELS_X86 0
+#endif
+
+// ==================== Portable scalar loops ====================
+
+namespace KernelsDetail
+{
+	namespace Scalar
+	{
+		template <typename T>
+		void fill(T* dst, size_t n, T const & value)
+		{
+			for (size_t i = 0; i < n; i++)
+				dst[i] = value;
+		}
+
+		template <typename T>
+		void scale(T* x, size_t n, T const & factor)
+		{
+			for (size_t i = 0; i < n; i++)
+				x[i] *= factor;
+		}
+
+		template <typename T>
+		void add(T* dst, T const * a, T const * b, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+				dst[i] = a[i] + b[i];
+		}
+
+		template <typename T>
+		void axpy(T* y, T const * x, size_t n, T const & alpha)
+		{
+			for (size_t i = 0; i < n; i++)
+				y[i] += alpha * x[i];
+		}
+
+		template <typename T>
+		T sum(T const * x, size_t n)
+		{
+			T total = T();
+			for (size_t i = 0; i < n; i++)
+				total += x[i];
+			return total;
+		}
+
+		template <typename T>
+		T minValue(T const * x, size_t n)
+		{
+			T best = x[0];
+			for (size_t i = 1; i < n; i++)
+				best = (x[i] < best) ? x[i] : best;
+			return best;
+		}
+
+		template <typename T>
+		T maxValue(T const * x, size_t n)
+		{
+			T best = x[0];
+			for (size_t i = 1; i < n; i++)
+				best = (best < x[i]) ? x[i] : best;
+			return best;
+		}
+	}
+}
+
+#if KERNELS_X86
+
+// ==================== SSE2 kernels (128-bit) ====================
+
+// Baseline on x86-64; the pragma only matters for 32-bit builds
+#pragma GCC push_options
+#pragma GCC target("sse2")
+
+namespace KernelsDetail
+{
+	namespace Sse2
+	{
+		template <typename T>
+		struct Vec;
+
+		template <>
+		struct Vec<float>
+		{
+			typedef __m128 Reg;
+			enum { WIDTH = 4 };
+			static Reg load(float const * p) { return _mm_loadu_ps(p); }
+			static void store(float* p, Reg r) { _mm_storeu_ps(p, r); }
+			static Reg set1(float v) { return _mm_set1_ps(v); }
+			static Reg add(Reg a, Reg b) { return _mm_add_ps(a, b); }
+			static Reg mul(Reg a, Reg b) { return _mm_mul_ps(a, b); }
+			static Reg min(Reg a, Reg b) { return _mm_min_ps(a, b); }
+			static Reg max(Reg a, Reg b) { return _mm_max_ps(a, b); }
+		};
+
+		template <>
+		struct Vec<double>
+		{
+			typedef __m128d Reg;
+			enum { WIDTH = 2 };
+			static Reg load(double const * p) { return _mm_loadu_pd(p); }
+			static void store(double* p, Reg r) { _mm_storeu_pd(p, r); }
+			static Reg set1(double v) { return _mm_set1_pd(v); }
+			static Reg add(Reg a, Reg b) { return _mm_add_pd(a, b); }
+			static Reg mul(Reg a, Reg b) { return _mm_mul_pd(a, b); }
+			static Reg min(Reg a, Reg b) { return _mm_min_pd(a, b); }
+			static Reg max(Reg a, Reg b) { return _mm_max_pd(a, b); }
+		};
+
+		// SSE2 has no 32-bit multiply-low nor signed 32-bit min/max (both
+		// arrived with SSE4.1): emulated with 64-bit multiplies and masks
+		template <>
+		struct Vec<int>
+		{
+			typedef __m128i Reg;
+			enum { WIDTH = 4 };
+			static Reg load(int const * p) { return _mm_loadu_si128(reinterpret_cast<Reg const *>(p)); }
+			static void store(int* p, Reg r) { _mm_storeu_si128(reinterpret_cast<Reg*>(p), r); }
+			static Reg set1(int v) { return _mm_set1_epi32(v); }
+			static Reg add(Reg a, Reg b) { return _mm_add_epi32(a, b); }
+			static Reg mul(Reg a, Reg b)
+			{
+				Reg even = _mm_mul_epu32(a, b);
+				Reg odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+				return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+					_mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+			}
+			static Reg min(Reg a, Reg b)
+			{
+				Reg greater = _mm_cmpgt_epi32(a, b);
+				return _mm_or_si128(_mm_and_si128(greater, b), _mm_andnot_si128(greater, a));
+			}
+			static Reg max(Reg a, Reg b)
+			{
+				Reg greater = _mm_cmpgt_epi32(a, b);
+				return _mm_or_si128(_mm_and_si128(greater, a), _mm_andnot_si128(greater, b));
+			}
+		};
+
+#include "KernelLoops.tpp"
+	}
+}
+
+#pragma GCC pop_options
+
+// ==================== AVX2 kernels (256-bit) ====================
+
+// Compiled for AVX2 whatever the build flags; only called once the CPU
+// check in supportedLevel() has passed
+#pragma GCC push_options
+#pragma GCC target("avx2")
+
+namespace KernelsDetail
+{
+	namespace Avx2
+	{
+		template <typename T>
+		struct Vec;
+
+		template <>
+		struct Vec<float>
+		{
+			typedef __m256 Reg;
+			enum { WIDTH = 8 };
+			static Reg load(float const * p) { return _mm256_loadu_ps(p); }
+			static void store(float* p, Reg r) { _mm256_storeu_ps(p, r); }
+			static Reg set1(float v) { return _mm256_set1_ps(v); }
+			static Reg add(Reg a, Reg b) { return _mm256_add_ps(a, b); }
+			static Reg mul(Reg a, Reg b) { return _mm256_mul_ps(a, b); }
+			static Reg min(Reg a, Reg b) { return _mm256_min_ps(a, b); }
+			static Reg max(Reg a, Reg b) { return _mm256_max_ps(a, b); }
+		};
+
+		template <>
+		struct Vec<double>
+		{
+			typedef __m256d Reg;
+			enum { WIDTH = 4 };
+			static Reg load(double const * p) { return _mm256_loadu_pd(p); }
+			static void store(double* p, Reg r) { _mm256_storeu_pd(p, r); }
+			static Reg set1(double v) { return _mm256_set1_pd(v); }
+			static Reg add(Reg a, Reg b) { return _mm256_add_pd(a, b); }
+			static Reg mul(Reg a, Reg b) { return _mm256_mul_pd(a, b); }
+			static Reg min(Reg a, Reg b) { return _mm256_min_pd(a, b); }
+			static Reg max(Reg a, Reg b) { return _mm256_max_pd(a, b); }
+		};
+
+		template <>
+		struct Vec<int>
+		{
+			typedef __m256i Reg;
+			enum { WIDTH = 8 };
+			static Reg load(int const * p) { return _mm256_loadu_si256(reinterpret_cast<Reg const *>(p)); }
+			static void store(int* p, Reg r) { _mm256_storeu_si256(reinterpret_cast<Reg*>(p), r); }
+			static Reg set1(int v) { return _mm256_set1_epi32(v); }
+			static Reg add(Reg a, Reg b) { return _mm256_add_epi32(a, b); }
+			static Reg mul(Reg a, Reg b) { return _mm256_mullo_epi32(a, b); }
+			static Reg min(Reg a, Reg b) { return _mm256_min_epi32(a, b); }
+			static Reg max(Reg a, Reg b) { return _mm256_max_epi32(a, b); }
+		};
+
+#include "KernelLoops.tpp"
+	}
+}
+
+#pragma GCC pop_options
+
+#endif // KERNELS_X86
+
+// ==================== Runtime dispatch ====================
+
+namespace KernelsDetail
+{
+	// Element types with SIMD kernels
+	template <typename T>
+	struct Simd
+	{
+		static bool const value = false;
+	};
+
+#if KERNELS_X86
+	template <> struct Simd<int> { static bool const value = true; };
+	template <> struct Simd<float> { static bool const value = true; };
+	template <> struct Simd<double> { static bool const value = true; };
+#endif
+
+	inline Kernels::Level& currentLevel()
+	{
+		static Kernels::Level current = Kernels::supportedLevel();
+		return current;
+	}
+
+	// Scalar loops for every other type
+	template <typename T, bool = Simd<T>::value>
+	struct Dispatch
+	{
+		static void fill(T* d, size_t n, T const & v) { Scalar::fill(d, n, v); }
+		static void scale(T* x, size_t n, T const & f) { Scalar::scale(x, n, f); }
+		static void add(T* d, T const * a, T const * b, size_t n) { Scalar::add(d, a, b, n); }
+		static void axpy(T* y, T const * x, size_t n, T const & a) { Scalar::axpy(y, x, n, a); }
+		static T sum(T const * x, size_t n) { return Scalar::sum(x, n); }
+		static T minValue(T const * x, size_t n) { return Scalar::minValue(x, n); }
+		static T maxValue(T const * x, size_t n) { return Scalar::maxValue(x, n); }
+	};
+
+#if KERNELS_X86
+	// One switch per call: negligible next to a bulk operation
+# define KERNELS_DISPATCH(call) \
+	switch (currentLevel()) \
+	{ \
+		case Kernels::AVX2: return Avx2::call; \
+		case Kernels::SSE2: return Sse2::call; \
+		default: return Scalar::call; \
+	}
+
+	template <typename T>
+	struct Dispatch<T, true>
+	{
+		static void fill(T* d, size_t n, T const & v) { KERNELS_DISPATCH(fill(d, n, v)) }
+		static void scale(T* x, size_t n, T const & f) { KERNELS_DISPATCH(scale(x, n, f)) }
+		static void add(T* d, T const * a, T const * b, size_t n) { KERNELS_DISPATCH(add(d, a, b, n)) }
+		static void axpy(T* y, T const * x, size_t n, T const & a) { KERNELS_DISPATCH(axpy(y, x, n, a)) }
+		static T sum(T const * x, size_t n) { KERNELS_DISPATCH(sum(x, n)) }
+		static T minValue(T const * x, size_t n) { KERNELS_DISPATCH(minValue(x, n)) }
+		static T maxValue(T const * x, size_t n) { KERNELS_DISPATCH(maxValue(x, n)) }
+	};
+
+# undef KERNELS_DISPATCH
+#endif
+
+	template <typename T, typename A, typename B>
+	void checkSameSize(Array<T, A, B> const & a, Array<T, A, B> const & b)
+	{
+		if (a.size() != b.size())
+			throw std::invalid_argument("Kernels: array sizes differ");
+	}
+
+	template <typename T, typename U>
+	void checkSameSize(ArrayView<T> a, ArrayView<U> b)
+	{
+		if (a.size() != b.size())
+			throw std::invalid_argument("Kernels: view sizes differ");
+	}
+}
+
+// ==================== Level selection ====================
+
+Kernels::Level Kernels::supportedLevel()
+{
+#if KERNELS_X86
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2"))
+		return AVX2;
+	if (__builtin_cpu_supports("sse2"))
+		return SSE2;
+#endif
+	return SCALAR;
+}
+
+Kernels::Level Kernels::level()
+{
+	return KernelsDetail::currentLevel();
+}
+
+void Kernels::setLevel(Level requested)
+{
+	Level supported = supportedLevel();
+	KernelsDetail::currentLevel() = (requested < supported) ? requested : supported;
+}
+
+char const* Kernels::levelName(Level l)
+{
+	switch (l)
+	{
+		case AVX2: return "AVX2";
+		case SSE2: return "SSE2";
+		default: return "scalar";
+	}
+}
+
+// ==================== Raw ranges ====================
+
+template <typename T>
+void Kernels::fill(T* dst, size_t n, typename Value<T>::Type const & value)
+{
+	KernelsDetail::Dispatch<T>::fill(dst, n, value);
+}
+
+template <typename T>
+void Kernels::scale(T* x, size_t n, typename Value<T>::Type const & factor)
+{
+	KernelsDetail::Dispatch<T>::scale(x, n, factor);
+}
+
+template <typename T>
+void Kernels::add(T* dst, T const * a, T const * b, size_t n)
+{
+	KernelsDetail::Dispatch<T>::add(dst, a, b, n);
+}
+
+template <typename T>
+void Kernels::axpy(T* y, T const * x, size_t n, typename Value<T>::Type const & alpha)
+{
+	KernelsDetail::Dispatch<T>::axpy(y, x, n, alpha);
+}
+
+template <typename T, typename U, typename F>
+void Kernels::transform(U* dst, T const * src, size_t n, F func)
+{
+	for (size_t i = 0; i < n; i++)
+		dst[i] = func(src[i]);
+}
+
+template <typename T>
+T Kernels::sum(T const * x, size_t n)
+{
+	return KernelsDetail::Dispatch<T>::sum(x, n);
+}
+
+template <typename T>
+T Kernels::minValue(T const * x, size_t n)
+{
+	if (n == 0)
+		throw std::invalid_argument("Kernels::minValue: empty range");
+	return KernelsDetail::Dispatch<T>::minValue(x, n);
+}
+
+template <typename T>
+T Kernels::maxValue(T const * x, size_t n)
+{
+	if (n == 0)
+		throw std::invalid_argument("Kernels::maxValue: empty range");
+	return KernelsDetail::Dispatch<T>::maxValue(x, n);
+}
+
+// ==================== Arrays ====================
+
+template <typename T, typename A, typename B>
+void Kernels::fill(Array<T, A, B>& arr, typename Value<T>::Type const & value)
+{
+	fill(arr.data(), arr.size(), value);
+}
+
+template <typename T, typename A, typename B>
+void Kernels::scale(Array<T, A, B>& arr, typename Value<T>::Type const & factor)
+{
+	scale(arr.data(), arr.size(), factor);
+}
+
+template <typename T, typename A, typename B>
+void Kernels::add(Array<T, A, B>& dst, Array<T, A, B> const & a, Array<T, A, B> const & b)
+{
+	KernelsDetail::checkSameSize(a, b);
+	KernelsDetail::checkSameSize(dst, a);
+	add(dst.data(), a.data(), b.data(), a.size());
+}
+
+template <typename T, typename A, typename B>
+void Kernels::axpy(Array<T, A, B>& y, Array<T, A, B> const & x, typename Value<T>::Type const & alpha)
+{
+	KernelsDetail::checkSameSize(y, x);
+	axpy(y.data(), x.data(), x.size(), alpha);
+}
+
+template <typename T, typename A, typename B>
+T Kernels::sum(Array<T, A, B> const & arr)
+{
+	return sum(arr.data(), arr.size());
+}
+
+template <typename T, typename A, typename B>
+T Kernels::minValue(Array<T, A, B> const & arr)
+{
+	return minValue(arr.data(), arr.size());
+}
+
+template <typename T, typename A, typename B>
+T Kernels::maxValue(Array<T, A, B> const & arr)
+{
+	return maxValue(arr.data(), arr.size());
+}
+
+// ==================== Views ====================
+
+template <typename T>
+void Kernels::fill(ArrayView<T> dst, typename Value<T>::Type const & value)
+{
+	fill(dst.data(), dst.size(), value);
+}
+
+template <typename T>
+void Kernels::scale(ArrayView<T> x, typename Value<T>::Type const & factor)
+{
+	scale(x.data(), x.size(), factor);
+}
+
+template <typename T>
+void Kernels::add(ArrayView<T> dst, ArrayView<typename Value<T>::Type const> a,
+	ArrayView<typename Value<T>::Type const> b)
+{
+	KernelsDetail::checkSameSize(a, b);
+	KernelsDetail::checkSameSize(dst, a);
+	add(dst.data(), a.data(), b.data(), a.size());
+}
+
+template <typename T>
+void Kernels::axpy(ArrayView<T> y, ArrayView<typename Value<T>::Type const> x,
+	typename Value<T>::Type const & alpha)
+{
+	KernelsDetail::checkSameSize(y, x);
+	axpy(y.data(), x.data(), x.size(), alpha);
+}
+
+template <typename T>
+typename Kernels::Element<T>::Type Kernels::sum(ArrayView<T> x)
+{
+	return sum(x.data(), x.size());
+}
+
+template <typename T>
+typename Kernels::Element<T>::Type Kernels::minValue(ArrayView<T> x)
+{
+	return minValue(x.data(), x.size());
+}
+
+template <typename T>
+typename Kernels::Element<T>::Type Kernels::maxValue(ArrayView<T> x)
+{
+	return maxValue(x.data(), x.size());
+}
+
+template <typename T>
+void Kernels::fill(StridedView<T> dst, typename Value<T>::Type const & value)
+{
+	for (size_t i = 0; i < dst.size(); i++)
+		dst[i] = value;
+}
+
+template <typename T>
+void Kernels::scale(StridedView<T> x, typename Value<T>::Type const & factor)
+{
+	for (size_t i = 0; i < x.size(); i++)
+		x[i] *= factor;
+}
+
+template <typename T>
+typename Kernels::Element<T>::Type Kernels::sum(StridedView<T> x)
+{
+	typename Element<T>::Type total = typename Element<T>::Type();
+	for (size_t i = 0; i < x.size(); i++)
+		total += x[i];
+	return total;
+}
+
+#endif
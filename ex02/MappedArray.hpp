@@ -0,0 +1,109 @@
+#ifndef MAPPEDARRAY_HPP
+#define MAPPEDARRAY_HPP
+
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <cstddef>
+#include "TypeTraits.hpp"
+#include "Bounds.hpp"
+
+// Array view of a binary file mapped with mmap(): the file holds the raw
+// elements back to back, construction is O(1) and pages are read from the
+// page cache on first access. T must be trivially copyable.
+//   MappedArray<float> samples("samples.bin");             // read-only
+//   MappedArray<int> scratch("ids.bin", MappedArray<int>::COPY_ON_WRITE);
+// READ_ONLY maps the pages PROT_READ: writing through the non-const
+// accessors faults. COPY_ON_WRITE gives private, writable pages whose
+// changes are never written back to the file.
+template <typename T, typename Bounds = ARRAY_DEFAULT_BOUNDS>
+class MappedArray
+{
+	public:
+		enum Mode
+		{
+			READ_ONLY,
+			COPY_ON_WRITE
+		};
+
+		// Access pattern hints forwarded to madvise()
+		enum Access
+		{
+			NORMAL,
+			SEQUENTIAL,			// Aggressive read-ahead, pages dropped after use
+			RANDOM,				// No read-ahead
+			WILL_NEED,			// Start reading the pages in now
+			DONT_NEED			// Pages may be dropped and re-read from the file
+								// (discards copy-on-write changes; only pages
+								// wholly inside the range are dropped)
+		};
+
+	private:
+		T*				_array;
+		size_t			_size;
+		void*			_mapping;		// Start of the mapping (page aligned)
+		size_t			_mappedBytes;
+		Mode			_mode;
+
+		MappedArray(MappedArray const & src);			// Non-copyable
+		MappedArray& operator=(MappedArray const & rhs);
+
+		void	unmap();
+
+	public:
+		MappedArray();
+		// Maps the elements stored from byte `offset` to the end of the file.
+		// offset must be a multiple of the alignment of T.
+		explicit MappedArray(std::string const & path, Mode mode = READ_ONLY, size_t offset = 0);
+		~MappedArray();
+
+#if __cplusplus >= 201103L
+		MappedArray(MappedArray&& src) noexcept;
+		MappedArray& operator=(MappedArray&& rhs) noexcept;
+#endif
+
+		void swap(MappedArray& other) throw();
+
+		// Same access API as Array
+		T& operator[](size_t index);
+		T const & operator[](size_t index) const;
+		T& at(size_t index);
+		T const & at(size_t index) const;
+		T* data();
+		T const * data() const;
+		T* begin();
+		T const * begin() const;
+		T* end();
+		T const * end() const;
+		size_t size() const;
+		bool empty() const;
+
+		Mode mode() const;
+
+		// Hint for the whole array, or for `count` elements from `first`
+		void advise(Access access);
+		void advise(Access access, size_t first, size_t count);
+
+		class OutOfBoundsException : public std::exception
+		{
+			public:
+				virtual const char* what() const throw()
+				{
+					return "Error: Index out of bounds";
+				}
+		};
+
+		// open/fstat/mmap failure or a file that does not hold whole elements
+		class MapException : public std::runtime_error
+		{
+			public:
+				explicit MapException(std::string const & message) : std::runtime_error(message) {}
+		};
+};
+
+template <typename T, typename Bounds>
+void swap(MappedArray<T, Bounds>& a, MappedArray<T, Bounds>& b) throw();
+
+#include "MappedArray.tpp"
+
+#endif
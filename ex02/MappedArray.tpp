@@ -0,0 +1,278 @@
+#ifndef MAPPEDARRAY_TPP
+#define MAPPEDARRAY_TPP
+
+#include "MappedArray.hpp"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+
+// ==================== Mapping ====================
+
+template <typename T, typename Bounds>
+MappedArray<T, Bounds>::MappedArray()
+	: _array(NULL), _size(0), _mapping(NULL), _mappedBytes(0), _mode(READ_ONLY)
+{
+}
+
+// The mapping starts at the page holding `offset`; the descriptor is closed
+// right away (the mapping keeps the file alive). An empty range maps nothing.
+template <typename T, typename Bounds>
+MappedArray<T, Bounds>::MappedArray(std::string const & path, Mode mode, size_t offset)
+	: _array(NULL), _size(0), _mapping(NULL), _mappedBytes(0), _mode(mode)
+{
+	// Elements are used in place: rejected at compile time unless bitwise
+	typedef char RequiresTriviallyCopyable[TypeTraits<T>::trivialCopy ? 1 : -1];
+	(void)sizeof(RequiresTriviallyCopyable);
+
+	int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+		throw MapException(path + ": " + std::strerror(errno));
+
+	struct stat info;
+	if (::fstat(fd, &info) != 0)
+	{
+		int error = errno;
+		::close(fd);
+		throw MapException(path + ": " + std::strerror(error));
+	}
+
+	size_t fileSize = static_cast<size_t>(info.st_size);
+	char const * problem = NULL;
+	if (offset > fileSize || offset % __alignof__(T) != 0)
+		problem = "offset outside the file or misaligned for the element type";
+	else if ((fileSize - offset) % sizeof(T) != 0)
+		problem = "file does not hold a whole number of elements";
+	if (problem != NULL)
+	{
+		::close(fd);
+		throw MapException(path + ": " + problem);
+	}
+
+	size_t bytes = fileSize - offset;
+	if (bytes > 0)
+	{
+		size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+		size_t start = offset - offset % page;
+		int protection = (mode == READ_ONLY) ? PROT_READ : (PROT_READ | PROT_WRITE);
+		void* mapping = ::mmap(NULL, fileSize - start, protection, MAP_PRIVATE, fd, static_cast<off_t>(start));
+		if (mapping == MAP_FAILED)
+		{
+			int error = errno;
+			::close(fd);
+			throw MapException(path + ": " + std::strerror(error));
+		}
+		_mapping = mapping;
+		_mappedBytes = fileSize - start;
+		_array = reinterpret_cast<T*>(static_cast<char*>(mapping) + (offset - start));
+		_size = bytes / sizeof(T);
+	}
+	::close(fd);
+}
+
+template <typename T, typename Bounds>
+void MappedArray<T, Bounds>::unmap()
+{
+	if (_mapping != NULL)
+		::munmap(_mapping, _mappedBytes);
+	_array = NULL;
+	_size = 0;
+	_mapping = NULL;
+	_mappedBytes = 0;
+}
+
+template <typename T, typename Bounds>
+MappedArray<T, Bounds>::~MappedArray()
+{
+	unmap();
+}
+
+#if __cplusplus >= 201103L
+template <typename T, typename Bounds>
+MappedArray<T, Bounds>::MappedArray(MappedArray&& src) noexcept
+	: _array(NULL), _size(0), _mapping(NULL), _mappedBytes(0), _mode(READ_ONLY)
+{
+	swap(src);
+}
+
+template <typename T, typename Bounds>
+MappedArray<T, Bounds>& MappedArray<T, Bounds>::operator=(MappedArray&& rhs) noexcept
+{
+	if (this != &rhs)
+	{
+		unmap();
+		swap(rhs);
+	}
+	return *this;
+}
+#endif
+
+template <typename T, typename Bounds>
+void MappedArray<T, Bounds>::swap(MappedArray& other) throw()
+{
+	T* tmpArray = _array;
+	_array = other._array;
+	other._array = tmpArray;
+
+	size_t tmpSize = _size;
+	_size = other._size;
+	other._size = tmpSize;
+
+	void* tmpMapping = _mapping;
+	_mapping = other._mapping;
+	other._mapping = tmpMapping;
+
+	size_t tmpBytes = _mappedBytes;
+	_mappedBytes = other._mappedBytes;
+	other._mappedBytes = tmpBytes;
+
+	Mode tmpMode = _mode;
+	_mode = other._mode;
+	other._mode = tmpMode;
+}
+
+template <typename T, typename Bounds>
+void swap(MappedArray<T, Bounds>& a, MappedArray<T, Bounds>& b) throw()
+{
+	a.swap(b);
+}
+
+// ==================== Element access ====================
+
+template <typename T, typename Bounds>
+T& MappedArray<T, Bounds>::operator[](size_t index)
+{
+	if (Bounds::outOfRange(index, _size))
+		throw OutOfBoundsException();
+	return _array[index];
+}
+
+template <typename T, typename Bounds>
+T const & MappedArray<T, Bounds>::operator[](size_t index) const
+{
+	if (Bounds::outOfRange(index, _size))
+		throw OutOfBoundsException();
+	return _array[index];
+}
+
+template <typename T, typename Bounds>
+T& MappedArray<T, Bounds>::at(size_t index)
+{
+	if (index >= _size)
+		throw OutOfBoundsException();
+	return _array[index];
+}
+
+template <typename T, typename Bounds>
+T const & MappedArray<T, Bounds>::at(size_t index) const
+{
+	if (index >= _size)
+		throw OutOfBoundsException();
+	return _array[index];
+}
+
+template <typename T, typename Bounds>
+T* MappedArray<T, Bounds>::data()
+{
+	return _array;
+}
+
+template <typename T, typename Bounds>
+T const * MappedArray<T, Bounds>::data() const
+{
+	return _array;
+}
+
+template <typename T, typename Bounds>
+T* MappedArray<T, Bounds>::begin()
+{
+	return _array;
+}
+
+template <typename T, typename Bounds>
+T const * MappedArray<T, Bounds>::begin() const
+{
+	return _array;
+}
+
+template <typename T, typename Bounds>
+T* MappedArray<T, Bounds>::end()
+{
+	return _array + _size;
+}
+
+template <typename T, typename Bounds>
+T const * MappedArray<T, Bounds>::end() const
+{
+	return _array + _size;
+}
+
+template <typename T, typename Bounds>
+size_t MappedArray<T, Bounds>::size() const
+{
+	return _size;
+}
+
+template <typename T, typename Bounds>
+bool MappedArray<T, Bounds>::empty() const
+{
+	return _size == 0;
+}
+
+template <typename T, typename Bounds>
+typename MappedArray<T, Bounds>::Mode MappedArray<T, Bounds>::mode() const
+{
+	return _mode;
+}
+
+// ==================== Access hints ====================
+
+template <typename T, typename Bounds>
+void MappedArray<T, Bounds>::advise(Access access)
+{
+	advise(access, 0, _size);
+}
+
+// madvise() works on whole pages: the range is widened to page boundaries,
+// except for DONT_NEED, which would drop the neighbouring elements' private
+// changes too. That one is narrowed to the pages inside the range (the
+// array's own ends still count as boundaries) and skipped if none is.
+// Hints are best effort, failures are ignored.
+template <typename T, typename Bounds>
+void MappedArray<T, Bounds>::advise(Access access, size_t first, size_t count)
+{
+	if (first >= _size || count == 0)
+		return;
+	if (count > _size - first)
+		count = _size - first;
+
+	int advice = MADV_NORMAL;
+	switch (access)
+	{
+		case SEQUENTIAL: advice = MADV_SEQUENTIAL; break;
+		case RANDOM: advice = MADV_RANDOM; break;
+		case WILL_NEED: advice = MADV_WILLNEED; break;
+		case DONT_NEED: advice = MADV_DONTNEED; break;
+		default: break;
+	}
+
+	size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+	size_t begin = reinterpret_cast<size_t>(_array + first);
+	size_t end = reinterpret_cast<size_t>(_array + first + count);
+	if (access == DONT_NEED)
+	{
+		if (first != 0)
+			begin += (page - begin % page) % page;
+		if (first + count != _size)
+			end -= end % page;
+		if (begin >= end)
+			return;
+	}
+	else
+		begin -= begin % page;
+	::madvise(reinterpret_cast<void*>(begin), end - begin, advice);
+}
+
+#endif
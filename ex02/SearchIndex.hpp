@@ -0,0 +1,75 @@
+#ifndef SEARCHINDEX_HPP
+#define SEARCHINDEX_HPP
+
+#include <cstddef>
+#include "Array.hpp"
+#include "Allocator.hpp"
+#include "Sort.hpp"
+
+// Read-only search index over a sorted array of arithmetic keys, laid out
+// for the cache instead of for binary search.
+//   SearchIndex<int> index(sorted);          // copies the keys once
+//   size_t i = index.lower_bound(42);         // same answer as ::lower_bound(sorted, 42)
+//   index.contains(42);
+//   index.lower_bound(queries, out);          // out[i] = lower_bound(queries[i])
+//
+// Layout: a static B+ tree (S+ tree) stored as flat arrays, no pointers.
+// Every node is one 64-byte cache line of NODE_KEYS keys (16 ints, 8
+// doubles...) with NODE_KEYS + 1 implicit children: child j of node k is
+// node k * (NODE_KEYS + 1) + j of the layer below. The bottom layer holds
+// all the keys in sorted order, so the leaf position reached is the index
+// into the original array; the upper layers hold, for each child but the
+// first, the smallest key below it. A lookup reads one line per layer
+// (log17 n for ints, against log2 n scattered reads for binary search)
+// and ranks the query inside a node with vector compares and no branch.
+// Batched lookups walk up to BATCH queries down the tree together,
+// prefetching each next node, so their cache misses overlap.
+//
+// Nodes are padded with +infinity (or the largest value of T): 1/16 more
+// memory than the array for ints. Results are unspecified with NaN.
+namespace SearchIndexDetail
+{
+	size_t const NODE_BYTES = 64;
+	size_t const BATCH = 16;
+}
+
+template <typename T>
+class SearchIndex
+{
+	public:
+		static size_t const NODE_KEYS = SearchIndexDetail::NODE_BYTES / sizeof(T);
+		static size_t const MAX_LAYERS = sizeof(size_t) * 8;
+
+	private:
+		typedef Array<T, AlignedAllocator<SearchIndexDetail::NODE_BYTES> > Storage;
+
+		Storage		_keys;					// All layers, root first
+		size_t		_size;
+		size_t		_layers;
+		size_t		_offset[MAX_LAYERS];	// Of each layer in _keys; 0 is the leaves
+
+		static T padding();
+		static size_t rank(T const * node, T const & value);
+
+		T const * node(size_t layer, size_t k) const;
+
+	public:
+		// Throws std::invalid_argument when the keys are not sorted
+		explicit SearchIndex(ArrayView<T const> sorted);
+
+		size_t size() const;
+		bool empty() const;
+		size_t bytes() const;	// Memory held by the index
+
+		// First index i with !(sorted[i] < value), size() when none
+		size_t lower_bound(T const & value) const;
+		bool contains(T const & value) const;
+
+		// out[i] = lower_bound(queries[i]); throws std::invalid_argument when
+		// out is shorter than queries
+		void lower_bound(ArrayView<T const> queries, ArrayView<size_t> out) const;
+};
+
+#include "SearchIndex.tpp"
+
+#endif
@@ -0,0 +1,190 @@
+#ifndef SEARCHINDEX_TPP
+#define SEARCHINDEX_TPP
+
+#include "SearchIndex.hpp"
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+template <typename T>
+size_t const SearchIndex<T>::NODE_KEYS;
+template <typename T>
+size_t const SearchIndex<T>::MAX_LAYERS;
+
+namespace SearchIndexDetail
+{
+	// Signed integer lane of a given width: vector compares yield 0 / -1 in it
+	template <size_t Bytes> struct SignedLane;
+	template <> struct SignedLane<1> { typedef signed char Type; };
+	template <> struct SignedLane<2> { typedef short Type; };
+	template <> struct SignedLane<4> { typedef int Type; };
+	template <> struct SignedLane<8> { typedef long long Type; };
+}
+
+// ==================== Nodes ====================
+
+template <typename T>
+T SearchIndex<T>::padding()
+{
+	return std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity()
+		: std::numeric_limits<T>::max();
+}
+
+// Number of keys in the node less than value. Each compare leaves -1 in
+// the matching lanes; the masks are summed lane-wise, then across.
+template <typename T>
+size_t SearchIndex<T>::rank(T const * node, T const & value)
+{
+	typedef char RequiresArithmeticKeys[WhateverDetail::Simd<T>::value ? 1 : -1];
+	(void)sizeof(RequiresArithmeticKeys);
+	typedef WhateverDetail::Lanes<T> L;
+	typedef typename SearchIndexDetail::SignedLane<sizeof(T)>::Type Lane;
+	typedef typename WhateverDetail::Lanes<Lane>::Reg Mask;
+	size_t const REGS = SearchIndexDetail::NODE_BYTES / WhateverDetail::VECTOR_BYTES;
+
+	typename L::Reg const x = L::splat(value);
+	Mask sum = (Mask)(L::load(node) < x);
+	for (size_t r = 1; r < REGS; r++)
+		sum += (Mask)(L::load(node + r * L::WIDTH) < x);
+	Lane lanes[L::WIDTH];
+	std::memcpy(lanes, &sum, sizeof(lanes));
+	long total = 0;
+	for (size_t k = 0; k < L::WIDTH; k++)
+		total += lanes[k];
+	return static_cast<size_t>(-total);
+}
+
+template <typename T>
+T const * SearchIndex<T>::node(size_t layer, size_t k) const
+{
+	return _keys.data() + _offset[layer] + k * NODE_KEYS;
+}
+
+// ==================== Construction ====================
+
+// Layer sizes bottom-up, then offsets top-down so the root comes first.
+// Separator j of node k on layer h is the first key under its child
+// k * (NODE_KEYS + 1) + j + 1, found by following first children down to
+// the leaves; separators of missing children are padding.
+template <typename T>
+SearchIndex<T>::SearchIndex(ArrayView<T const> sorted) : _keys(), _size(sorted.size()), _layers(0)
+{
+	if (!::is_sorted(sorted))
+		throw std::invalid_argument("SearchIndex: keys are not sorted");
+
+	size_t nodes[MAX_LAYERS];
+	nodes[0] = (_size + NODE_KEYS - 1) / NODE_KEYS;
+	_layers = 1;
+	while (nodes[_layers - 1] > 1)
+	{
+		nodes[_layers] = (nodes[_layers - 1] + NODE_KEYS) / (NODE_KEYS + 1);
+		_layers++;
+	}
+	size_t total = 0;
+	for (size_t h = _layers; h-- > 0;)
+	{
+		_offset[h] = total;
+		total += nodes[h] * NODE_KEYS;
+	}
+	_keys.resize(total, uninitialized);
+
+	T const pad = padding();
+	T* leaves = _keys.data() + _offset[0];
+	for (size_t i = 0; i < nodes[0] * NODE_KEYS; i++)
+		leaves[i] = (i < _size) ? sorted[i] : pad;
+	size_t span = NODE_KEYS;	// Keys under one node of the layer below
+	for (size_t h = 1; h < _layers; h++)
+	{
+		T* keys = _keys.data() + _offset[h];
+		for (size_t k = 0; k < nodes[h]; k++)
+		{
+			for (size_t j = 0; j < NODE_KEYS; j++)
+			{
+				size_t first = (k * (NODE_KEYS + 1) + j + 1) * span;
+				keys[k * NODE_KEYS + j] = (first < _size) ? sorted[first] : pad;
+			}
+		}
+		span *= NODE_KEYS + 1;
+	}
+}
+
+// ==================== Queries ====================
+
+template <typename T>
+size_t SearchIndex<T>::size() const
+{
+	return _size;
+}
+
+template <typename T>
+bool SearchIndex<T>::empty() const
+{
+	return _size == 0;
+}
+
+template <typename T>
+size_t SearchIndex<T>::bytes() const
+{
+	return _keys.size() * sizeof(T);
+}
+
+// The rank in a node never counts padding, so the path stays on existing
+// nodes; a rank of NODE_KEYS at a leaf lands on the first key of the next
+// leaf, which is where the answer is.
+template <typename T>
+size_t SearchIndex<T>::lower_bound(T const & value) const
+{
+	if (_size == 0)
+		return 0;
+	size_t k = 0;
+	for (size_t h = _layers - 1; h > 0; h--)
+		k = k * (NODE_KEYS + 1) + rank(node(h, k), value);
+	size_t i = k * NODE_KEYS + rank(node(0, k), value);
+	return (i < _size) ? i : _size;
+}
+
+template <typename T>
+bool SearchIndex<T>::contains(T const & value) const
+{
+	size_t i = lower_bound(value);
+	return i < _size && !(value < node(0, 0)[i]);
+}
+
+// One layer at a time for the whole batch: the node of query q + 1 is
+// ranked while the prefetch of query q's next node is in flight
+template <typename T>
+void SearchIndex<T>::lower_bound(ArrayView<T const> queries, ArrayView<size_t> out) const
+{
+	if (out.size() < queries.size())
+		throw std::invalid_argument("SearchIndex: output shorter than queries");
+	size_t const BATCH = SearchIndexDetail::BATCH;
+	size_t k[BATCH];
+	for (size_t start = 0; start < queries.size(); start += BATCH)
+	{
+		T const * q = queries.data() + start;
+		size_t const m = (queries.size() - start < BATCH) ? queries.size() - start : BATCH;
+		if (_size == 0)
+		{
+			for (size_t i = 0; i < m; i++)
+				out[start + i] = 0;
+			continue;
+		}
+		for (size_t i = 0; i < m; i++)
+			k[i] = 0;
+		for (size_t h = _layers - 1; h > 0; h--)
+		{
+			for (size_t i = 0; i < m; i++)
+			{
+				k[i] = k[i] * (NODE_KEYS + 1) + rank(node(h, k[i]), q[i]);
+				__builtin_prefetch(node(h - 1, k[i]));
+			}
+		}
+		for (size_t i = 0; i < m; i++)
+		{
+			size_t index = k[i] * NODE_KEYS + rank(node(0, k[i]), q[i]);
+			out[start + i] = (index < _size) ? index : _size;
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,168 @@
+#ifndef SERIALIZE_HPP
+#define SERIALIZE_HPP
+
+#include <stdint.h>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <iostream>
+#include "Array.hpp"
+
+// Binary format for arrays of trivially copyable T:
+//
+//   offset  size  field
+//        0     4  magic "A07\0"
+//        4     2  format version (SERIAL_VERSION)
+//        6     1  byte order of every field and element ('L' or 'B')
+//        7     1  header size in bytes (64: elements start 64-byte aligned)
+//        8     4  sizeof(T)
+//       12     4  element type code (SerialType<T>, 0 = opaque struct)
+//       16     8  element count
+//       24    40  reserved, zero
+//       64     -  count * sizeof(T) bytes of raw elements
+//
+// Files are written in the host's byte order. Readers byte-swap arithmetic
+// element types written on a machine of the other endianness; opaque types
+// (and the zero-copy view) require a matching byte order.
+//
+//   saveArray("data.bin", arr);                     // one writev() call
+//   loadArray("data.bin", arr);                     // one bulk read
+//   MappedArray<unsigned char> file("data.bin");    // no copy at all:
+//   SerializedView<float> view(file.data(), file.size());
+
+uint16_t const SERIAL_VERSION = 1;
+size_t const SERIAL_HEADER_SIZE = 64;
+
+// Element type codes stored in the header
+template <typename T> struct SerialType { static uint32_t const code = 0; };
+template <> struct SerialType<int8_t> { static uint32_t const code = 1; };
+template <> struct SerialType<uint8_t> { static uint32_t const code = 2; };
+template <> struct SerialType<int16_t> { static uint32_t const code = 3; };
+template <> struct SerialType<uint16_t> { static uint32_t const code = 4; };
+template <> struct SerialType<int32_t> { static uint32_t const code = 5; };
+template <> struct SerialType<uint32_t> { static uint32_t const code = 6; };
+template <> struct SerialType<int64_t> { static uint32_t const code = 7; };
+template <> struct SerialType<uint64_t> { static uint32_t const code = 8; };
+template <> struct SerialType<float> { static uint32_t const code = 9; };
+template <> struct SerialType<double> { static uint32_t const code = 10; };
+
+// Decoded header fields (host byte order)
+struct SerialHeader
+{
+	uint16_t	version;
+	bool		swapped;		// Stored in the other byte order
+	uint32_t	elementSize;
+	uint32_t	typeCode;
+	uint64_t	count;
+};
+
+// Malformed input, version or type mismatch, or an I/O error
+class SerializeException : public std::runtime_error
+{
+	public:
+		explicit SerializeException(std::string const & message) : std::runtime_error(message) {}
+};
+
+// Header encoding and checking shared by every reader and writer
+namespace SerialDetail
+{
+	inline void encodeHeader(unsigned char* out, uint32_t elementSize, uint32_t typeCode, uint64_t count);
+
+	// Validates the header in `bytes` for element type (size, code) and
+	// returns its fields; throws SerializeException
+	inline SerialHeader decodeHeader(unsigned char const * bytes, size_t available,
+		uint32_t elementSize, uint32_t typeCode);
+
+	// Reverses the byte order of n elements of `size` bytes each
+	inline void byteSwap(void* data, size_t n, size_t size);
+}
+
+// ==================== Whole arrays ====================
+
+// Header and elements, written to a stream or a file (single writev())
+template <typename T, typename A, typename B>
+void serialize(std::ostream& out, Array<T, A, B> const & arr);
+template <typename T, typename A, typename B>
+void saveArray(std::string const & path, Array<T, A, B> const & arr);
+
+// Replaces the contents of `arr` (bulk read into uninitialized storage).
+// A count larger than the input is rejected without being allocated.
+template <typename T, typename A, typename B>
+void deserialize(std::istream& in, Array<T, A, B>& arr);
+template <typename T, typename A, typename B>
+void loadArray(std::string const & path, Array<T, A, B>& arr);
+
+// ==================== Zero-copy view ====================
+
+// Read-only array over a serialized buffer (mapped file, network buffer):
+// validates the header, then points straight into the payload. The buffer
+// must outlive the view, be in host byte order, and the payload must be
+// aligned for T (it is whenever the buffer itself is 64-byte aligned).
+template <typename T>
+class SerializedView
+{
+	private:
+		T const *		_array;
+		size_t			_size;
+
+	public:
+		SerializedView();
+		SerializedView(void const * buffer, size_t bytes);
+
+		T const & operator[](size_t index) const;		// Always checked
+		T const * data() const;
+		T const * begin() const;
+		T const * end() const;
+		size_t size() const;
+};
+
+// ==================== Streaming ====================
+
+// Writes an array of unknown final size chunk by chunk; the element count
+// in the header is patched by finish() (the stream must be seekable)
+template <typename T>
+class ArrayWriter
+{
+	private:
+		std::ostream&	_out;
+		std::streampos	_start;
+		uint64_t		_count;
+		bool			_finished;
+
+		ArrayWriter(ArrayWriter const & src);			// Non-copyable
+		ArrayWriter& operator=(ArrayWriter const & rhs);
+
+	public:
+		explicit ArrayWriter(std::ostream& out);
+		~ArrayWriter();								// Calls finish() if needed
+
+		void write(T const * elements, size_t n);
+		uint64_t count() const;
+		void finish();
+};
+
+// Reads a serialized array chunk by chunk, byte-swapping when needed
+template <typename T>
+class ArrayReader
+{
+	private:
+		std::istream&	_in;
+		SerialHeader	_header;
+		uint64_t		_remaining;
+
+		ArrayReader(ArrayReader const & src);			// Non-copyable
+		ArrayReader& operator=(ArrayReader const & rhs);
+
+	public:
+		explicit ArrayReader(std::istream& in);
+
+		// Reads up to max elements into dst, returns how many were read
+		size_t read(T* dst, size_t max);
+		uint64_t count() const;
+		uint64_t remaining() const;
+		SerialHeader const & header() const;
+};
+
+#include "Serialize.tpp"
+
+#endif
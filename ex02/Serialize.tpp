@@ -0,0 +1,424 @@
+#ifndef SERIALIZE_TPP
+#define SERIALIZE_TPP
+
+#include "Serialize.hpp"
+#include <sys/uio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+
+// ==================== Header ====================
+
+namespace SerialDetail
+{
+	unsigned char const MAGIC[4] = {'A', '0', '7', '\0'};
+
+	inline char hostOrder()
+	{
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+		return 'B';
+#else
+		return 'L';
+#endif
+	}
+
+	// Elements are used as raw bytes: rejected at compile time unless bitwise
+	template <typename T>
+	void requireTriviallyCopyable()
+	{
+		typedef char RequiresTriviallyCopyable[TypeTraits<T>::trivialCopy ? 1 : -1];
+		(void)sizeof(RequiresTriviallyCopyable);
+	}
+
+	void encodeHeader(unsigned char* out, uint32_t elementSize, uint32_t typeCode, uint64_t count)
+	{
+		uint16_t version = SERIAL_VERSION;
+		std::memset(out, 0, SERIAL_HEADER_SIZE);
+		std::memcpy(out, MAGIC, 4);
+		std::memcpy(out + 4, &version, 2);
+		out[6] = static_cast<unsigned char>(hostOrder());
+		out[7] = static_cast<unsigned char>(SERIAL_HEADER_SIZE);
+		std::memcpy(out + 8, &elementSize, 4);
+		std::memcpy(out + 12, &typeCode, 4);
+		std::memcpy(out + 16, &count, 8);
+	}
+
+	SerialHeader decodeHeader(unsigned char const * bytes, size_t available,
+		uint32_t elementSize, uint32_t typeCode)
+	{
+		if (available < SERIAL_HEADER_SIZE || std::memcmp(bytes, MAGIC, 4) != 0)
+			throw SerializeException("Serialize: not a serialized array");
+		if (bytes[6] != 'L' && bytes[6] != 'B')
+			throw SerializeException("Serialize: unknown byte order");
+
+		SerialHeader header;
+		header.swapped = (bytes[6] != hostOrder());
+		std::memcpy(&header.version, bytes + 4, 2);
+		std::memcpy(&header.elementSize, bytes + 8, 4);
+		std::memcpy(&header.typeCode, bytes + 12, 4);
+		std::memcpy(&header.count, bytes + 16, 8);
+		if (header.swapped)
+		{
+			header.version = __builtin_bswap16(header.version);
+			header.elementSize = __builtin_bswap32(header.elementSize);
+			header.typeCode = __builtin_bswap32(header.typeCode);
+			header.count = __builtin_bswap64(header.count);
+		}
+
+		if (header.version == 0 || header.version > SERIAL_VERSION)
+			throw SerializeException("Serialize: unsupported format version");
+		if (bytes[7] != SERIAL_HEADER_SIZE)
+			throw SerializeException("Serialize: unexpected header size");
+		if (header.elementSize != elementSize || header.typeCode != typeCode)
+			throw SerializeException("Serialize: element type mismatch");
+		if (header.swapped && typeCode == 0 && elementSize > 1)
+			throw SerializeException("Serialize: cannot byte-swap an opaque element type");
+		return header;
+	}
+
+	void byteSwap(void* data, size_t n, size_t size)
+	{
+		unsigned char* bytes = static_cast<unsigned char*>(data);
+		for (size_t i = 0; i < n; i++, bytes += size)
+		{
+			if (size == 2)
+			{
+				uint16_t v;
+				std::memcpy(&v, bytes, 2);
+				v = __builtin_bswap16(v);
+				std::memcpy(bytes, &v, 2);
+			}
+			else if (size == 4)
+			{
+				uint32_t v;
+				std::memcpy(&v, bytes, 4);
+				v = __builtin_bswap32(v);
+				std::memcpy(bytes, &v, 4);
+			}
+			else if (size == 8)
+			{
+				uint64_t v;
+				std::memcpy(&v, bytes, 8);
+				v = __builtin_bswap64(v);
+				std::memcpy(bytes, &v, 8);
+			}
+		}
+	}
+
+	// Reads exactly `bytes` bytes or throws
+	inline void readExactly(std::istream& in, void* dst, size_t bytes)
+	{
+		in.read(static_cast<char*>(dst), static_cast<std::streamsize>(bytes));
+		if (static_cast<size_t>(in.gcount()) != bytes)
+			throw SerializeException("Serialize: truncated input");
+	}
+
+	template <typename T>
+	SerialHeader readHeader(std::istream& in)
+	{
+		unsigned char bytes[SERIAL_HEADER_SIZE];
+		readExactly(in, bytes, SERIAL_HEADER_SIZE);
+		return decodeHeader(bytes, SERIAL_HEADER_SIZE, sizeof(T), SerialType<T>::code);
+	}
+
+	// Must fit an Array<T> (see Array::max_size())
+	template <typename T>
+	void checkCount(uint64_t count)
+	{
+		if (count > static_cast<size_t>(-1) / 2 / sizeof(T))
+			throw SerializeException("Serialize: too many elements for an Array");
+	}
+
+	// Payload read per step when the stream length is unknown
+	size_t const READ_CHUNK = 1u << 20;
+
+	// Bytes between the read position and the end of the stream, or -1
+	// when it cannot seek (pipes, sockets); the position is left unchanged
+	inline std::streamoff bytesLeft(std::istream& in)
+	{
+		std::streampos here = in.tellg();
+		if (here == std::streampos(-1))
+		{
+			in.clear();
+			return -1;
+		}
+		in.seekg(0, std::ios::end);
+		std::streampos end = in.tellg();
+		in.clear();
+		in.seekg(here);
+		if (end == std::streampos(-1) || !in)
+		{
+			in.clear();
+			return -1;
+		}
+		return end - here;
+	}
+}
+
+// ==================== Whole arrays ====================
+
+template <typename T, typename A, typename B>
+void serialize(std::ostream& out, Array<T, A, B> const & arr)
+{
+	SerialDetail::requireTriviallyCopyable<T>();
+	unsigned char header[SERIAL_HEADER_SIZE];
+	SerialDetail::encodeHeader(header, sizeof(T), SerialType<T>::code, arr.size());
+	out.write(reinterpret_cast<char const *>(header), SERIAL_HEADER_SIZE);
+	out.write(reinterpret_cast<char const *>(arr.data()),
+		static_cast<std::streamsize>(static_cast<size_t>(arr.size()) * sizeof(T)));
+	if (!out)
+		throw SerializeException("Serialize: write failed");
+}
+
+// Header and payload leave in a single writev(); loops only on short writes
+template <typename T, typename A, typename B>
+void saveArray(std::string const & path, Array<T, A, B> const & arr)
+{
+	SerialDetail::requireTriviallyCopyable<T>();
+	unsigned char header[SERIAL_HEADER_SIZE];
+	SerialDetail::encodeHeader(header, sizeof(T), SerialType<T>::code, arr.size());
+
+	int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if (fd < 0)
+		throw SerializeException(path + ": " + std::strerror(errno));
+
+	struct iovec parts[2];
+	parts[0].iov_base = header;
+	parts[0].iov_len = SERIAL_HEADER_SIZE;
+	parts[1].iov_base = const_cast<T*>(arr.data());
+	parts[1].iov_len = static_cast<size_t>(arr.size()) * sizeof(T);
+	struct iovec* part = parts;
+	int left = (parts[1].iov_len > 0) ? 2 : 1;
+	while (left > 0)
+	{
+		ssize_t written = ::writev(fd, part, left);
+		if (written < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			int error = errno;
+			::close(fd);
+			throw SerializeException(path + ": " + std::strerror(error));
+		}
+		size_t done = static_cast<size_t>(written);
+		while (left > 0 && done >= part->iov_len)
+		{
+			done -= part->iov_len;
+			part++;
+			left--;
+		}
+		if (left > 0)
+		{
+			part->iov_base = static_cast<char*>(part->iov_base) + done;
+			part->iov_len -= done;
+		}
+	}
+	if (::close(fd) != 0)
+		throw SerializeException(path + ": " + std::strerror(errno));
+}
+
+// Built in a separate array first: a malformed input leaves `arr` unchanged.
+// The count comes from the input, so it is never trusted for allocation:
+// on a seekable stream it must fit in the bytes left, otherwise the array
+// grows geometrically as the payload arrives (READ_CHUNK first, then
+// doubling) and a short stream fails after at most twice what it held.
+template <typename T, typename A, typename B>
+void deserialize(std::istream& in, Array<T, A, B>& arr)
+{
+	SerialDetail::requireTriviallyCopyable<T>();
+	SerialHeader header = SerialDetail::readHeader<T>(in);
+	SerialDetail::checkCount<T>(header.count);
+	size_t const count = static_cast<size_t>(header.count);
+
+	std::streamoff left = SerialDetail::bytesLeft(in);
+	if (left >= 0 && header.count > static_cast<uint64_t>(left) / sizeof(T))
+		throw SerializeException("Serialize: truncated input");
+
+	Array<T, A, B> result(arr.get_allocator());
+	if (left >= 0)
+	{
+		result.resize(count, uninitialized);
+		SerialDetail::readExactly(in, result.data(), count * sizeof(T));
+	}
+	else
+	{
+		size_t const first = (SerialDetail::READ_CHUNK + sizeof(T) - 1) / sizeof(T);
+		while (result.size() < count)
+		{
+			size_t done = result.size();
+			size_t step = (done > first) ? done : first;
+			if (step > count - done)
+				step = count - done;
+			result.resize(done + step, uninitialized);
+			SerialDetail::readExactly(in, result.data() + done, step * sizeof(T));
+		}
+	}
+	if (header.swapped)
+		SerialDetail::byteSwap(result.data(), result.size(), sizeof(T));
+	arr.swap(result);
+}
+
+template <typename T, typename A, typename B>
+void loadArray(std::string const & path, Array<T, A, B>& arr)
+{
+	std::ifstream in(path.c_str(), std::ios::binary);
+	if (!in)
+		throw SerializeException(path + ": cannot open");
+	deserialize(in, arr);
+}
+
+// ==================== Zero-copy view ====================
+
+template <typename T>
+SerializedView<T>::SerializedView() : _array(NULL), _size(0)
+{
+}
+
+template <typename T>
+SerializedView<T>::SerializedView(void const * buffer, size_t bytes) : _array(NULL), _size(0)
+{
+	SerialDetail::requireTriviallyCopyable<T>();
+	unsigned char const * base = static_cast<unsigned char const *>(buffer);
+	SerialHeader header = SerialDetail::decodeHeader(base, bytes, sizeof(T), SerialType<T>::code);
+	if (header.swapped && sizeof(T) > 1)
+		throw SerializeException("Serialize: byte order differs, use deserialize()");
+	SerialDetail::checkCount<T>(header.count);
+	if (header.count > (bytes - SERIAL_HEADER_SIZE) / sizeof(T))
+		throw SerializeException("Serialize: truncated input");
+	unsigned char const * payload = base + SERIAL_HEADER_SIZE;
+	if (reinterpret_cast<size_t>(payload) % __alignof__(T) != 0)
+		throw SerializeException("Serialize: payload misaligned for the element type");
+	_array = reinterpret_cast<T const *>(payload);
+	_size = static_cast<size_t>(header.count);
+}
+
+template <typename T>
+T const & SerializedView<T>::operator[](size_t index) const
+{
+	if (index >= _size)
+		throw std::out_of_range("SerializedView: index out of bounds");
+	return _array[index];
+}
+
+template <typename T>
+T const * SerializedView<T>::data() const
+{
+	return _array;
+}
+
+template <typename T>
+T const * SerializedView<T>::begin() const
+{
+	return _array;
+}
+
+template <typename T>
+T const * SerializedView<T>::end() const
+{
+	return _array + _size;
+}
+
+template <typename T>
+size_t SerializedView<T>::size() const
+{
+	return _size;
+}
+
+// ==================== Streaming ====================
+
+template <typename T>
+ArrayWriter<T>::ArrayWriter(std::ostream& out) : _out(out), _start(out.tellp()), _count(0), _finished(false)
+{
+	SerialDetail::requireTriviallyCopyable<T>();
+	unsigned char header[SERIAL_HEADER_SIZE];
+	SerialDetail::encodeHeader(header, sizeof(T), SerialType<T>::code, 0);
+	_out.write(reinterpret_cast<char const *>(header), SERIAL_HEADER_SIZE);
+	if (!_out)
+		throw SerializeException("Serialize: write failed");
+}
+
+// Destructors must not throw: errors are only reported by finish()
+template <typename T>
+ArrayWriter<T>::~ArrayWriter()
+{
+	if (!_finished)
+	{
+		try
+		{
+			finish();
+		}
+		catch (...)
+		{
+		}
+	}
+}
+
+template <typename T>
+void ArrayWriter<T>::write(T const * elements, size_t n)
+{
+	_out.write(reinterpret_cast<char const *>(elements), static_cast<std::streamsize>(n * sizeof(T)));
+	if (!_out)
+		throw SerializeException("Serialize: write failed");
+	_count += n;
+}
+
+template <typename T>
+uint64_t ArrayWriter<T>::count() const
+{
+	return _count;
+}
+
+// Seeks back to store the final count, then returns to the end
+template <typename T>
+void ArrayWriter<T>::finish()
+{
+	_finished = true;
+	std::streampos end = _out.tellp();
+	_out.seekp(_start + static_cast<std::streamoff>(16));
+	_out.write(reinterpret_cast<char const *>(&_count), sizeof(_count));
+	_out.seekp(end);
+	_out.flush();
+	if (!_out)
+		throw SerializeException("Serialize: cannot finish (stream not seekable?)");
+}
+
+template <typename T>
+ArrayReader<T>::ArrayReader(std::istream& in) : _in(in)
+{
+	SerialDetail::requireTriviallyCopyable<T>();
+	_header = SerialDetail::readHeader<T>(in);
+	_remaining = _header.count;
+}
+
+template <typename T>
+size_t ArrayReader<T>::read(T* dst, size_t max)
+{
+	size_t n = (max < _remaining) ? max : static_cast<size_t>(_remaining);
+	SerialDetail::readExactly(_in, dst, n * sizeof(T));
+	if (_header.swapped)
+		SerialDetail::byteSwap(dst, n, sizeof(T));
+	_remaining -= n;
+	return n;
+}
+
+template <typename T>
+uint64_t ArrayReader<T>::count() const
+{
+	return _header.count;
+}
+
+template <typename T>
+uint64_t ArrayReader<T>::remaining() const
+{
+	return _remaining;
+}
+
+template <typename T>
+SerialHeader const & ArrayReader<T>::header() const
+{
+	return _header;
+}
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef SMALLARRAY_HPP
+#define SMALLARRAY_HPP
+
+#include <exception>
+#include <stdexcept>
+#include <cstddef>
+
+// Array with inline storage for up to N elements: short arrays live entirely
+// inside the object, longer ones spill to the heap. Same semantics as Array
+// (value-initialized elements, deep copy, checked operator[]).
+template <typename T, size_t N = 16>
+class SmallArray
+{
+	private:
+		T*				_data;			// Points at _inline or at a heap buffer
+		size_t			_size;
+		size_t			_capacity;
+		char			_inline[N * sizeof(T)] __attribute__((aligned(__alignof__(T))));
+
+		T*			inlineData();
+		bool		onHeap() const;
+		static T*	allocate(size_t n);
+		void		release();
+		static void	destroy(T* first, T* last);
+		static void	uninitializedCopy(T const * src, size_t n, T* dst);
+
+	public:
+		// Orthodox Canonical Form
+		SmallArray();
+		SmallArray(size_t n);
+		SmallArray(SmallArray const & src);
+		SmallArray& operator=(SmallArray const & rhs);
+		~SmallArray();
+
+		// Subscript operator (two versions: const and non-const)
+		T& operator[](size_t index);
+		T const & operator[](size_t index) const;
+
+		size_t size() const;
+		size_t capacity() const;
+		bool isInline() const;				// True while no heap buffer is used
+
+		// Appends, spilling to the heap once N elements are exceeded
+		void push_back(T const & value);
+
+		class OutOfBoundsException : public std::exception
+		{
+			public:
+				virtual const char* what() const throw()
+				{
+					return "Error: Index out of bounds";
+				}
+		};
+};
+
+#include "SmallArray.tpp"
+
+#endif
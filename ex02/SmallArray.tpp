@@ -0,0 +1,244 @@
+#ifndef SMALLARRAY_TPP
+#define SMALLARRAY_TPP
+
+#include "SmallArray.hpp"
+#include <new>
+
+// ==================== Storage helpers ====================
+
+template <typename T, size_t N>
+T* SmallArray<T, N>::inlineData()
+{
+	return reinterpret_cast<T*>(_inline);
+}
+
+template <typename T, size_t N>
+bool SmallArray<T, N>::onHeap() const
+{
+	return _data != reinterpret_cast<T const *>(_inline);
+}
+
+template <typename T, size_t N>
+T* SmallArray<T, N>::allocate(size_t n)
+{
+	if (n > static_cast<size_t>(-1) / sizeof(T))
+		throw std::length_error("SmallArray: requested size is too large");
+	return static_cast<T*>(::operator new(n * sizeof(T)));
+}
+
+// Frees the heap buffer (if any) and goes back to inline storage
+template <typename T, size_t N>
+void SmallArray<T, N>::release()
+{
+	if (onHeap())
+		::operator delete(_data);
+	_data = inlineData();
+	_capacity = N;
+}
+
+template <typename T, size_t N>
+void SmallArray<T, N>::destroy(T* first, T* last)
+{
+	for (; first != last; ++first)
+		first->~T();
+}
+
+template <typename T, size_t N>
+void SmallArray<T, N>::uninitializedCopy(T const * src, size_t n, T* dst)
+{
+	size_t i = 0;
+	try
+	{
+		for (; i < n; i++)
+			new (dst + i) T(src[i]);
+	}
+	catch (...)
+	{
+		destroy(dst, dst + i);
+		throw;
+	}
+}
+
+// ==================== Constructors ====================
+
+template <typename T, size_t N>
+SmallArray<T, N>::SmallArray() : _data(inlineData()), _size(0), _capacity(N)
+{
+}
+
+// n elements, value-initialized; heap storage only when n > N
+template <typename T, size_t N>
+SmallArray<T, N>::SmallArray(size_t n) : _data(inlineData()), _size(0), _capacity(N)
+{
+	if (n > N)
+	{
+		_data = allocate(n);
+		_capacity = n;
+	}
+	// Local counter: element stores cannot alias it, so the loop stays tight
+	size_t i = 0;
+	try
+	{
+		for (; i < n; i++)
+			new (_data + i) T();
+	}
+	catch (...)
+	{
+		destroy(_data, _data + i);
+		release();
+		throw;
+	}
+	_size = n;
+}
+
+// Copy constructor: deep copy (inline again if src fits in N)
+template <typename T, size_t N>
+SmallArray<T, N>::SmallArray(SmallArray const & src) : _data(inlineData()), _size(0), _capacity(N)
+{
+	if (src._size > N)
+	{
+		_data = allocate(src._size);
+		_capacity = src._size;
+	}
+	try
+	{
+		uninitializedCopy(src._data, src._size, _data);
+	}
+	catch (...)
+	{
+		release();
+		throw;
+	}
+	_size = src._size;
+}
+
+// ==================== Destructor ====================
+
+template <typename T, size_t N>
+SmallArray<T, N>::~SmallArray()
+{
+	destroy(_data, _data + _size);
+	release();
+}
+
+// ==================== Assignment operator ====================
+
+// Deep copy. Reuses the current storage when rhs fits in it; otherwise the
+// copy is built in a new heap buffer first, so a throwing copy leaves *this
+// unchanged. Within the current storage a throwing copy leaves the elements
+// copied so far (basic guarantee, like std::vector).
+template <typename T, size_t N>
+SmallArray<T, N>& SmallArray<T, N>::operator=(SmallArray const & rhs)
+{
+	// Self-assignment protection
+	if (this == &rhs)
+		return *this;
+
+	if (rhs._size > _capacity)
+	{
+		T* buffer = allocate(rhs._size);
+		try
+		{
+			uninitializedCopy(rhs._data, rhs._size, buffer);
+		}
+		catch (...)
+		{
+			::operator delete(buffer);
+			throw;
+		}
+		destroy(_data, _data + _size);
+		release();
+		_data = buffer;
+		_capacity = rhs._size;
+		_size = rhs._size;
+		return *this;
+	}
+
+	destroy(_data, _data + _size);
+	_size = 0;
+	for (; _size < rhs._size; _size++)
+		new (_data + _size) T(rhs._data[_size]);
+	return *this;
+}
+
+// ==================== Subscript operator ====================
+
+template <typename T, size_t N>
+T& SmallArray<T, N>::operator[](size_t index)
+{
+	if (index >= _size)
+		throw OutOfBoundsException();
+	return _data[index];
+}
+
+template <typename T, size_t N>
+T const & SmallArray<T, N>::operator[](size_t index) const
+{
+	if (index >= _size)
+		throw OutOfBoundsException();
+	return _data[index];
+}
+
+// ==================== Member functions ====================
+
+template <typename T, size_t N>
+size_t SmallArray<T, N>::size() const
+{
+	return _size;
+}
+
+template <typename T, size_t N>
+size_t SmallArray<T, N>::capacity() const
+{
+	return _capacity;
+}
+
+template <typename T, size_t N>
+bool SmallArray<T, N>::isInline() const
+{
+	return !onHeap();
+}
+
+// Doubles the capacity when full; value may refer to one of our elements,
+// so it is copied into the new buffer before the old one is released
+template <typename T, size_t N>
+void SmallArray<T, N>::push_back(T const & value)
+{
+	if (_size < _capacity)
+	{
+		new (_data + _size) T(value);
+		_size++;
+		return;
+	}
+
+	if (_capacity > static_cast<size_t>(-1) / 2)
+		throw std::length_error("SmallArray: size overflow");
+	size_t newCapacity = (_capacity > 0) ? _capacity * 2 : 4;
+	T* buffer = allocate(newCapacity);
+	try
+	{
+		new (buffer + _size) T(value);
+	}
+	catch (...)
+	{
+		::operator delete(buffer);
+		throw;
+	}
+	try
+	{
+		uninitializedCopy(_data, _size, buffer);
+	}
+	catch (...)
+	{
+		buffer[_size].~T();
+		::operator delete(buffer);
+		throw;
+	}
+	destroy(_data, _data + _size);
+	release();
+	_data = buffer;
+	_capacity = newCapacity;
+	_size++;
+}
+
+#endif
@@ -0,0 +1,120 @@
+#ifndef SOAARRAY_HPP
+#define SOAARRAY_HPP
+
+#include <cstddef>
+#include "Array.hpp"
+
+// Structure of arrays: each field of a record lives in its own Array
+// column, so a scan over one field reads only that field's bytes instead
+// of dragging whole records through the cache. Up to 10 columns:
+//   enum { X, Y, MASS, ID };
+//   SoAArray<float, float, float, int> particles(1000);
+//   particles[3].get<MASS>() = 2.5f;               // record-style access
+//   particles.column<MASS>()                       // Array<float>&
+//   particles.iter<MASS>(func);                    // func(float&) per row
+//   particles.transform<X, Y>(func);               // y = func(x) per row
+//   float total = Kernels::sum(particles.column<MASS>());
+// Every column always has size() elements. Rows are handles (owner and
+// index), valid as long as the row exists.
+
+struct NoColumn {};
+
+namespace SoADetail
+{
+	// Columns<T0, ..., T9>: an Array<T0> followed by the remaining columns
+	template <typename T0, typename T1, typename T2, typename T3, typename T4,
+		typename T5, typename T6, typename T7, typename T8, typename T9>
+	struct Columns;
+
+	// Column<N, Columns>::Type and get(): the N-th column
+	template <size_t N, typename C>
+	struct Column;
+}
+
+template <typename T0, typename T1 = NoColumn, typename T2 = NoColumn, typename T3 = NoColumn,
+	typename T4 = NoColumn, typename T5 = NoColumn, typename T6 = NoColumn,
+	typename T7 = NoColumn, typename T8 = NoColumn, typename T9 = NoColumn>
+class SoAArray
+{
+	private:
+		typedef SoADetail::Columns<T0, T1, T2, T3, T4, T5, T6, T7, T8, T9> Storage;
+
+		Storage	_columns;
+
+	public:
+		// Element type of column N
+		template <size_t N>
+		struct ColumnType
+		{
+			typedef typename SoADetail::Column<N, Storage>::Type Type;
+		};
+
+		static size_t const COLUMNS = Storage::COUNT;
+
+		// Record-style handle on one row
+		class Row
+		{
+			private:
+				SoAArray*	_owner;
+				size_t		_index;
+
+			public:
+				Row(SoAArray& owner, size_t index);
+
+				template <size_t N>
+				typename ColumnType<N>::Type& get() const;
+				size_t index() const;
+		};
+
+		class ConstRow
+		{
+			private:
+				SoAArray const *	_owner;
+				size_t				_index;
+
+			public:
+				ConstRow(SoAArray const & owner, size_t index);
+
+				template <size_t N>
+				typename ColumnType<N>::Type const & get() const;
+				size_t index() const;
+		};
+
+		// Copy, assignment and destruction are the columns' (deep copies)
+		SoAArray();
+		explicit SoAArray(size_t n);		// n value-initialized rows
+
+		// Checked: throw Array::OutOfBoundsException
+		Row operator[](size_t index);
+		ConstRow operator[](size_t index) const;
+
+		size_t size() const;
+		bool empty() const;
+
+		// Applied to every column. If a column throws while growing, the
+		// columns already grown are shrunk back: sizes never disagree.
+		void reserve(size_t n);
+		void resize(size_t n);
+		void clear();
+		Row push_back();					// Appends a value-initialized row
+		void pop_back();
+		void swap(SoAArray& other);
+
+		// Column N as an Array (do not resize it on its own)
+		template <size_t N>
+		Array<typename ColumnType<N>::Type>& column();
+		template <size_t N>
+		Array<typename ColumnType<N>::Type> const & column() const;
+
+		// Column-wise operations: only the columns named are read or written
+		template <size_t N, typename F>
+		void iter(F func);
+		template <size_t N, typename F>
+		void iter(F func) const;
+		template <size_t Src, size_t Dst, typename F>
+		void transform(F func);				// column<Dst>[i] = func(column<Src>[i])
+};
+
+#include "SoAArray.tpp"
+
+#endif
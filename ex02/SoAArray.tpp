@@ -0,0 +1,247 @@
+#ifndef SOAARRAY_TPP
+#define SOAARRAY_TPP
+
+#include "SoAArray.hpp"
+#include "Kernels.hpp"
+#include "../ex01/iter.hpp"
+
+// ==================== Columns ====================
+
+namespace SoADetail
+{
+	template <typename T0, typename T1, typename T2, typename T3, typename T4,
+		typename T5, typename T6, typename T7, typename T8, typename T9>
+	struct Columns
+	{
+		typedef T0 Head;
+		typedef Columns<T1, T2, T3, T4, T5, T6, T7, T8, T9, NoColumn> Tail;
+		static size_t const COUNT = 1 + Tail::COUNT;
+
+		Array<T0>	head;
+		Tail		tail;
+
+		size_t size() const { return head.size(); }
+		void reserve(size_t n) { head.reserve(n); tail.reserve(n); }
+		void resize(size_t n) { head.resize(n); tail.resize(n); }
+		void clear() { head.clear(); tail.clear(); }
+		void pop_back() { head.pop_back(); tail.pop_back(); }
+		void swap(Columns& other) { head.swap(other.head); tail.swap(other.tail); }
+	};
+
+	// End of the list: no Head and no Tail, so Column<N> past the last
+	// column does not compile
+	template <>
+	struct Columns<NoColumn, NoColumn, NoColumn, NoColumn, NoColumn,
+		NoColumn, NoColumn, NoColumn, NoColumn, NoColumn>
+	{
+		static size_t const COUNT = 0;
+
+		void reserve(size_t) {}
+		void resize(size_t) {}
+		void clear() {}
+		void pop_back() {}
+		void swap(Columns&) {}
+	};
+
+	template <size_t N, typename C>
+	struct Column
+	{
+		typedef Column<N - 1, typename C::Tail> Next;
+		typedef typename Next::Type Type;
+
+		static Array<Type>& get(C& c) { return Next::get(c.tail); }
+		static Array<Type> const & get(C const & c) { return Next::get(c.tail); }
+	};
+
+	template <typename C>
+	struct Column<0, C>
+	{
+		typedef typename C::Head Type;
+
+		static Array<Type>& get(C& c) { return c.head; }
+		static Array<Type> const & get(C const & c) { return c.head; }
+	};
+}
+
+#define SOA_TEMPLATE template <typename T0, typename T1, typename T2, typename T3, typename T4, \
+	typename T5, typename T6, typename T7, typename T8, typename T9>
+#define SOA_CLASS SoAArray<T0, T1, T2, T3, T4, T5, T6, T7, T8, T9>
+
+SOA_TEMPLATE
+size_t const SOA_CLASS::COLUMNS;
+
+// ==================== Rows ====================
+
+// Rows come from operator[] (already checked): get() indexes directly
+SOA_TEMPLATE
+SOA_CLASS::Row::Row(SoAArray& owner, size_t index) : _owner(&owner), _index(index)
+{
+}
+
+SOA_TEMPLATE
+template <size_t N>
+typename SOA_CLASS::template ColumnType<N>::Type& SOA_CLASS::Row::get() const
+{
+	return _owner->template column<N>().data()[_index];
+}
+
+SOA_TEMPLATE
+size_t SOA_CLASS::Row::index() const
+{
+	return _index;
+}
+
+SOA_TEMPLATE
+SOA_CLASS::ConstRow::ConstRow(SoAArray const & owner, size_t index) : _owner(&owner), _index(index)
+{
+}
+
+SOA_TEMPLATE
+template <size_t N>
+typename SOA_CLASS::template ColumnType<N>::Type const & SOA_CLASS::ConstRow::get() const
+{
+	return _owner->template column<N>().data()[_index];
+}
+
+SOA_TEMPLATE
+size_t SOA_CLASS::ConstRow::index() const
+{
+	return _index;
+}
+
+// ==================== Construction ====================
+
+SOA_TEMPLATE
+SOA_CLASS::SoAArray()
+{
+}
+
+SOA_TEMPLATE
+SOA_CLASS::SoAArray(size_t n)
+{
+	resize(n);
+}
+
+// ==================== Rows and size ====================
+
+SOA_TEMPLATE
+typename SOA_CLASS::Row SOA_CLASS::operator[](size_t index)
+{
+	if (index >= size())
+		throw typename Array<T0>::OutOfBoundsException();
+	return Row(*this, index);
+}
+
+SOA_TEMPLATE
+typename SOA_CLASS::ConstRow SOA_CLASS::operator[](size_t index) const
+{
+	if (index >= size())
+		throw typename Array<T0>::OutOfBoundsException();
+	return ConstRow(*this, index);
+}
+
+SOA_TEMPLATE
+size_t SOA_CLASS::size() const
+{
+	return _columns.size();
+}
+
+SOA_TEMPLATE
+bool SOA_CLASS::empty() const
+{
+	return _columns.size() == 0;
+}
+
+// ==================== Capacity ====================
+
+// Columns reserved before the throw keep their capacity: harmless
+SOA_TEMPLATE
+void SOA_CLASS::reserve(size_t n)
+{
+	_columns.reserve(n);
+}
+
+// Shrinking never throws, so a failed growth is undone by shrinking every
+// column back to the old size
+SOA_TEMPLATE
+void SOA_CLASS::resize(size_t n)
+{
+	size_t old = size();
+	try
+	{
+		_columns.resize(n);
+	}
+	catch (...)
+	{
+		if (n > old)
+			_columns.resize(old);
+		throw;
+	}
+}
+
+SOA_TEMPLATE
+void SOA_CLASS::clear()
+{
+	_columns.clear();
+}
+
+SOA_TEMPLATE
+typename SOA_CLASS::Row SOA_CLASS::push_back()
+{
+	resize(size() + 1);
+	return Row(*this, size() - 1);
+}
+
+SOA_TEMPLATE
+void SOA_CLASS::pop_back()
+{
+	_columns.pop_back();
+}
+
+SOA_TEMPLATE
+void SOA_CLASS::swap(SoAArray& other)
+{
+	_columns.swap(other._columns);
+}
+
+// ==================== Columns ====================
+
+SOA_TEMPLATE
+template <size_t N>
+Array<typename SOA_CLASS::template ColumnType<N>::Type>& SOA_CLASS::column()
+{
+	return SoADetail::Column<N, Storage>::get(_columns);
+}
+
+SOA_TEMPLATE
+template <size_t N>
+Array<typename SOA_CLASS::template ColumnType<N>::Type> const & SOA_CLASS::column() const
+{
+	return SoADetail::Column<N, Storage>::get(_columns);
+}
+
+SOA_TEMPLATE
+template <size_t N, typename F>
+void SOA_CLASS::iter(F func)
+{
+	::iter(column<N>().view(), func);
+}
+
+SOA_TEMPLATE
+template <size_t N, typename F>
+void SOA_CLASS::iter(F func) const
+{
+	::iter(column<N>().view(), func);
+}
+
+SOA_TEMPLATE
+template <size_t Src, size_t Dst, typename F>
+void SOA_CLASS::transform(F func)
+{
+	Kernels::transform(column<Dst>().data(), column<Src>().data(), size(), func);
+}
+
+#undef SOA_CLASS
+#undef SOA_TEMPLATE
+
+#endif
@@ -0,0 +1,122 @@
+#ifndef SORT_HPP
+#define SORT_HPP
+
+#include <cstddef>
+#include "Array.hpp"
+#include "../ex00/whatever.hpp"
+#include "../ex01/ParallelIter.hpp"
+
+// In-place sorting and binary search for Arrays and views.
+//   ::sort(arr);                          // ascending, operator<
+//   ::sort(arr.slice(10, 20), Greater()); // any strict weak ordering
+//   ::sort(par, arr);                     // parallel merge of sorted runs
+//   size_t i = ::lower_bound(arr, 42);    // first index with !(arr[i] < 42)
+// Call them as ::sort etc.: with std types around, argument-dependent
+// lookup can also find std::sort.
+//
+// Algorithms:
+//   integer and floating-point keys, no comparator: LSD radix sort, one
+//       pass per byte, passes where every key shares the byte skipped
+//       (n >= RADIX_THRESHOLD, smaller inputs use the introsort). Already
+//       sorted or reversed inputs are detected first and cost one scan.
+//   anything else: pattern-defeating introsort (pdqsort). Median-of-3 or
+//       ninther pivots, insertion sort below 24 elements, linear time on
+//       sorted and reversed runs, equal keys grouped in one pass, and a
+//       heapsort fallback keeping the worst case O(n log n). Swaps move
+//       elements in C++11 builds.
+//   parallel: every thread sorts runs as above, then the runs are merged
+//       pairwise; each merge is split by rank so all threads take part.
+// None of them is stable. Radix and parallel sorts need a buffer of n
+// elements (default-constructible T for the parallel sort). -0.0 and +0.0
+// compare equal and may end up in either order; results are unspecified
+// with NaN. If comp throws, the contents of the range are unspecified. A
+// comparator used by a parallel sort is called from several threads at once.
+
+namespace SortDetail
+{
+	struct Less
+	{
+		template <typename T>
+		bool operator()(T const & a, T const & b) const
+		{
+			return a < b;
+		}
+	};
+
+	// Element type of a view: search values of ArrayView<int const> are ints
+	template <typename T>
+	struct Element
+	{
+		typedef T Type;
+	};
+	template <typename T>
+	struct Element<T const>
+	{
+		typedef T Type;
+	};
+
+	size_t const RADIX_THRESHOLD = 256;
+	size_t const PARALLEL_THRESHOLD = 1u << 16;
+}
+
+// ==================== Sorting ====================
+
+template <typename T>
+void sort(ArrayView<T> view);
+template <typename T, typename Compare>
+void sort(ArrayView<T> view, Compare comp);
+template <typename T, typename A, typename B>
+void sort(Array<T, A, B>& array);
+template <typename T, typename A, typename B, typename Compare>
+void sort(Array<T, A, B>& array, Compare comp);
+
+// Below PARALLEL_THRESHOLD elements, or on a single-thread pool, these
+// are the sequential sorts. policy.grain is the minimum run length.
+template <typename T>
+void sort(ParallelPolicy const & policy, ArrayView<T> view);
+template <typename T, typename Compare>
+void sort(ParallelPolicy const & policy, ArrayView<T> view, Compare comp);
+template <typename T, typename A, typename B>
+void sort(ParallelPolicy const & policy, Array<T, A, B>& array);
+template <typename T, typename A, typename B, typename Compare>
+void sort(ParallelPolicy const & policy, Array<T, A, B>& array, Compare comp);
+
+template <typename T, typename Compare>
+bool is_sorted(ArrayView<T> view, Compare comp);
+template <typename T>
+bool is_sorted(ArrayView<T> view);
+template <typename T, typename A, typename B>
+bool is_sorted(Array<T, A, B> const & array);
+
+// ==================== Searching ====================
+
+// On a range sorted by comp (operator< by default):
+//   lower_bound: first index whose element is not less than value
+//   upper_bound: first index whose element is greater than value
+//   binary_search: whether an element equivalent to value is present
+// Both bounds return size() when there is no such element. The loop has
+// no data-dependent branch: the compiler turns the step into a cmov.
+template <typename T, typename Compare>
+size_t lower_bound(ArrayView<T> view, typename SortDetail::Element<T>::Type const & value, Compare comp);
+template <typename T>
+size_t lower_bound(ArrayView<T> view, typename SortDetail::Element<T>::Type const & value);
+template <typename T, typename A, typename B>
+size_t lower_bound(Array<T, A, B> const & array, typename SortDetail::Element<T>::Type const & value);
+
+template <typename T, typename Compare>
+size_t upper_bound(ArrayView<T> view, typename SortDetail::Element<T>::Type const & value, Compare comp);
+template <typename T>
+size_t upper_bound(ArrayView<T> view, typename SortDetail::Element<T>::Type const & value);
+template <typename T, typename A, typename B>
+size_t upper_bound(Array<T, A, B> const & array, typename SortDetail::Element<T>::Type const & value);
+
+template <typename T, typename Compare>
+bool binary_search(ArrayView<T> view, typename SortDetail::Element<T>::Type const & value, Compare comp);
+template <typename T>
+bool binary_search(ArrayView<T> view, typename SortDetail::Element<T>::Type const & value);
+template <typename T, typename A, typename B>
+bool binary_search(Array<T, A, B> const & array, typename SortDetail::Element<T>::Type const & value);
+
+#include "Sort.tpp"
+
+#endif
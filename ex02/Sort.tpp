@@ -0,0 +1,807 @@
+#ifndef SORT_TPP
+#define SORT_TPP
+
+#include "Sort.hpp"
+#include <cstring>
+
+#if __cplusplus >= 201103L
+# define SORT_MOVE(x) std::move(x)
+#else
+# define SORT_MOVE(x) (x)
+#endif
+
+namespace SortDetail
+{
+	// Element exchange of the sorts: moves in C++11 builds, so strings
+	// and containers are not deep-copied (::swap copies)
+	template <typename T>
+	void swapElements(T& a, T& b)
+	{
+		T tmp(SORT_MOVE(a));
+		a = SORT_MOVE(b);
+		b = SORT_MOVE(tmp);
+	}
+
+	// ==================== Radix keys ====================
+
+	// Unsigned integer with the same order as T: signed integers flip the
+	// sign bit, floats flip every bit of negatives and the sign bit of
+	// positives
+	template <typename T>
+	struct RadixKey
+	{
+		static bool const RADIX = false;
+	};
+
+#define SORT_RADIX_INTEGER(T, U) \
+	template <> struct RadixKey<T> \
+	{ \
+		static bool const RADIX = true; \
+		typedef U Bits; \
+		static Bits encode(T value) \
+		{ \
+			Bits const sign = (static_cast<T>(-1) < static_cast<T>(0)) ? Bits(1) << (sizeof(T) * 8 - 1) : 0; \
+			return static_cast<Bits>(value) ^ sign; \
+		} \
+	};
+	SORT_RADIX_INTEGER(char, unsigned char)
+	SORT_RADIX_INTEGER(signed char, unsigned char)
+	SORT_RADIX_INTEGER(unsigned char, unsigned char)
+	SORT_RADIX_INTEGER(short, unsigned short)
+	SORT_RADIX_INTEGER(unsigned short, unsigned short)
+	SORT_RADIX_INTEGER(int, unsigned int)
+	SORT_RADIX_INTEGER(unsigned int, unsigned int)
+	SORT_RADIX_INTEGER(long, unsigned long)
+	SORT_RADIX_INTEGER(unsigned long, unsigned long)
+#undef SORT_RADIX_INTEGER
+
+#define SORT_RADIX_FLOAT(T, U) \
+	template <> struct RadixKey<T> \
+	{ \
+		static bool const RADIX = true; \
+		typedef U Bits; \
+		static Bits encode(T value) \
+		{ \
+			Bits bits; \
+			std::memcpy(&bits, &value, sizeof(bits)); \
+			Bits const sign = Bits(1) << (sizeof(T) * 8 - 1); \
+			return (bits & sign) ? ~bits : (bits | sign); \
+		} \
+	};
+	SORT_RADIX_FLOAT(float, unsigned int)
+	SORT_RADIX_FLOAT(double, unsigned long long)
+#undef SORT_RADIX_FLOAT
+
+	// One counting pass per byte, least significant first. Histograms for
+	// every byte come from a single read of the input; a byte where all
+	// keys agree needs no pass.
+	template <typename T>
+	void radixSort(T* data, size_t n)
+	{
+		typedef RadixKey<T> Key;
+		typedef typename Key::Bits Bits;
+		size_t const PASSES = sizeof(Bits);
+
+		size_t counts[PASSES][256];
+		std::memset(counts, 0, sizeof(counts));
+		for (size_t i = 0; i < n; i++)
+		{
+			Bits key = Key::encode(data[i]);
+			for (size_t p = 0; p < PASSES; p++)
+				counts[p][(key >> (p * 8)) & 0xFF]++;
+		}
+
+		Array<T> buffer(n, uninitialized);
+		T* from = data;
+		T* to = buffer.data();
+		Bits first = Key::encode(data[0]);
+		for (size_t p = 0; p < PASSES; p++)
+		{
+			size_t* count = counts[p];
+			if (count[(first >> (p * 8)) & 0xFF] == n)
+				continue;
+			size_t offset = 0;
+			for (size_t d = 0; d < 256; d++)
+			{
+				size_t c = count[d];
+				count[d] = offset;
+				offset += c;
+			}
+			for (size_t i = 0; i < n; i++)
+				to[count[(Key::encode(from[i]) >> (p * 8)) & 0xFF]++] = from[i];
+			::swap(from, to);
+		}
+		if (from != data)
+			std::memcpy(static_cast<void*>(data), from, n * sizeof(T));
+	}
+
+	// ==================== Pattern-defeating introsort ====================
+
+	size_t const INSERTION_THRESHOLD = 24;
+	size_t const NINTHER_THRESHOLD = 128;
+	size_t const PARTIAL_INSERTION_LIMIT = 8;
+
+	template <typename T, typename Compare>
+	void insertionSort(T* begin, T* end, Compare& comp)
+	{
+		if (begin == end)
+			return;
+		for (T* cur = begin + 1; cur != end; ++cur)
+		{
+			T* sift = cur;
+			T* before = cur - 1;
+			if (comp(*sift, *before))
+			{
+				T tmp(SORT_MOVE(*sift));
+				do
+					*sift-- = SORT_MOVE(*before);
+				while (sift != begin && comp(tmp, *--before));
+				*sift = SORT_MOVE(tmp);
+			}
+		}
+	}
+
+	// The element before begin is no greater than any in the range, so the
+	// inner loop needs no bounds check
+	template <typename T, typename Compare>
+	void unguardedInsertionSort(T* begin, T* end, Compare& comp)
+	{
+		if (begin == end)
+			return;
+		for (T* cur = begin + 1; cur != end; ++cur)
+		{
+			T* sift = cur;
+			T* before = cur - 1;
+			if (comp(*sift, *before))
+			{
+				T tmp(SORT_MOVE(*sift));
+				do
+					*sift-- = SORT_MOVE(*before);
+				while (comp(tmp, *--before));
+				*sift = SORT_MOVE(tmp);
+			}
+		}
+	}
+
+	// Insertion sort that gives up after PARTIAL_INSERTION_LIMIT moves:
+	// true when the range ended up sorted
+	template <typename T, typename Compare>
+	bool partialInsertionSort(T* begin, T* end, Compare& comp)
+	{
+		if (begin == end)
+			return true;
+		size_t moves = 0;
+		for (T* cur = begin + 1; cur != end; ++cur)
+		{
+			T* sift = cur;
+			T* before = cur - 1;
+			if (comp(*sift, *before))
+			{
+				T tmp(SORT_MOVE(*sift));
+				do
+					*sift-- = SORT_MOVE(*before);
+				while (sift != begin && comp(tmp, *--before));
+				*sift = SORT_MOVE(tmp);
+				moves += static_cast<size_t>(cur - sift);
+				if (moves > PARTIAL_INSERTION_LIMIT)
+					return false;
+			}
+		}
+		return true;
+	}
+
+	template <typename T, typename Compare>
+	void sort2(T* a, T* b, Compare& comp)
+	{
+		if (comp(*b, *a))
+			swapElements(*a, *b);
+	}
+
+	template <typename T, typename Compare>
+	void sort3(T* a, T* b, T* c, Compare& comp)
+	{
+		sort2(a, b, comp);
+		sort2(b, c, comp);
+		sort2(a, b, comp);
+	}
+
+	template <typename T, typename Compare>
+	void siftDown(T* heap, size_t root, size_t n, Compare& comp)
+	{
+		T value(SORT_MOVE(heap[root]));
+		size_t child;
+		while ((child = 2 * root + 1) < n)
+		{
+			if (child + 1 < n && comp(heap[child], heap[child + 1]))
+				child++;
+			if (!comp(value, heap[child]))
+				break;
+			heap[root] = SORT_MOVE(heap[child]);
+			root = child;
+		}
+		heap[root] = SORT_MOVE(value);
+	}
+
+	// Fallback once partitions keep coming out unbalanced
+	template <typename T, typename Compare>
+	void heapSort(T* begin, T* end, Compare& comp)
+	{
+		size_t n = static_cast<size_t>(end - begin);
+		for (size_t i = n / 2; i-- > 0;)
+			siftDown(begin, i, n, comp);
+		for (size_t last = n; last-- > 1;)
+		{
+			swapElements(begin[0], begin[last]);
+			siftDown(begin, 0, last, comp);
+		}
+	}
+
+	// Partitions around *begin: [begin, pivot) < pivot <= (pivot, end).
+	// Sets alreadyPartitioned when no element had to move.
+	template <typename T, typename Compare>
+	T* partitionRight(T* begin, T* end, Compare& comp, bool& alreadyPartitioned)
+	{
+		T pivot(SORT_MOVE(*begin));
+		T* first = begin;
+		T* last = end;
+
+		// The median-of-3 left an element >= pivot on the right and one
+		// <= pivot on the left, bounding both scans
+		while (comp(*++first, pivot))
+			;
+		if (first - 1 == begin)
+			while (first < last && !comp(*--last, pivot))
+				;
+		else
+			while (!comp(*--last, pivot))
+				;
+
+		alreadyPartitioned = first >= last;
+		while (first < last)
+		{
+			swapElements(*first, *last);
+			while (comp(*++first, pivot))
+				;
+			while (!comp(*--last, pivot))
+				;
+		}
+
+		T* pivotPos = first - 1;
+		*begin = SORT_MOVE(*pivotPos);
+		*pivotPos = SORT_MOVE(pivot);
+		return pivotPos;
+	}
+
+	// Puts every element equal to the pivot *begin on the left:
+	// [begin, pivot] == pivot < (pivot, end). Used when the pivot equals
+	// the element before the range, so the left part needs no more work.
+	template <typename T, typename Compare>
+	T* partitionLeft(T* begin, T* end, Compare& comp)
+	{
+		T pivot(SORT_MOVE(*begin));
+		T* first = begin;
+		T* last = end;
+
+		while (comp(pivot, *--last))
+			;
+		if (last + 1 == end)
+			while (first < last && !comp(pivot, *++first))
+				;
+		else
+			while (!comp(pivot, *++first))
+				;
+
+		while (first < last)
+		{
+			swapElements(*first, *last);
+			while (comp(pivot, *--last))
+				;
+			while (!comp(pivot, *++first))
+				;
+		}
+
+		T* pivotPos = last;
+		*begin = SORT_MOVE(*pivotPos);
+		*pivotPos = SORT_MOVE(pivot);
+		return pivotPos;
+	}
+
+	// Recurses into the left part, loops on the right one. badAllowed is
+	// the number of unbalanced partitions left before switching to heapsort.
+	template <typename T, typename Compare>
+	void pdqLoop(T* begin, T* end, Compare& comp, int badAllowed, bool leftmost)
+	{
+		while (true)
+		{
+			size_t size = static_cast<size_t>(end - begin);
+			if (size < INSERTION_THRESHOLD)
+			{
+				if (leftmost)
+					insertionSort(begin, end, comp);
+				else
+					unguardedInsertionSort(begin, end, comp);
+				return;
+			}
+
+			// Pivot to *begin: median of 3, or pseudo-median of 9 (ninther)
+			size_t half = size / 2;
+			if (size > NINTHER_THRESHOLD)
+			{
+				sort3(begin, begin + half, end - 1, comp);
+				sort3(begin + 1, begin + (half - 1), end - 2, comp);
+				sort3(begin + 2, begin + (half + 1), end - 3, comp);
+				sort3(begin + (half - 1), begin + half, begin + (half + 1), comp);
+				swapElements(*begin, *(begin + half));
+			}
+			else
+				sort3(begin + half, begin, end - 1, comp);
+
+			// Many equal keys: the pivot equals the element before the
+			// range, so everything equal to it can be skipped at once
+			if (!leftmost && !comp(*(begin - 1), *begin))
+			{
+				begin = partitionLeft(begin, end, comp) + 1;
+				continue;
+			}
+
+			bool alreadyPartitioned = false;
+			T* pivot = partitionRight(begin, end, comp, alreadyPartitioned);
+			size_t leftSize = static_cast<size_t>(pivot - begin);
+			size_t rightSize = static_cast<size_t>(end - (pivot + 1));
+
+			if (leftSize < size / 8 || rightSize < size / 8)
+			{
+				if (--badAllowed == 0)
+				{
+					heapSort(begin, end, comp);
+					return;
+				}
+				// Breaks the pattern that produced the bad pivot
+				if (leftSize >= INSERTION_THRESHOLD)
+				{
+					swapElements(begin[0], begin[leftSize / 4]);
+					swapElements(pivot[-1], pivot[-static_cast<ptrdiff_t>(leftSize / 4)]);
+					if (leftSize > NINTHER_THRESHOLD)
+					{
+						swapElements(begin[1], begin[leftSize / 4 + 1]);
+						swapElements(begin[2], begin[leftSize / 4 + 2]);
+						swapElements(pivot[-2], pivot[-static_cast<ptrdiff_t>(leftSize / 4 + 1)]);
+						swapElements(pivot[-3], pivot[-static_cast<ptrdiff_t>(leftSize / 4 + 2)]);
+					}
+				}
+				if (rightSize >= INSERTION_THRESHOLD)
+				{
+					swapElements(pivot[1], pivot[1 + rightSize / 4]);
+					swapElements(end[-1], end[-static_cast<ptrdiff_t>(rightSize / 4)]);
+					if (rightSize > NINTHER_THRESHOLD)
+					{
+						swapElements(pivot[2], pivot[2 + rightSize / 4]);
+						swapElements(pivot[3], pivot[3 + rightSize / 4]);
+						swapElements(end[-2], end[-static_cast<ptrdiff_t>(1 + rightSize / 4)]);
+						swapElements(end[-3], end[-static_cast<ptrdiff_t>(2 + rightSize / 4)]);
+					}
+				}
+			}
+			else if (alreadyPartitioned && partialInsertionSort(begin, pivot, comp)
+				&& partialInsertionSort(pivot + 1, end, comp))
+				return;		// Both sides were (nearly) sorted already
+
+			pdqLoop(begin, pivot, comp, badAllowed, leftmost);
+			begin = pivot + 1;
+			leftmost = false;
+		}
+	}
+
+	template <typename T, typename Compare>
+	void pdqSort(T* data, size_t n, Compare& comp)
+	{
+		if (n < 2)
+			return;
+		int log2 = 0;
+		for (size_t m = n; m > 1; m >>= 1)
+			log2++;
+		pdqLoop(data, data + n, comp, log2, true);
+	}
+
+	// ==================== Dispatch ====================
+
+	// Comparator sorts; operator< on radix keys takes the radix sort
+	template <typename T, typename Compare>
+	struct Sorter
+	{
+		static void sort(T* data, size_t n, Compare& comp)
+		{
+			pdqSort(data, n, comp);
+		}
+	};
+
+	template <typename T, bool Radix = RadixKey<T>::RADIX>
+	struct DefaultSorter
+	{
+		static void sort(T* data, size_t n)
+		{
+			Less less;
+			pdqSort(data, n, less);
+		}
+	};
+
+	// Length of the ascending (or strictly descending) run at the start
+	template <typename T>
+	size_t ascendingRun(T const * data, size_t n)
+	{
+		size_t i = 1;
+		while (i < n && !(data[i] < data[i - 1]))
+			i++;
+		return i;
+	}
+
+	template <typename T>
+	size_t descendingRun(T const * data, size_t n)
+	{
+		size_t i = 1;
+		while (i < n && data[i] < data[i - 1])
+			i++;
+		return i;
+	}
+
+	template <typename T>
+	struct DefaultSorter<T, true>
+	{
+		// Sorted and reversed inputs are caught before paying for every
+		// radix pass; on other inputs the scans stop within a few elements
+		static void sort(T* data, size_t n)
+		{
+			if (n >= RADIX_THRESHOLD)
+			{
+				if (ascendingRun(data, n) == n)
+					return;
+				if (descendingRun(data, n) == n)
+				{
+					for (size_t i = 0; i < n / 2; i++)
+						swapElements(data[i], data[n - 1 - i]);
+					return;
+				}
+				radixSort(data, n);
+			}
+			else
+			{
+				Less less;
+				pdqSort(data, n, less);
+			}
+		}
+	};
+
+	template <typename T>
+	struct Sorter<T, Less>
+	{
+		static void sort(T* data, size_t n, Less&)
+		{
+			DefaultSorter<T>::sort(data, n);
+		}
+	};
+
+	// ==================== Parallel merge sort ====================
+
+	// Number of elements of a (length la) among the first `rank` elements
+	// of merge(a, b); ties go to a
+	template <typename T, typename Compare>
+	size_t coRank(size_t rank, T const * a, size_t la, T const * b, size_t lb, Compare& comp)
+	{
+		size_t lo = (rank > lb) ? rank - lb : 0;
+		size_t hi = ::min(rank, la);
+		while (lo < hi)
+		{
+			size_t i = lo + (hi - lo) / 2;
+			size_t j = rank - i;
+			if (j > 0 && !comp(b[j - 1], a[i]))
+				lo = i + 1;
+			else
+				hi = i;
+		}
+		return lo;
+	}
+
+	template <typename T, typename Compare>
+	void merge(T* a, T* aEnd, T* b, T* bEnd, T* out, Compare& comp)
+	{
+		while (a != aEnd && b != bEnd)
+		{
+			if (comp(*b, *a))
+				*out++ = SORT_MOVE(*b++);
+			else
+				*out++ = SORT_MOVE(*a++);
+		}
+		while (a != aEnd)
+			*out++ = SORT_MOVE(*a++);
+		while (b != bEnd)
+			*out++ = SORT_MOVE(*b++);
+	}
+
+	// Task i sorts run i in place
+	template <typename T, typename Compare>
+	struct SortRuns
+	{
+		T*			data;
+		size_t		n;
+		size_t		run;
+		Compare&	comp;
+
+		SortRuns(T* d, size_t count, size_t length, Compare& c) : data(d), n(count), run(length), comp(c) {}
+
+		void operator()(size_t i)
+		{
+			size_t begin = i * run;
+			Sorter<T, Compare>::sort(data + begin, ::min(run, n - begin), comp);
+		}
+	};
+
+	// Merges runs of `width` pairwise from `from` into `to`. Each pair's
+	// output is cut into `perPair` pieces of `piece` elements, written by
+	// one task each. Tasks run twice: first every piece finds where it
+	// starts in the left run (co-rank), then the pieces are merged. Ranks
+	// must all be known before merging starts, as merging moves elements
+	// out of `from`.
+	template <typename T, typename Compare>
+	struct MergeRound
+	{
+		T*			from;
+		T*			to;
+		size_t		n;
+		size_t		width;
+		size_t		piece;
+		size_t		perPair;
+		Compare&	comp;
+		Array<size_t>	splits;		// Elements of the left run before each piece
+		bool		ranking;
+
+		MergeRound(T* f, T* t, size_t count, size_t w, size_t p, Compare& c)
+			: from(f), to(t), n(count), width(w), piece(p), perPair((2 * w + p - 1) / p), comp(c),
+			splits(pieces()), ranking(true)
+		{
+		}
+
+		size_t pieces() const
+		{
+			return (n + 2 * width - 1) / (2 * width) * perPair;
+		}
+
+		void operator()(size_t t)
+		{
+			size_t begin = (t / perPair) * 2 * width;
+			size_t middle = ::min(begin + width, n);
+			size_t end = ::min(begin + 2 * width, n);
+			size_t lo = begin + (t % perPair) * piece;
+			if (lo >= end)
+				return;
+			size_t hi = ::min(lo + piece, end);
+
+			T* a = from + begin;
+			T* b = from + middle;
+			size_t la = middle - begin;
+			if (ranking)
+			{
+				splits[t] = coRank(lo - begin, a, la, b, end - middle, comp);
+				return;
+			}
+			size_t i0 = splits[t];
+			size_t i1 = (hi == end) ? la : splits[t + 1];
+			merge(a + i0, a + i1, b + (lo - begin - i0), b + (hi - begin - i1), to + lo, comp);
+		}
+	};
+
+	// parallelFor body copying the result back out of the buffer
+	template <typename T>
+	struct CopyBack
+	{
+		T*	from;
+		T*	to;
+
+		void operator()(size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; i++)
+				to[i] = SORT_MOVE(from[i]);
+		}
+	};
+
+	template <typename T, typename Compare>
+	void parallelSort(ParallelPolicy const & policy, T* data, size_t n, Compare& comp)
+	{
+		ThreadPool& pool = (policy.pool != NULL) ? *policy.pool : ThreadPool::shared();
+		if (n < PARALLEL_THRESHOLD || pool.size() == 1)
+		{
+			Sorter<T, Compare>::sort(data, n, comp);
+			return;
+		}
+
+		// About 4 runs per thread, so stealing evens out uneven runs
+		size_t pieces = pool.size() * 4;
+		size_t run = ::max(policy.grain, (n + pieces - 1) / pieces);
+		SortRuns<T, Compare> sortRuns(data, n, run, comp);
+		pool.run(sortRuns, (n + run - 1) / run);
+
+		Array<T> buffer(n, uninitialized);
+		T* from = data;
+		T* to = buffer.data();
+		size_t piece = ::max(policy.grain, (n + pieces - 1) / pieces);
+		for (size_t width = run; width < n; width *= 2)
+		{
+			MergeRound<T, Compare> round(from, to, n, width, piece, comp);
+			pool.run(round, round.pieces());
+			round.ranking = false;
+			pool.run(round, round.pieces());
+			::swap(from, to);
+		}
+		if (from != data)
+		{
+			CopyBack<T> copy = {from, data};
+			pool.parallelFor(0, n, piece, copy);
+		}
+	}
+
+	// Branch-free lower bound: the range [base, base + length] always holds
+	// the answer, and halves with a conditional move
+	template <typename T, typename V, typename Compare>
+	size_t lowerBound(T const * data, size_t n, V const & value, Compare& comp)
+	{
+		if (n == 0)
+			return 0;
+		T const * base = data;
+		size_t length = n;
+		while (length > 1)
+		{
+			size_t half = length / 2;
+			base = comp(base[half], value) ? base + half : base;
+			length -= half;
+		}
+		return static_cast<size_t>(base - data) + (comp(*base, value) ? 1 : 0);
+	}
+
+	// Upper bound is a lower bound for "not (value < element)"
+	template <typename Compare>
+	struct NotGreater
+	{
+		Compare& comp;
+
+		NotGreater(Compare& c) : comp(c) {}
+
+		template <typename T, typename V>
+		bool operator()(T const & element, V const & value) const
+		{
+			return !comp(value, element);
+		}
+	};
+}
+
+#undef SORT_MOVE
+
+// ==================== Sorting ====================
+
+template <typename T>
+void sort(ArrayView<T> view)
+{
+	SortDetail::DefaultSorter<T>::sort(view.data(), view.size());
+}
+
+template <typename T, typename Compare>
+void sort(ArrayView<T> view, Compare comp)
+{
+	SortDetail::Sorter<T, Compare>::sort(view.data(), view.size(), comp);
+}
+
+template <typename T, typename A, typename B>
+void sort(Array<T, A, B>& array)
+{
+	::sort(array.view());
+}
+
+template <typename T, typename A, typename B, typename Compare>
+void sort(Array<T, A, B>& array, Compare comp)
+{
+	::sort(array.view(), comp);
+}
+
+template <typename T>
+void sort(ParallelPolicy const & policy, ArrayView<T> view)
+{
+	SortDetail::Less less;
+	SortDetail::parallelSort(policy, view.data(), view.size(), less);
+}
+
+template <typename T, typename Compare>
+void sort(ParallelPolicy const & policy, ArrayView<T> view, Compare comp)
+{
+	SortDetail::parallelSort(policy, view.data(), view.size(), comp);
+}
+
+template <typename T, typename A, typename B>
+void sort(ParallelPolicy const & policy, Array<T, A, B>& array)
+{
+	::sort(policy, array.view());
+}
+
+template <typename T, typename A, typename B, typename Compare>
+void sort(ParallelPolicy const & policy, Array<T, A, B>& array, Compare comp)
+{
+	::sort(policy, array.view(), comp);
+}
+
+template <typename T, typename Compare>
+bool is_sorted(ArrayView<T> view, Compare comp)
+{
+	for (size_t i = 1; i < view.size(); i++)
+		if (comp(view[i], view[i - 1]))
+			return false;
+	return true;
+}
+
+template <typename T>
+bool is_sorted(ArrayView<T> view)
+{
+	return ::is_sorted(view, SortDetail::Less());
+}
+
+template <typename T, typename A, typename B>
+bool is_sorted(Array<T, A, B> const & array)
+{
+	return ::is_sorted(array.view());
+}
+
+// ==================== Searching ====================
+
+template <typename T, typename Compare>
+size_t lower_bound(ArrayView<T> view, typename SortDetail::Element<T>::Type const & value, Compare comp)
+{
+	return SortDetail::lowerBound(view.data(), view.size(), value, comp);
+}
+
+template <typename T>
+size_t lower_bound(ArrayView<T> view, typename SortDetail::Element<T>::Type const & value)
+{
+	return ::lower_bound(view, value, SortDetail::Less());
+}
+
+template <typename T, typename A, typename B>
+size_t lower_bound(Array<T, A, B> const & array, typename SortDetail::Element<T>::Type const & value)
+{
+	return ::lower_bound(array.view(), value);
+}
+
+template <typename T, typename Compare>
+size_t upper_bound(ArrayView<T> view, typename SortDetail::Element<T>::Type const & value, Compare comp)
+{
+	SortDetail::NotGreater<Compare> notGreater(comp);
+	return SortDetail::lowerBound(view.data(), view.size(), value, notGreater);
+}
+
+template <typename T>
+size_t upper_bound(ArrayView<T> view, typename SortDetail::Element<T>::Type const & value)
+{
+	return ::upper_bound(view, value, SortDetail::Less());
+}
+
+template <typename T, typename A, typename B>
+size_t upper_bound(Array<T, A, B> const & array, typename SortDetail::Element<T>::Type const & value)
+{
+	return ::upper_bound(array.view(), value);
+}
+
+template <typename T, typename Compare>
+bool binary_search(ArrayView<T> view, typename SortDetail::Element<T>::Type const & value, Compare comp)
+{
+	size_t i = ::lower_bound(view, value, comp);
+	return i < view.size() && !comp(value, view[i]);
+}
+
+template <typename T>
+bool binary_search(ArrayView<T> view, typename SortDetail::Element<T>::Type const & value)
+{
+	return ::binary_search(view, value, SortDetail::Less());
+}
+
+template <typename T, typename A, typename B>
+bool binary_search(Array<T, A, B> const & array, typename SortDetail::Element<T>::Type const & value)
+{
+	return ::binary_search(array.view(), value);
+}
+
+#endif
@@ -0,0 +1,119 @@
+#ifndef STATICARRAY_HPP
+#define STATICARRAY_HPP
+
+#include <exception>
+#include <cstddef>
+#include <utility>
+#include "TypeTraits.hpp"
+#include "../ex00/whatever.hpp"
+#include "../ex01/iter.hpp"
+#include "../ex01/ArrayView.hpp"
+
+// C++11 makes construction and const access usable in constant expressions
+#if __cplusplus >= 201103L
+# define STATICARRAY_CONSTEXPR constexpr
+#else
+# define STATICARRAY_CONSTEXPR
+#endif
+
+// Array whose size N is a compile-time constant: the elements live inside
+// the object (on the stack for locals), so there is no allocation and no
+// size to store. Same element rules as Array (value-initialized, checked
+// operator[]). N must be at least 1.
+//   StaticArray<int, 5> arr;            // 5 zeros, no heap
+//   arr.get<7>();                       // does not compile
+//   constexpr StaticArray<int, 3> p(2, 3, 5);   // C++11
+//   static_assert(p[1] == 3, "");
+//
+// Copy, assignment and destruction are the implicit element-wise ones, so
+// a StaticArray of trivial T is itself trivial (and a literal type).
+template <typename T, size_t N>
+class StaticArray
+{
+	private:
+		T	_data[N];
+
+		typedef char RequiresElements[N > 0 ? 1 : -1];
+
+	public:
+		static size_t const SIZE = N;
+
+		STATICARRAY_CONSTEXPR StaticArray();		// Value-initialized elements
+		explicit StaticArray(UninitializedTag);		// Trivial T left indeterminate
+		explicit StaticArray(T const (&values)[N]);
+#if __cplusplus >= 201103L
+		// Leading elements from the arguments, the rest value-initialized
+		//   StaticArray<int, 4> a = {1, 2};    // 1 2 0 0
+		// One argument is explicit: StaticArray<int, 4> a = 5; does not
+		// compile, nor does passing a bare int where a StaticArray is expected.
+		constexpr explicit StaticArray(T const & first);
+		template <typename... Rest>
+		constexpr StaticArray(T const & first, T const & second, Rest const &... rest);
+#endif
+
+		// Subscript operator (two versions: const and non-const), always checked
+		T& operator[](size_t index);
+		STATICARRAY_CONSTEXPR T const & operator[](size_t index) const;
+		T& at(size_t index);
+		STATICARRAY_CONSTEXPR T const & at(size_t index) const;
+
+		// Constant index: out of range is a compile-time error, no runtime check
+		template <size_t I>
+		T& get();
+		template <size_t I>
+		STATICARRAY_CONSTEXPR T const & get() const;
+
+		STATICARRAY_CONSTEXPR size_t size() const;
+		STATICARRAY_CONSTEXPR bool empty() const;
+
+		T* data();
+		STATICARRAY_CONSTEXPR T const * data() const;
+		T* begin();
+		STATICARRAY_CONSTEXPR T const * begin() const;
+		T* end();
+		STATICARRAY_CONSTEXPR T const * end() const;
+
+		// Non-owning views (see ../ex01/ArrayView.hpp)
+		operator ArrayView<T>();
+		operator ArrayView<T const>() const;
+		ArrayView<T> view();
+		ArrayView<T const> view() const;
+
+		void fill(T const & value);
+		void swap(StaticArray& other);
+
+		class OutOfBoundsException : public std::exception
+		{
+			public:
+				virtual const char* what() const throw()
+				{
+					return "Error: Index out of bounds";
+				}
+		};
+};
+
+// iter and the whatever.hpp templates on whole StaticArrays. Up to
+// StaticDetail::UNROLL_LIMIT elements the loops are unrolled at compile
+// time (one call per element, constant indices); larger arrays use the
+// plain loops and the vector range versions.
+//   iter(arr, func);
+//   swap(a, b);                          // element-wise
+//   StaticArray<int, 4> lo = min(a, b);  // lo[i] = min(a[i], b[i])
+//   minmax_element(a);                   // first smallest, last largest
+template <typename T, size_t N, typename F>
+void iter(StaticArray<T, N>& array, F func);
+template <typename T, size_t N, typename F>
+void iter(StaticArray<T, N> const & array, F func);
+
+template <typename T, size_t N>
+void swap(StaticArray<T, N>& a, StaticArray<T, N>& b);
+template <typename T, size_t N>
+StaticArray<T, N> min(StaticArray<T, N> const & a, StaticArray<T, N> const & b);
+template <typename T, size_t N>
+StaticArray<T, N> max(StaticArray<T, N> const & a, StaticArray<T, N> const & b);
+template <typename T, size_t N>
+std::pair<T const *, T const *> minmax_element(StaticArray<T, N> const & array);
+
+#include "StaticArray.tpp"
+
+#endif
@@ -0,0 +1,365 @@
+#ifndef STATICARRAY_TPP
+#define STATICARRAY_TPP
+
+#include "StaticArray.hpp"
+
+namespace StaticDetail
+{
+	// Largest N whose loops are unrolled
+	size_t const UNROLL_LIMIT = 16;
+
+	// Instantiating value with I >= N fails to compile (negative array size)
+	template <size_t I, size_t N>
+	struct CheckedIndex
+	{
+		typedef char InRange[I < N ? 1 : -1];
+		static size_t const value = I;
+	};
+
+	// Elements [I, N), one statement each, recursion resolved at compile time
+	template <size_t I, size_t N>
+	struct Unrolled
+	{
+		typedef Unrolled<I + 1, N> Next;
+
+		template <typename T, typename F>
+		static void each(T* a, F& func)
+		{
+			func(a[I]);
+			Next::each(a, func);
+		}
+
+		template <typename T>
+		static void swap(T* a, T* b)
+		{
+			::swap(a[I], b[I]);
+			Next::swap(a, b);
+		}
+
+		template <typename T>
+		static void min(T const * a, T const * b, T* out)
+		{
+			out[I] = ::min(a[I], b[I]);
+			Next::min(a, b, out);
+		}
+
+		template <typename T>
+		static void max(T const * a, T const * b, T* out)
+		{
+			out[I] = ::max(a[I], b[I]);
+			Next::max(a, b, out);
+		}
+
+		// Same tie rules as the range version: first smallest, last largest
+		template <typename T>
+		static void minmax(T const * a, size_t& lo, size_t& hi)
+		{
+			if (a[I] < a[lo])
+				lo = I;
+			if (!(a[I] < a[hi]))
+				hi = I;
+			Next::minmax(a, lo, hi);
+		}
+	};
+
+	template <size_t N>
+	struct Unrolled<N, N>
+	{
+		template <typename T, typename F>
+		static void each(T*, F&) {}
+		template <typename T>
+		static void swap(T*, T*) {}
+		template <typename T>
+		static void min(T const *, T const *, T*) {}
+		template <typename T>
+		static void max(T const *, T const *, T*) {}
+		template <typename T>
+		static void minmax(T const *, size_t&, size_t&) {}
+	};
+
+	// Small N: unrolled
+	template <typename T, size_t N, bool = (N <= UNROLL_LIMIT)>
+	struct Ops
+	{
+		template <typename U, typename F>
+		static void each(U* a, F& func)
+		{
+			Unrolled<0, N>::each(a, func);
+		}
+
+		static void swap(T* a, T* b)
+		{
+			Unrolled<0, N>::swap(a, b);
+		}
+
+		static void min(T const * a, T const * b, T* out)
+		{
+			Unrolled<0, N>::min(a, b, out);
+		}
+
+		static void max(T const * a, T const * b, T* out)
+		{
+			Unrolled<0, N>::max(a, b, out);
+		}
+
+		static std::pair<size_t, size_t> minmax(T const * a)
+		{
+			size_t lo = 0;
+			size_t hi = 0;
+			Unrolled<1, N>::minmax(a, lo, hi);
+			return std::make_pair(lo, hi);
+		}
+	};
+
+	// Large N: the runtime-length versions
+	template <typename T, size_t N>
+	struct Ops<T, N, false>
+	{
+		template <typename U, typename F>
+		static void each(U* a, F& func)
+		{
+			for (size_t i = 0; i < N; i++)
+				func(a[i]);
+		}
+
+		static void swap(T* a, T* b)
+		{
+			::swap_ranges(a, b, N);
+		}
+
+		static void min(T const * a, T const * b, T* out)
+		{
+			::min(a, b, out, N);
+		}
+
+		static void max(T const * a, T const * b, T* out)
+		{
+			::max(a, b, out, N);
+		}
+
+		static std::pair<size_t, size_t> minmax(T const * a)
+		{
+			return WhateverDetail::Ranges<T>::minmax(a, N);
+		}
+	};
+}
+
+template <typename T, size_t N>
+size_t const StaticArray<T, N>::SIZE;
+
+// ==================== Construction ====================
+
+template <typename T, size_t N>
+STATICARRAY_CONSTEXPR StaticArray<T, N>::StaticArray() : _data()
+{
+}
+
+template <typename T, size_t N>
+StaticArray<T, N>::StaticArray(UninitializedTag)
+{
+}
+
+template <typename T, size_t N>
+StaticArray<T, N>::StaticArray(T const (&values)[N])
+{
+	for (size_t i = 0; i < N; i++)
+		_data[i] = values[i];
+}
+
+#if __cplusplus >= 201103L
+template <typename T, size_t N>
+constexpr StaticArray<T, N>::StaticArray(T const & first)
+	: _data{first}
+{
+}
+
+template <typename T, size_t N>
+template <typename... Rest>
+constexpr StaticArray<T, N>::StaticArray(T const & first, T const & second, Rest const &... rest)
+	: _data{first, second, static_cast<T>(rest)...}
+{
+	static_assert(sizeof...(Rest) + 2 <= N, "StaticArray: too many initializers");
+}
+#endif
+
+// ==================== Element access ====================
+
+template <typename T, size_t N>
+T& StaticArray<T, N>::operator[](size_t index)
+{
+	if (index >= N)
+		throw OutOfBoundsException();
+	return _data[index];
+}
+
+// A single expression, as C++11 constexpr requires. In a constant
+// expression an out-of-range index reaches the throw and fails to compile.
+template <typename T, size_t N>
+STATICARRAY_CONSTEXPR T const & StaticArray<T, N>::operator[](size_t index) const
+{
+	return (index < N) ? _data[index] : throw OutOfBoundsException();
+}
+
+template <typename T, size_t N>
+T& StaticArray<T, N>::at(size_t index)
+{
+	return (*this)[index];
+}
+
+template <typename T, size_t N>
+STATICARRAY_CONSTEXPR T const & StaticArray<T, N>::at(size_t index) const
+{
+	return (*this)[index];
+}
+
+template <typename T, size_t N>
+template <size_t I>
+T& StaticArray<T, N>::get()
+{
+	return _data[StaticDetail::CheckedIndex<I, N>::value];
+}
+
+template <typename T, size_t N>
+template <size_t I>
+STATICARRAY_CONSTEXPR T const & StaticArray<T, N>::get() const
+{
+	return _data[StaticDetail::CheckedIndex<I, N>::value];
+}
+
+// ==================== Size and raw access ====================
+
+template <typename T, size_t N>
+STATICARRAY_CONSTEXPR size_t StaticArray<T, N>::size() const
+{
+	return N;
+}
+
+template <typename T, size_t N>
+STATICARRAY_CONSTEXPR bool StaticArray<T, N>::empty() const
+{
+	return N == 0;
+}
+
+template <typename T, size_t N>
+T* StaticArray<T, N>::data()
+{
+	return _data;
+}
+
+template <typename T, size_t N>
+STATICARRAY_CONSTEXPR T const * StaticArray<T, N>::data() const
+{
+	return _data;
+}
+
+template <typename T, size_t N>
+T* StaticArray<T, N>::begin()
+{
+	return _data;
+}
+
+template <typename T, size_t N>
+STATICARRAY_CONSTEXPR T const * StaticArray<T, N>::begin() const
+{
+	return _data;
+}
+
+template <typename T, size_t N>
+T* StaticArray<T, N>::end()
+{
+	return _data + N;
+}
+
+template <typename T, size_t N>
+STATICARRAY_CONSTEXPR T const * StaticArray<T, N>::end() const
+{
+	return _data + N;
+}
+
+// ==================== Views ====================
+
+template <typename T, size_t N>
+StaticArray<T, N>::operator ArrayView<T>()
+{
+	return ArrayView<T>(_data, N);
+}
+
+template <typename T, size_t N>
+StaticArray<T, N>::operator ArrayView<T const>() const
+{
+	return ArrayView<T const>(_data, N);
+}
+
+template <typename T, size_t N>
+ArrayView<T> StaticArray<T, N>::view()
+{
+	return ArrayView<T>(_data, N);
+}
+
+template <typename T, size_t N>
+ArrayView<T const> StaticArray<T, N>::view() const
+{
+	return ArrayView<T const>(_data, N);
+}
+
+// ==================== Modifiers ====================
+
+template <typename T, size_t N>
+void StaticArray<T, N>::fill(T const & value)
+{
+	for (size_t i = 0; i < N; i++)
+		_data[i] = value;
+}
+
+template <typename T, size_t N>
+void StaticArray<T, N>::swap(StaticArray& other)
+{
+	StaticDetail::Ops<T, N>::swap(_data, other._data);
+}
+
+// ==================== iter and whatever ====================
+
+template <typename T, size_t N, typename F>
+void iter(StaticArray<T, N>& array, F func)
+{
+	StaticDetail::Ops<T, N>::each(array.data(), func);
+}
+
+template <typename T, size_t N, typename F>
+void iter(StaticArray<T, N> const & array, F func)
+{
+	StaticDetail::Ops<T, N>::each(array.data(), func);
+}
+
+template <typename T, size_t N>
+void swap(StaticArray<T, N>& a, StaticArray<T, N>& b)
+{
+	a.swap(b);
+}
+
+template <typename T, size_t N>
+StaticArray<T, N> min(StaticArray<T, N> const & a, StaticArray<T, N> const & b)
+{
+	StaticArray<T, N> result(uninitialized);
+	StaticDetail::Ops<T, N>::min(a.data(), b.data(), result.data());
+	return result;
+}
+
+template <typename T, size_t N>
+StaticArray<T, N> max(StaticArray<T, N> const & a, StaticArray<T, N> const & b)
+{
+	StaticArray<T, N> result(uninitialized);
+	StaticDetail::Ops<T, N>::max(a.data(), b.data(), result.data());
+	return result;
+}
+
+template <typename T, size_t N>
+std::pair<T const *, T const *> minmax_element(StaticArray<T, N> const & array)
+{
+	std::pair<size_t, size_t> found = StaticDetail::Ops<T, N>::minmax(array.data());
+	return std::make_pair(array.data() + found.first, array.data() + found.second);
+}
+
+#undef STATICARRAY_CONSTEXPR
+
+#endif
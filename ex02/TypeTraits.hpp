@@ -0,0 +1,77 @@
+#ifndef TYPETRAITS_HPP
+#define TYPETRAITS_HPP
+
+// Compile-time facts about element types, used by Array to pick cheaper
+// code paths. Built on compiler intrinsics (GCC/Clang) so they stay
+// available under -std=c++98, where <type_traits> does not exist.
+
+// Moving a T to a new address may be done by copying its bytes and
+// forgetting the original (no destructor call). True for every trivially
+// copyable type; other types opt in when they hold no pointer to
+// themselves and are not registered anywhere by address:
+//   template <> struct TriviallyRelocatable<Handle> { static bool const value = true; };
+// std::string must not: libstdc++ short strings point into themselves.
+template <typename T>
+struct TriviallyRelocatable
+{
+	static bool const value = __is_trivially_copyable(T);
+};
+
+// T() is all zero bytes: arithmetic types and object pointers. Class
+// types are left out (a null pointer-to-member is not zero bytes).
+template <typename T>
+struct ZeroInitializable
+{
+	static bool const value = false;
+};
+
+template <typename T>
+struct ZeroInitializable<T*>
+{
+	static bool const value = true;
+};
+
+#define TYPETRAITS_ZERO(T) \
+	template <> struct ZeroInitializable<T> { static bool const value = true; };
+TYPETRAITS_ZERO(bool)
+TYPETRAITS_ZERO(char)
+TYPETRAITS_ZERO(signed char)
+TYPETRAITS_ZERO(unsigned char)
+TYPETRAITS_ZERO(wchar_t)
+TYPETRAITS_ZERO(short)
+TYPETRAITS_ZERO(unsigned short)
+TYPETRAITS_ZERO(int)
+TYPETRAITS_ZERO(unsigned int)
+TYPETRAITS_ZERO(long)
+TYPETRAITS_ZERO(unsigned long)
+TYPETRAITS_ZERO(long long)
+TYPETRAITS_ZERO(unsigned long long)
+TYPETRAITS_ZERO(float)
+TYPETRAITS_ZERO(double)
+TYPETRAITS_ZERO(long double)
+#undef TYPETRAITS_ZERO
+
+template <typename T>
+struct TypeTraits
+{
+	// Copy/move/destroy are plain bitwise operations: they cannot throw
+	static bool const trivialCopy = __is_trivially_copyable(T);
+
+	// Default construction does nothing (no constructor code, no zeroing)
+	static bool const trivialDefault = __is_trivially_constructible(T);
+
+	// Growth may move elements with memcpy (see TriviallyRelocatable)
+	static bool const trivialRelocate = TriviallyRelocatable<T>::value;
+
+	// Value-initialization may be a memset to 0
+	static bool const zeroInit = ZeroInitializable<T>::value;
+};
+
+// Tag requesting storage whose elements will all be overwritten anyway:
+//   Array<int> buffer(n, uninitialized);
+// Trivially constructible elements are left indeterminate (no zero-fill
+// pass); other types are still default-constructed.
+struct UninitializedTag {};
+UninitializedTag const uninitialized = UninitializedTag();
+
+#endif
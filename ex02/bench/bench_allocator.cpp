@@ -0,0 +1,87 @@
+#include <pthread.h>
+#include <string>
+#include <sstream>
+#include "../Array.hpp"
+#include "../../bench/Bench.hpp"
+
+// Many short-lived small Arrays per "request", on 1..8 threads at once:
+// global new/delete versus a per-thread Arena or Pool reset after each request.
+
+static size_t const REQUESTS = 2000;
+static unsigned int const ARRAYS_PER_REQUEST = 64;
+
+// One request: build and drop small arrays (1 to 16 elements)
+template <typename Alloc>
+static void serveRequest(Alloc const & alloc)
+{
+	for (unsigned int i = 0; i < ARRAYS_PER_REQUEST; i++)
+	{
+		Array<int, Alloc> arr(i % 16 + 1, alloc);
+		arr[0] = static_cast<int>(i);
+		arr.push_back(1);
+		bench::doNotOptimize(arr[0]);
+	}
+}
+
+struct HeapWorker
+{
+	static void run()
+	{
+		for (size_t r = 0; r < REQUESTS; r++)
+			serveRequest(HeapAllocator());
+	}
+};
+
+template <typename Resource>
+struct ResourceWorker
+{
+	static void run()
+	{
+		Resource resource;
+		for (size_t r = 0; r < REQUESTS; r++)
+		{
+			serveRequest(ResourceAllocator<Resource>(resource));
+			resource.reset();
+		}
+	}
+};
+
+template <typename Worker>
+static void* threadMain(void*)
+{
+	Worker::run();
+	return NULL;
+}
+
+template <typename Worker>
+static void run(std::string const & name, int threads)
+{
+	pthread_t ids[8];
+	double start = bench::nowNs();
+	for (int t = 0; t < threads; t++)
+		pthread_create(&ids[t], NULL, threadMain<Worker>, NULL);
+	for (int t = 0; t < threads; t++)
+		pthread_join(ids[t], NULL);
+	double elapsed = bench::nowNs() - start;
+
+	double arrays = static_cast<double>(REQUESTS) * ARRAYS_PER_REQUEST * threads;
+	std::ostringstream label;
+	label << name << " (" << threads << " threads)";
+	std::ostringstream note;
+	note << std::fixed << std::setprecision(1) << arrays / elapsed * 1e3 << " M arrays/s";
+	bench::report(label.str(), elapsed / arrays, note.str());
+}
+
+int main(void)
+{
+	std::cout << "Array allocator benchmark (" << ARRAYS_PER_REQUEST
+		<< " arrays of 1-16 ints per request, ns per array)" << std::endl;
+	int const threadCounts[] = {1, 2, 4, 8};
+	for (size_t i = 0; i < sizeof(threadCounts) / sizeof(threadCounts[0]); i++)
+	{
+		run<HeapWorker>("HeapAllocator", threadCounts[i]);
+		run<ResourceWorker<Arena> >("ArenaAllocator", threadCounts[i]);
+		run<ResourceWorker<Pool> >("PoolAllocator", threadCounts[i]);
+	}
+	return 0;
+}
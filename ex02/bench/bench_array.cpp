@@ -0,0 +1,166 @@
+#include <string>
+#include <sstream>
+#include "../Array.hpp"
+#include "../../bench/Bench.hpp"
+
+// Regression suite for Array: construction, copy, assignment, growth and
+// element access, per element type and size. Results go through
+// bench::record (BENCH_FORMAT=text|csv|json).
+
+template <typename T> T value(size_t i) { return static_cast<T>(i % 1000); }
+template <> std::string value<std::string>(size_t i) { return std::string(1 + i % 16, 'x'); }
+
+template <typename T>
+struct DefaultConstruct
+{
+	void operator()()
+	{
+		Array<T> empty;
+		bench::doNotOptimize(empty.size());
+	}
+};
+
+template <typename T>
+struct SizeConstruct
+{
+	size_t n;
+	void operator()()
+	{
+		Array<T> values(n);
+		bench::doNotOptimize(values.data());
+	}
+};
+
+template <typename T>
+struct UninitializedConstruct
+{
+	size_t n;
+	void operator()()
+	{
+		Array<T> values(n, uninitialized);
+		bench::doNotOptimize(values.data());
+	}
+};
+
+template <typename T>
+struct CopyConstruct
+{
+	Array<T> const * src;
+	void operator()()
+	{
+		Array<T> copy(*src);
+		bench::doNotOptimize(copy.data());
+	}
+};
+
+// Same size on both sides: reuses the destination's storage
+template <typename T>
+struct CopyAssign
+{
+	Array<T> const *	src;
+	Array<T>*			dst;
+	void operator()()
+	{
+		*dst = *src;
+		bench::clobberMemory();
+	}
+};
+
+template <typename T>
+struct PushBack
+{
+	size_t n;
+	void operator()()
+	{
+		Array<T> values;
+		T const v = value<T>(7);
+		for (size_t i = 0; i < n; i++)
+			values.push_back(v);
+		bench::doNotOptimize(values.data());
+	}
+};
+
+// Sums through the checked operator[]
+template <typename T>
+struct IndexRead
+{
+	Array<T> const * src;
+	void operator()()
+	{
+		T total = T();
+		for (size_t i = 0; i < src->size(); i++)
+			total += (*src)[i];
+		bench::doNotOptimize(total);
+	}
+};
+
+template <typename T>
+struct IndexWrite
+{
+	Array<T>* dst;
+	void operator()()
+	{
+		for (size_t i = 0; i < dst->size(); i++)
+			(*dst)[i] = static_cast<T>(i);
+		bench::clobberMemory();
+	}
+};
+
+template <typename T>
+static void common(std::string const & suffix, size_t n, Array<T>& src, Array<T>& dst)
+{
+	DefaultConstruct<T> defaulted;
+	SizeConstruct<T> sized = {n};
+	CopyConstruct<T> copy = {&src};
+	CopyAssign<T> assign = {&src, &dst};
+	PushBack<T> pushBack = {n};
+	bench::run("array", "default construct" + suffix, 1, defaulted);
+	bench::run("array", "construct(n)" + suffix, n, sized);
+	bench::run("array", "copy construct" + suffix, n, copy);
+	bench::run("array", "copy assign" + suffix, n, assign);
+	bench::run("array", "push_back" + suffix, n, pushBack);
+}
+
+// Arithmetic element types: every case, including uninitialized storage
+// and operator[]
+template <typename T>
+static void suite(std::string const & type, size_t n)
+{
+	Array<T> src(n);
+	Array<T> dst(n);
+	for (size_t i = 0; i < n; i++)
+		src[i] = value<T>(i);
+	std::ostringstream suffix;
+	suffix << "<" << type << "> n=" << n;
+	common(suffix.str(), n, src, dst);
+	UninitializedConstruct<T> uninit = {n};
+	IndexRead<T> read = {&src};
+	IndexWrite<T> write = {&dst};
+	bench::run("array", "construct(n, uninitialized)" + suffix.str(), n, uninit);
+	bench::run("array", "operator[] read" + suffix.str(), n, read);
+	bench::run("array", "operator[] write" + suffix.str(), n, write);
+}
+
+static void stringSuite(size_t n)
+{
+	Array<std::string> src(n);
+	Array<std::string> dst(n);
+	for (size_t i = 0; i < n; i++)
+		src[i] = value<std::string>(i);
+	std::ostringstream suffix;
+	suffix << "<string> n=" << n;
+	common(suffix.str(), n, src, dst);
+}
+
+int main(void)
+{
+	bench::title("Array suite (median, p99, TSC cycles/element)");
+	size_t const sizes[] = {16, 1024, 1024 * 1024};
+	for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+	{
+		suite<int>("int", sizes[s]);
+		suite<double>("double", sizes[s]);
+		stringSuite(sizes[s] / 16 + 1);	// Heap-backed: fewer elements
+	}
+	return 0;
+}
@@ -0,0 +1,231 @@
+#include <new>
+#include <string>
+#include <sstream>
+#include "../Array.hpp"
+#include "../../bench/Bench.hpp"
+
+// Bulk paths versus the per-element loops Array used before, for each
+// element type and size:
+//   copy:       Array copy constructor     vs  new (dst + i) T(src[i])
+//   grow:       reserve(2n) (relocation)   vs  copy loop + destroy loop
+//   value-init: Array(n)                   vs  new (dst + i) T()
+//   fill:       resize(n, value)           vs  new (dst + i) T(value)
+// The loops run on raw buffers from operator new, like Array's storage.
+// Trivially copyable types take memcpy/memset; Number and std::string keep
+// the element loop on both sides, so their ratio should stay near 1.
+
+static size_t const BYTES_PER_RUN = 64u * 1024u * 1024u;
+
+struct Particle
+{
+	double	x, y, z;
+	float	mass;
+	int		id;
+};
+
+// User-defined copy: not trivially copyable
+class Number
+{
+	private:
+		int	_value;
+
+	public:
+		Number(int value = 0) : _value(value) {}
+		Number(Number const & src) : _value(src._value) {}
+		Number& operator=(Number const & rhs)
+		{
+			_value = rhs._value;
+			return *this;
+		}
+};
+
+template <typename T> T sample(size_t i) { return static_cast<T>(i % 100); }
+template <> Particle sample<Particle>(size_t i)
+{
+	Particle p = {static_cast<double>(i), 0, 0, 1.0f, static_cast<int>(i)};
+	return p;
+}
+template <> Number sample<Number>(size_t i) { return Number(static_cast<int>(i)); }
+template <> std::string sample<std::string>(size_t i) { return std::string(1 + i % 8, 'x'); }
+
+template <typename T>
+static T* rawBuffer(size_t n)
+{
+	return static_cast<T*>(::operator new(n * sizeof(T)));
+}
+
+template <typename T>
+static void destroyAll(T* p, size_t n)
+{
+	for (size_t i = 0; i < n; i++)
+		p[i].~T();
+	::operator delete(p);
+}
+
+// ==================== Element loops (previous behaviour) ====================
+
+template <typename T>
+struct LoopCopy
+{
+	Array<T> const & src;
+	LoopCopy(Array<T> const & s) : src(s) {}
+	void operator()()
+	{
+		T* dst = rawBuffer<T>(src.size());
+		for (size_t i = 0; i < src.size(); i++)
+			new (dst + i) T(src.data()[i]);
+		bench::doNotOptimize(dst);
+		destroyAll(dst, src.size());
+	}
+};
+
+template <typename T>
+struct LoopGrow
+{
+	Array<T> const & src;
+	LoopGrow(Array<T> const & s) : src(s) {}
+	void operator()()
+	{
+		size_t n = src.size();
+		T* old = rawBuffer<T>(n);
+		for (size_t i = 0; i < n; i++)
+			new (old + i) T(src.data()[i]);
+		T* grown = rawBuffer<T>(2 * n);
+		for (size_t i = 0; i < n; i++)
+			new (grown + i) T(old[i]);
+		destroyAll(old, n);
+		bench::doNotOptimize(grown);
+		destroyAll(grown, n);
+	}
+};
+
+template <typename T>
+struct LoopValueInit
+{
+	size_t n;
+	LoopValueInit(size_t count) : n(count) {}
+	void operator()()
+	{
+		T* dst = rawBuffer<T>(n);
+		for (size_t i = 0; i < n; i++)
+			new (dst + i) T();
+		bench::doNotOptimize(dst);
+		destroyAll(dst, n);
+	}
+};
+
+template <typename T>
+struct LoopFill
+{
+	size_t	n;
+	T		value;
+	LoopFill(size_t count, T const & v) : n(count), value(v) {}
+	void operator()()
+	{
+		T* dst = rawBuffer<T>(n);
+		for (size_t i = 0; i < n; i++)
+			new (dst + i) T(value);
+		bench::doNotOptimize(dst);
+		destroyAll(dst, n);
+	}
+};
+
+// ==================== Array (bulk paths) ====================
+
+template <typename T>
+struct ArrayCopy
+{
+	Array<T> const & src;
+	ArrayCopy(Array<T> const & s) : src(s) {}
+	void operator()()
+	{
+		Array<T> copy(src);
+		bench::doNotOptimize(copy.data());
+	}
+};
+
+// Same work as LoopGrow: build a copy, then relocate it to twice the room
+template <typename T>
+struct ArrayGrow
+{
+	Array<T> const & src;
+	ArrayGrow(Array<T> const & s) : src(s) {}
+	void operator()()
+	{
+		Array<T> copy(src);
+		copy.reserve(2 * src.size());
+		bench::doNotOptimize(copy.data());
+	}
+};
+
+template <typename T>
+struct ArrayValueInit
+{
+	size_t n;
+	ArrayValueInit(size_t count) : n(count) {}
+	void operator()()
+	{
+		Array<T> values(n);
+		bench::doNotOptimize(values.data());
+	}
+};
+
+template <typename T>
+struct ArrayFill
+{
+	size_t	n;
+	T		value;
+	ArrayFill(size_t count, T const & v) : n(count), value(v) {}
+	void operator()()
+	{
+		Array<T> values;
+		values.resize(n, value);
+		bench::doNotOptimize(values.data());
+	}
+};
+
+template <typename Loop, typename Bulk>
+static void compare(std::string const & op, std::string const & type, size_t n, size_t bytes,
+	Loop loop, Bulk bulk)
+{
+	size_t iterations = BYTES_PER_RUN / bytes;
+	if (iterations == 0)
+		iterations = 1;
+	double loopNs = bench::measure(loop, iterations);
+	double bulkNs = bench::measure(bulk, iterations);
+	std::ostringstream label;
+	label << op << " " << type << " n=" << n;
+	std::ostringstream note;
+	note << std::fixed << std::setprecision(1) << "loop " << loopNs << " ns, x"
+		<< std::setprecision(2) << loopNs / bulkNs;
+	bench::report(label.str(), bulkNs, note.str());
+}
+
+template <typename T>
+static void runType(std::string const & type, size_t n)
+{
+	Array<T> src(n);
+	for (size_t i = 0; i < n; i++)
+		src[i] = sample<T>(i);
+	size_t bytes = n * sizeof(T);
+	compare("copy      ", type, n, bytes, LoopCopy<T>(src), ArrayCopy<T>(src));
+	compare("grow      ", type, n, bytes, LoopGrow<T>(src), ArrayGrow<T>(src));
+	compare("value-init", type, n, bytes, LoopValueInit<T>(n), ArrayValueInit<T>(n));
+	compare("fill      ", type, n, bytes, LoopFill<T>(n, sample<T>(7)), ArrayFill<T>(n, sample<T>(7)));
+}
+
+int main(void)
+{
+	std::cout << "Bulk copy paths (Array ns/op, then the element loop and the speedup)" << std::endl;
+	size_t const sizes[] = {16, 1024, 1024 * 1024};
+	for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+	{
+		runType<char>("char", sizes[s]);
+		runType<int>("int", sizes[s]);
+		runType<double>("double", sizes[s]);
+		runType<Particle>("Particle", sizes[s]);
+		runType<Number>("Number", sizes[s]);
+		runType<std::string>("string", sizes[s]);
+	}
+	return 0;
+}
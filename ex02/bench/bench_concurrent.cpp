@@ -0,0 +1,94 @@
+#include <pthread.h>
+#include <string>
+#include <sstream>
+#include "../Array.hpp"
+#include "../ConcurrentArray.hpp"
+#include "../../bench/Bench.hpp"
+
+// Multi-producer append throughput: one Array guarded by a mutex (the
+// current pattern, copy-growing under the lock) versus ConcurrentArray's
+// lock-free push_back. 4M appends in total, split across the producers.
+// On a machine with fewer cores than producers the threads time-share,
+// which still shows lock hand-offs and preempted lock holders; on a
+// single core an uncontended mutex is cheap and the three atomic RMWs of
+// the lock-free path (claim, ready flag, publish) cost more.
+
+static size_t const TOTAL = 4u * 1024u * 1024u;
+static int const REPETITIONS = 3;
+
+struct LockedArray
+{
+	pthread_mutex_t	mutex;
+	Array<long>		values;
+	LockedArray() { pthread_mutex_init(&mutex, NULL); }
+	~LockedArray() { pthread_mutex_destroy(&mutex); }
+	void push_back(long v)
+	{
+		pthread_mutex_lock(&mutex);
+		values.push_back(v);
+		pthread_mutex_unlock(&mutex);
+	}
+};
+
+template <typename Target>
+struct Job
+{
+	Target*	target;
+	size_t	count;
+};
+
+template <typename Target>
+static void* produce(void* arg)
+{
+	Job<Target>* job = static_cast<Job<Target>*>(arg);
+	for (size_t i = 0; i < job->count; i++)
+		job->target->push_back(static_cast<long>(i));
+	return NULL;
+}
+
+// Best wall time (ns) of REPETITIONS runs, each on a fresh container
+template <typename Target>
+static double run(int producers)
+{
+	double best = 0;
+	for (int r = 0; r < REPETITIONS; r++)
+	{
+		Target target;
+		pthread_t threads[16];
+		Job<Target> jobs[16];
+		double start = bench::nowNs();
+		for (int t = 0; t < producers; t++)
+		{
+			jobs[t].target = &target;
+			jobs[t].count = TOTAL / producers;
+			pthread_create(&threads[t], NULL, produce<Target>, &jobs[t]);
+		}
+		for (int t = 0; t < producers; t++)
+			pthread_join(threads[t], NULL);
+		double ns = bench::nowNs() - start;
+		if (r == 0 || ns < best)
+			best = ns;
+	}
+	return best;
+}
+
+static void report(std::string const & name, int producers, double ns)
+{
+	std::ostringstream label;
+	label << name << " (" << producers << " producer" << (producers > 1 ? "s" : "") << ")";
+	std::ostringstream note;
+	note << std::fixed << std::setprecision(1) << TOTAL / (ns / 1e9) / 1e6 << " M appends/s";
+	bench::report(label.str(), ns / TOTAL, note.str());
+}
+
+int main(void)
+{
+	std::cout << "Concurrent append benchmark (" << TOTAL << " appends)" << std::endl;
+	int const counts[] = {1, 2, 4, 8};
+	for (int c = 0; c < 4; c++)
+	{
+		report("mutex + Array::push_back", counts[c], run<LockedArray>(counts[c]));
+		report("ConcurrentArray::push_back", counts[c], run<ConcurrentArray<long> >(counts[c]));
+	}
+	return 0;
+}
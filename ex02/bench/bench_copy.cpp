@@ -0,0 +1,92 @@
+#include <string>
+#include <sstream>
+#include "../Array.hpp"
+#include "../../bench/Bench.hpp"
+#include "../../bench/AllocCounter.hpp"
+
+// Copy / assign / move throughput of Array<T>, with heap traffic per operation.
+// Build with `make bench` (C++98, swap fallback) or `make bench STD=c++11`.
+
+static unsigned int const SIZE = 1024;
+static size_t const ITERATIONS = 20000;
+
+template <typename T>
+struct CopyAssignSameSize
+{
+	Array<T>&		dst;
+	Array<T> const&	src;
+	CopyAssignSameSize(Array<T>& d, Array<T> const & s) : dst(d), src(s) {}
+	void operator()() { dst = src; bench::doNotOptimize(dst); }
+};
+
+template <typename T>
+struct CopyConstruct
+{
+	Array<T> const&	src;
+	CopyConstruct(Array<T> const & s) : src(s) {}
+	void operator()() { Array<T> copy(src); bench::doNotOptimize(copy); }
+};
+
+// Hand an array back and forth without copying its elements
+template <typename T>
+struct Transfer
+{
+	Array<T>&	a;
+	Array<T>&	b;
+	Transfer(Array<T>& x, Array<T>& y) : a(x), b(y) {}
+	void operator()()
+	{
+#if __cplusplus >= 201103L
+		b = std::move(a);
+		a = std::move(b);
+#else
+		swap(a, b);
+		swap(a, b);
+#endif
+		bench::doNotOptimize(a);
+	}
+};
+
+template <typename F>
+static void run(std::string const & name, F f)
+{
+	bench::resetAllocStats();
+	double ns = bench::measure(f, ITERATIONS);
+	bench::AllocStats const & s = bench::allocStats();
+	size_t calls = ITERATIONS * 5;
+	std::ostringstream note;
+	note << std::fixed << std::setprecision(2) << static_cast<double>(s.allocs) / calls << " allocs/op, "
+		<< static_cast<double>(s.bytes) / calls << " bytes/op";
+	bench::report(name, ns, note.str());
+}
+
+int main(void)
+{
+	std::cout << "Array copy/assign benchmark (n = " << SIZE << ", "
+#if __cplusplus >= 201103L
+		<< "C++11 move"
+#else
+		<< "C++98 swap fallback"
+#endif
+		<< ")" << std::endl;
+
+	{
+		Array<int> src(SIZE);
+		Array<int> dst(SIZE);
+		Array<int> other;
+		run("Array<int> operator= (same size)", CopyAssignSameSize<int>(dst, src));
+		run("Array<int> copy constructor", CopyConstruct<int>(src));
+		run("Array<int> move/swap round-trip", Transfer<int>(dst, other));
+	}
+	{
+		Array<std::string> src(SIZE);
+		for (unsigned int i = 0; i < SIZE; i++)
+			src[i] = "a string long enough to live on the heap";
+		Array<std::string> dst(SIZE);
+		Array<std::string> other;
+		run("Array<string> operator= (same size)", CopyAssignSameSize<std::string>(dst, src));
+		run("Array<string> copy constructor", CopyConstruct<std::string>(src));
+		run("Array<string> move/swap round-trip", Transfer<std::string>(dst, other));
+	}
+	return 0;
+}
@@ -0,0 +1,144 @@
+#include <string>
+#include <sstream>
+#include "../Array.hpp"
+#include "../ArrayExpr.hpp"
+#include "../../bench/Bench.hpp"
+#include "../../bench/AllocCounter.hpp"
+
+// c = a * 2 + b over floats, at cache-resident and memory-bound sizes:
+//   naive temporaries: each operation returns a new Array (zero-filled,
+//                      then written by a plain loop), and c = copies the
+//                      last one
+//   expression:        the fused loop built by ArrayExpr.hpp
+//   hand-written loop: the lower bound
+//   in place:          a = a * 1 + b, then a = a - b (the target is an
+//                      operand), per assignment
+//   parallel:          evaluate(par, ...) on a 4-thread pool
+
+static size_t const TOTAL = 64u * 1024u * 1024u;	// Elements per measurement
+
+// What c = a * 2 + b costs without expression templates
+static Array<float> times(Array<float> const & a, float s)
+{
+	Array<float> result(a.size());
+	float* out = result.data();
+	for (size_t i = 0; i < a.size(); i++)
+		out[i] = a.data()[i] * s;
+	return result;
+}
+
+static Array<float> plus(Array<float> const & a, Array<float> const & b)
+{
+	Array<float> result(a.size());
+	float* out = result.data();
+	for (size_t i = 0; i < a.size(); i++)
+		out[i] = a.data()[i] + b.data()[i];
+	return result;
+}
+
+struct Operands
+{
+	Array<float> a, b, c;
+	Operands(size_t n) : a(n), b(n), c(n)
+	{
+		for (size_t i = 0; i < n; i++)
+		{
+			a[i] = static_cast<float>(i % 100);
+			b[i] = 1.0f;
+		}
+	}
+};
+
+struct Naive
+{
+	Operands& o;
+	Naive(Operands& operands) : o(operands) {}
+	void operator()()
+	{
+		o.c = plus(times(o.a, 2.0f), o.b);
+		bench::clobberMemory();
+	}
+};
+
+struct Expression
+{
+	Operands& o;
+	Expression(Operands& operands) : o(operands) {}
+	void operator()()
+	{
+		o.c = o.a * 2.0f + o.b;
+		bench::clobberMemory();
+	}
+};
+
+struct Loop
+{
+	Operands& o;
+	Loop(Operands& operands) : o(operands) {}
+	void operator()()
+	{
+		float* c = o.c.data();
+		float const * a = o.a.data();
+		float const * b = o.b.data();
+		for (size_t i = 0; i < o.c.size(); i++)
+			c[i] = a[i] * 2.0f + b[i];
+		bench::clobberMemory();
+	}
+};
+
+// Multiplying by 1 keeps the values stable across iterations
+struct InPlace
+{
+	Operands& o;
+	InPlace(Operands& operands) : o(operands) {}
+	void operator()()
+	{
+		o.a = o.a * 1.0f + o.b;
+		o.a = o.a - o.b;
+		bench::clobberMemory();
+	}
+};
+
+struct Parallel
+{
+	Operands&	o;
+	ThreadPool&	pool;
+	Parallel(Operands& operands, ThreadPool& p) : o(operands), pool(p) {}
+	void operator()()
+	{
+		evaluate(ParallelPolicy(0, &pool), o.c, o.a * 2.0f + o.b);
+		bench::clobberMemory();
+	}
+};
+
+template <typename F>
+static void run(std::string const & name, size_t n, F f, int assignments = 1)
+{
+	size_t iterations = TOTAL / n;
+	bench::resetAllocStats();
+	double ns = bench::measure(f, iterations) / assignments;
+	std::ostringstream label;
+	label << name << " (n = " << n << ")";
+	std::ostringstream note;
+	note << std::fixed << std::setprecision(2) << ns / n << " ns/element, "
+		<< std::setprecision(1)
+		<< static_cast<double>(bench::allocStats().allocs) / (iterations * 5 * assignments) << " allocs";
+	bench::report(label.str(), ns, note.str());
+}
+
+int main(void)
+{
+	std::cout << "Expression template benchmark (c = a * 2 + b, float)" << std::endl;
+	ThreadPool pool(4);
+	size_t const sizes[] = {1024, 1024 * 1024, 16 * 1024 * 1024};
+	for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+	{
+		Operands o(sizes[s]);
+		run("naive temporaries", sizes[s], Naive(o));
+		run("expression", sizes[s], Expression(o));
+		run("hand-written loop", sizes[s], Loop(o));
+		run("expression in place", sizes[s], InPlace(o), 2);
+		run("expression, 4 threads", sizes[s], Parallel(o, pool));
+	}
+	return 0;
+}
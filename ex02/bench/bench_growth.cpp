@@ -0,0 +1,73 @@
+#include <string>
+#include <sstream>
+#include "../Array.hpp"
+#include "../../bench/Bench.hpp"
+#include "../../bench/AllocCounter.hpp"
+
+// Incremental construction of an n-element Array: geometric push_back growth,
+// push_back after reserve(), and the old copy-into-a-bigger-Array approach.
+
+static size_t const ITERATIONS = 20;
+
+struct PushBack
+{
+	unsigned int	n;
+	bool			reserveFirst;
+	PushBack(unsigned int count, bool reserve) : n(count), reserveFirst(reserve) {}
+	void operator()()
+	{
+		Array<int> arr;
+		if (reserveFirst)
+			arr.reserve(n);
+		for (unsigned int i = 0; i < n; i++)
+			arr.push_back(static_cast<int>(i));
+		bench::doNotOptimize(arr);
+	}
+};
+
+// What callers had to do before Array could grow: copy into size + 1
+struct CopyGrow
+{
+	unsigned int	n;
+	CopyGrow(unsigned int count) : n(count) {}
+	void operator()()
+	{
+		Array<int> arr;
+		for (unsigned int i = 0; i < n; i++)
+		{
+			Array<int> bigger(arr.size() + 1);
+			for (unsigned int j = 0; j < arr.size(); j++)
+				bigger[j] = arr[j];
+			bigger[i] = static_cast<int>(i);
+			arr.swap(bigger);
+		}
+		bench::doNotOptimize(arr);
+	}
+};
+
+template <typename F>
+static void run(std::string const & name, F f)
+{
+	bench::resetAllocStats();
+	double ns = bench::measure(f, ITERATIONS);
+	std::ostringstream note;
+	note << std::fixed << std::setprecision(1)
+		<< static_cast<double>(bench::allocStats().allocs) / (ITERATIONS * 5) << " allocs/build";
+	bench::report(name, ns, note.str());
+}
+
+int main(void)
+{
+	std::cout << "Array growth benchmark (time to build n ints)" << std::endl;
+	unsigned int const sizes[] = {1000, 10000, 100000};
+	for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+	{
+		std::ostringstream suffix;
+		suffix << " (n = " << sizes[s] << ")";
+		run("push_back, geometric growth" + suffix.str(), PushBack(sizes[s], false));
+		run("push_back after reserve" + suffix.str(), PushBack(sizes[s], true));
+		if (sizes[s] <= 10000)
+			run("copy into size + 1 (before)" + suffix.str(), CopyGrow(sizes[s]));
+	}
+	return 0;
+}
@@ -0,0 +1,141 @@
+#include <fstream>
+#include <string>
+#include <sstream>
+#include <linux/perf_event.h>
+#include "../Array.hpp"
+#include "../../bench/Bench.hpp"
+#include "../../bench/PerfCounter.hpp"
+
+// Random access over a 512 MiB array backed by regular 4 KiB pages
+// (HeapAllocator) versus transparent huge pages (HugePageAllocator).
+// A 4 KiB-page TLB covers a few MiB at most, so nearly every random access
+// misses it; 2 MiB pages cut the page walks. The pointer chase measures
+// latency (each load depends on the previous one), the gather measures
+// throughput (independent loads). The sequential scan is the control.
+// dTLB misses come from perf_event_open when the kernel allows it.
+
+static size_t const COUNT = 64u * 1024u * 1024u;		// 512 MiB of size_t
+static size_t const ACCESSES = 4u * 1024u * 1024u;
+static size_t const ITERATIONS = 1;
+
+// Single-cycle random permutation (Sattolo): following next[i] visits
+// every element once, in an order the prefetchers cannot guess
+static void buildCycle(Array<size_t>& next)
+{
+	for (size_t i = 0; i < next.size(); i++)
+		next[i] = i;
+	unsigned long long state = 88172645463325252ull;
+	for (size_t i = next.size() - 1; i > 0; i--)
+	{
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		size_t j = static_cast<size_t>(state % i);
+		size_t tmp = next[i];
+		next[i] = next[j];
+		next[j] = tmp;
+	}
+}
+
+// Kernel's huge-page usage for this process, in MiB
+static size_t anonHugeMiB()
+{
+	std::ifstream smaps("/proc/self/smaps_rollup");
+	std::string key;
+	size_t kib;
+	while (smaps >> key)
+	{
+		if (key == "AnonHugePages:" && smaps >> kib)
+			return kib / 1024;
+		smaps.ignore(256, '\n');
+	}
+	return 0;
+}
+
+template <typename A>
+struct Chase
+{
+	A const & next;
+	Chase(A const & n) : next(n) {}
+	void operator()()
+	{
+		size_t i = 0;
+		for (size_t k = 0; k < ACCESSES; k++)
+			i = next.data()[i];
+		bench::doNotOptimize(i);
+	}
+};
+
+template <typename A>
+struct Gather
+{
+	A const & values;
+	Gather(A const & v) : values(v) {}
+	void operator()()
+	{
+		size_t const * p = values.data();
+		size_t total = 0;
+		size_t index = 12345;
+		for (size_t k = 0; k < ACCESSES; k++)
+		{
+			index = (index * 6364136223846793005ull + 1442695040888963407ull) >> 1;
+			total += p[index % COUNT];
+		}
+		bench::doNotOptimize(total);
+	}
+};
+
+template <typename A>
+struct Scan
+{
+	A const & values;
+	Scan(A const & v) : values(v) {}
+	void operator()()
+	{
+		size_t const * p = values.data();
+		size_t total = 0;
+		for (size_t k = 0; k < COUNT; k++)
+			total += p[k];
+		bench::doNotOptimize(total);
+	}
+};
+
+template <typename F>
+static void run(std::string const & name, F f, size_t accesses)
+{
+	bench::PerfCounter misses(PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB
+		| (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+	misses.start();
+	double ns = bench::measure(f, ITERATIONS);
+	unsigned long long count = misses.stop();
+	std::ostringstream note;
+	note << std::fixed << std::setprecision(2) << ns / accesses << " ns/access";
+	if (misses.available())
+		note << ", " << static_cast<double>(count) / (accesses * ITERATIONS * 5) << " dTLB misses/access";
+	else
+		note << ", dTLB counter unavailable";
+	bench::report(name, ns, note.str());
+}
+
+template <typename Alloc>
+static void runAll(std::string const & label, Array<size_t> const & cycle)
+{
+	size_t before = anonHugeMiB();
+	Array<size_t, Alloc> next(COUNT, uninitialized);
+	for (size_t i = 0; i < COUNT; i++)
+		next[i] = cycle[i];
+	std::cout << label << ": " << anonHugeMiB() - before << " MiB in huge pages" << std::endl;
+	run("pointer chase, " + label, Chase<Array<size_t, Alloc> >(next), ACCESSES);
+	run("random gather, " + label, Gather<Array<size_t, Alloc> >(next), ACCESSES);
+	run("sequential scan, " + label, Scan<Array<size_t, Alloc> >(next), COUNT);
+}
+
+int main(void)
+{
+	std::cout << "Huge page benchmark (512 MiB, " << ACCESSES << " random accesses)" << std::endl;
+	Array<size_t> cycle(COUNT, uninitialized);
+	buildCycle(cycle);
+	runAll<HeapAllocator>("4 KiB pages", cycle);
+	runAll<HugePageAllocator>("huge pages", cycle);
+	return 0;
+}
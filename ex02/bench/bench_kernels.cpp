@@ -0,0 +1,136 @@
+#include <string>
+#include <sstream>
+#include "../Kernels.hpp"
+#include "../../bench/Bench.hpp"
+
+// Throughput of the bulk kernels at every supported instruction-set level,
+// in cache (64 KiB per array) and from memory (64 MiB per array). GB/s
+// counts every byte read and written by the kernel. The "operator[] loop"
+// rows are the checked scalar loop the kernels replace.
+
+static size_t const SMALL = 16 * 1024;
+static size_t const LARGE = 16 * 1024 * 1024;
+
+// Read at run time so x * 1 and y + 0 * x cannot be folded away
+static volatile int one = 1;
+static volatile int zero = 0;
+
+template <typename T>
+struct Buffers
+{
+	Array<T>	x;
+	Array<T>	y;
+	size_t		n;
+	Buffers(size_t count) : x(count), y(count), n(count)
+	{
+		for (size_t i = 0; i < n; i++)
+		{
+			x[i] = static_cast<T>(i % 97);
+			y[i] = static_cast<T>(i % 89);
+		}
+	}
+};
+
+template <typename T>
+struct FillOp
+{
+	Buffers<T>& b;
+	FillOp(Buffers<T>& buffers) : b(buffers) {}
+	void operator()() { Kernels::fill(b.y.data(), b.n, static_cast<T>(1)); bench::clobberMemory(); }
+	static double bytes() { return sizeof(T); }
+};
+
+template <typename T>
+struct ScaleOp
+{
+	Buffers<T>& b;
+	ScaleOp(Buffers<T>& buffers) : b(buffers) {}
+	void operator()() { Kernels::scale(b.y.data(), b.n, static_cast<T>(one)); bench::clobberMemory(); }
+	static double bytes() { return 2 * sizeof(T); }
+};
+
+template <typename T>
+struct AxpyOp
+{
+	Buffers<T>& b;
+	AxpyOp(Buffers<T>& buffers) : b(buffers) {}
+	void operator()() { Kernels::axpy(b.y.data(), b.x.data(), b.n, static_cast<T>(zero)); bench::clobberMemory(); }
+	static double bytes() { return 3 * sizeof(T); }
+};
+
+template <typename T>
+struct SumOp
+{
+	Buffers<T>& b;
+	SumOp(Buffers<T>& buffers) : b(buffers) {}
+	void operator()() { bench::doNotOptimize(Kernels::sum(b.x.data(), b.n)); }
+	static double bytes() { return sizeof(T); }
+};
+
+template <typename T>
+struct MinOp
+{
+	Buffers<T>& b;
+	MinOp(Buffers<T>& buffers) : b(buffers) {}
+	void operator()() { bench::doNotOptimize(Kernels::minValue(b.x.data(), b.n)); }
+	static double bytes() { return sizeof(T); }
+};
+
+// Baseline: the bounds-checked loop over operator[]
+template <typename T>
+struct IndexedSum
+{
+	Buffers<T>& b;
+	IndexedSum(Buffers<T>& buffers) : b(buffers) {}
+	void operator()()
+	{
+		T total = T();
+		for (unsigned int i = 0; i < b.x.size(); i++)
+			total += b.x[i];
+		bench::doNotOptimize(total);
+	}
+	static double bytes() { return sizeof(T); }
+};
+
+template <typename Op, typename T>
+static void run(std::string const & name, Buffers<T>& buffers)
+{
+	Op op(buffers);
+	size_t iterations = (buffers.n == SMALL) ? 2000 : 3;
+	double ns = bench::measure(op, iterations);
+	std::ostringstream note;
+	note << std::fixed << std::setprecision(2) << Op::bytes() * buffers.n / ns << " GB/s";
+	bench::report(name, ns, note.str());
+}
+
+template <typename T>
+static void runAll(std::string const & type, size_t n)
+{
+	Buffers<T> buffers(n);
+	std::string size = (n == SMALL) ? "16K" : "16M";
+	std::cout << "-- " << type << ", n = " << size << std::endl;
+	run<IndexedSum<T> >("operator[] loop sum", buffers);
+	for (int l = Kernels::SCALAR; l <= Kernels::supportedLevel(); l++)
+	{
+		Kernels::setLevel(static_cast<Kernels::Level>(l));
+		std::string level = Kernels::levelName(Kernels::level());
+		run<FillOp<T> >(level + " fill", buffers);
+		run<ScaleOp<T> >(level + " scale", buffers);
+		run<AxpyOp<T> >(level + " axpy", buffers);
+		run<SumOp<T> >(level + " sum", buffers);
+		run<MinOp<T> >(level + " min", buffers);
+	}
+	Kernels::setLevel(Kernels::supportedLevel());
+}
+
+int main(void)
+{
+	std::cout << "Bulk kernel benchmark (CPU supports "
+		<< Kernels::levelName(Kernels::supportedLevel()) << ")" << std::endl;
+	runAll<float>("float", SMALL);
+	runAll<double>("double", SMALL);
+	runAll<int>("int", SMALL);
+	runAll<float>("float", LARGE);
+	runAll<double>("double", LARGE);
+	return 0;
+}
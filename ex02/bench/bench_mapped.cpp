@@ -0,0 +1,149 @@
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstdio>
+#include <string>
+#include <sstream>
+#include "../Array.hpp"
+#include "../MappedArray.hpp"
+#include "../../bench/Bench.hpp"
+
+// Loading a 256 MiB binary file of ints: read() into an Array (zero-filled
+// or uninitialized) versus mapping it with MappedArray. "Cold" runs evict
+// the file from the page cache first (posix_fadvise DONTNEED), "warm" runs
+// find it cached. Each line reports the time until the data is usable and
+// the time to also scan every element (or to do 10k random lookups).
+
+static char const * const PATH = "bench_mapped.bin";
+static unsigned int const COUNT = 64u * 1024u * 1024u;
+static unsigned int const LOOKUPS = 10000;
+static int const REPETITIONS = 3;
+
+static void writeFile()
+{
+	Array<int> values(1u << 20, uninitialized);
+	for (unsigned int i = 0; i < values.size(); i++)
+		values[i] = static_cast<int>(i);
+	int fd = ::open(PATH, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	for (unsigned int written = 0; written < COUNT; written += values.size())
+		if (::write(fd, values.data(), values.size() * sizeof(int)) < 0)
+			break;
+	::fsync(fd);
+	::close(fd);
+}
+
+static void dropCache()
+{
+	int fd = ::open(PATH, O_RDONLY);
+	::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+	::close(fd);
+}
+
+static void readFile(Array<int>& arr)
+{
+	int fd = ::open(PATH, O_RDONLY);
+	size_t done = 0;
+	size_t bytes = static_cast<size_t>(arr.size()) * sizeof(int);
+	char* dst = reinterpret_cast<char*>(arr.data());
+	while (done < bytes)
+	{
+		ssize_t got = ::read(fd, dst + done, bytes - done);
+		if (got <= 0)
+			break;
+		done += static_cast<size_t>(got);
+	}
+	::close(fd);
+}
+
+static long scan(int const * p, unsigned int n)
+{
+	long total = 0;
+	for (unsigned int i = 0; i < n; i++)
+		total += p[i];
+	return total;
+}
+
+static long lookups(int const * p, unsigned int n)
+{
+	long total = 0;
+	unsigned int index = 12345;
+	for (unsigned int i = 0; i < LOOKUPS; i++)
+	{
+		index = index * 1103515245u + 12345u;
+		total += p[index % n];
+	}
+	return total;
+}
+
+enum Loader { READ_ZEROED, READ_UNINITIALIZED, MAP, MAP_ADVISED };
+enum Use { SCAN, LOOKUP };
+
+// Returns {load time, load + use time} in ms, best of REPETITIONS
+static std::pair<double, double> run(Loader loader, Use use, bool cold)
+{
+	std::pair<double, double> best(0, 0);
+	for (int r = 0; r < REPETITIONS; r++)
+	{
+		if (cold)
+			dropCache();
+		double start = bench::nowNs();
+		double loaded;
+		long result;
+		if (loader == READ_ZEROED || loader == READ_UNINITIALIZED)
+		{
+			Array<int> zeroed;
+			Array<int> raw;
+			if (loader == READ_ZEROED)
+				Array<int>(COUNT).swap(zeroed);
+			else
+				Array<int>(COUNT, uninitialized).swap(raw);
+			Array<int>& arr = (loader == READ_ZEROED) ? zeroed : raw;
+			readFile(arr);
+			loaded = bench::nowNs();
+			result = (use == SCAN) ? scan(arr.data(), arr.size()) : lookups(arr.data(), arr.size());
+		}
+		else
+		{
+			MappedArray<int> arr(PATH);
+			if (loader == MAP_ADVISED)
+				arr.advise((use == SCAN) ? MappedArray<int>::SEQUENTIAL : MappedArray<int>::RANDOM);
+			loaded = bench::nowNs();
+			result = (use == SCAN) ? scan(arr.data(), arr.size()) : lookups(arr.data(), arr.size());
+		}
+		bench::doNotOptimize(result);
+		double end = bench::nowNs();
+		std::pair<double, double> t((loaded - start) / 1e6, (end - start) / 1e6);
+		if (r == 0 || t.second < best.second)
+			best = t;
+	}
+	return best;
+}
+
+static void report(std::string const & name, Loader loader, Use use, bool cold)
+{
+	std::pair<double, double> t = run(loader, use, cold);
+	std::ostringstream line;
+	line << std::fixed << std::setprecision(2) << "load " << t.first << " ms, load + "
+		<< ((use == SCAN) ? "scan " : "10k lookups ") << t.second << " ms";
+	bench::report(name + (cold ? " (cold)" : " (warm)"), t.second * 1e6, line.str());
+}
+
+int main(void)
+{
+	std::cout << "Mapped array benchmark (256 MiB file)" << std::endl;
+	writeFile();
+	for (int cold = 1; cold >= 0; cold--)
+	{
+		report("read() into Array(n)", READ_ZEROED, SCAN, cold != 0);
+		report("read() into Array(n, uninitialized)", READ_UNINITIALIZED, SCAN, cold != 0);
+		report("MappedArray", MAP, SCAN, cold != 0);
+		report("MappedArray + SEQUENTIAL", MAP_ADVISED, SCAN, cold != 0);
+	}
+	for (int cold = 1; cold >= 0; cold--)
+	{
+		report("lookups: read() into Array", READ_UNINITIALIZED, LOOKUP, cold != 0);
+		report("lookups: MappedArray", MAP, LOOKUP, cold != 0);
+		report("lookups: MappedArray + RANDOM", MAP_ADVISED, LOOKUP, cold != 0);
+	}
+	std::remove(PATH);
+	return 0;
+}
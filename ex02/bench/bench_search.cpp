@@ -0,0 +1,123 @@
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <sstream>
+#include "../SearchIndex.hpp"
+#include "../../bench/Bench.hpp"
+
+// 1M random lower_bound queries on sorted int and unsigned long arrays,
+// from L1-resident (4K ints = 16 KB) to far beyond the last-level cache
+// (64M ints = 256 MB):
+//   std::lower_bound:           branchy binary search on the Array
+//   ::lower_bound:              branch-free binary search on the Array
+//   SearchIndex::lower_bound:   S+ tree, one query at a time
+//   SearchIndex, batched:       S+ tree, 16 queries per walk, prefetching
+// Keys are the even numbers; queries hit and miss in equal measure. The
+// first line of each size gives the index build time and its memory.
+
+static size_t const QUERIES = 1u << 20;
+
+template <typename T>
+struct Search
+{
+	enum Kind
+	{
+		STD,
+		BINARY,
+		INDEX,
+		BATCHED
+	};
+
+	Array<T> const &		sorted;
+	SearchIndex<T> const &	index;
+	Array<T> const &		queries;
+	Array<size_t>&			out;
+	Kind					kind;
+
+	Search(Array<T> const & s, SearchIndex<T> const & i, Array<T> const & q, Array<size_t>& o, Kind k)
+		: sorted(s), index(i), queries(q), out(o), kind(k) {}
+
+	void operator()()
+	{
+		size_t total = 0;
+		if (kind == BATCHED)
+		{
+			index.lower_bound(queries, out);
+			for (size_t i = 0; i < queries.size(); i++)
+				total += out[i];
+		}
+		for (size_t i = 0; kind != BATCHED && i < queries.size(); i++)
+		{
+			if (kind == STD)
+				total += std::lower_bound(sorted.begin(), sorted.end(), queries[i]) - sorted.begin();
+			else if (kind == BINARY)
+				total += ::lower_bound(sorted, queries[i]);
+			else
+				total += index.lower_bound(queries[i]);
+		}
+		bench::doNotOptimize(total);
+	}
+};
+
+template <typename T>
+struct Build
+{
+	Array<T> const &	sorted;
+
+	Build(Array<T> const & s) : sorted(s) {}
+
+	void operator()()
+	{
+		SearchIndex<T> index(sorted);
+		bench::doNotOptimize(index.bytes());
+	}
+};
+
+template <typename T>
+static void searchTable(std::string const & type, size_t const * sizes, size_t count)
+{
+	std::cout << "\n" << type << ", " << QUERIES << " random queries" << std::endl;
+	Array<T> queries(QUERIES);
+	Array<size_t> out(QUERIES);
+	for (size_t s = 0; s < count; s++)
+	{
+		size_t const n = sizes[s];
+		Array<T> sorted(n);
+		for (size_t i = 0; i < n; i++)
+			sorted[i] = static_cast<T>(2 * i);
+		std::srand(7);
+		for (size_t i = 0; i < QUERIES; i++)
+			queries[i] = static_cast<T>((static_cast<size_t>(std::rand()) * RAND_MAX + std::rand()) % (2 * n));
+		std::ostringstream suffix;
+		suffix << " (n = " << n << ", " << n * sizeof(T) / 1024 << " KB)";
+
+		Build<T> build(sorted);
+		double buildNs = bench::measure(build, 1, 3);
+		SearchIndex<T> index(sorted);
+		std::ostringstream buildNote;
+		buildNote << std::fixed << std::setprecision(2) << buildNs / n << " ns/key, "
+			<< index.bytes() / 1024 << " KB";
+		bench::report("SearchIndex build" + suffix.str(), buildNs, buildNote.str());
+
+		char const * const names[] = {"std::lower_bound", "::lower_bound", "SearchIndex::lower_bound",
+			"SearchIndex, batched"};
+		for (int k = Search<T>::STD; k <= Search<T>::BATCHED; k++)
+		{
+			Search<T> search(sorted, index, queries, out, static_cast<typename Search<T>::Kind>(k));
+			double ns = bench::measure(search, 1, 3);
+			std::ostringstream note;
+			note << std::fixed << std::setprecision(1) << ns / QUERIES << " ns/query";
+			bench::report(names[k] + suffix.str(), ns, note.str());
+		}
+	}
+}
+
+int main(void)
+{
+	std::cout << "Search benchmark" << std::endl;
+	size_t const intSizes[] = {1u << 12, 1u << 16, 1u << 20, 1u << 24, 1u << 26};
+	size_t const longSizes[] = {1u << 11, 1u << 20, 1u << 25};
+	searchTable<int>("int", intSizes, sizeof(intSizes) / sizeof(intSizes[0]));
+	searchTable<unsigned long>("unsigned long", longSizes, sizeof(longSizes) / sizeof(longSizes[0]));
+	return 0;
+}
@@ -0,0 +1,177 @@
+#include <cstdio>
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <sstream>
+#include "../Serialize.hpp"
+#include "../MappedArray.hpp"
+#include "../../bench/Bench.hpp"
+
+// Persisting and restoring 4M doubles (32 MiB): element-by-element loops
+// (what callers write today) versus the bulk serialize/deserialize paths
+// and the zero-copy view. The file stays in the page cache, so these are
+// CPU and copy costs, not disk speed.
+
+static unsigned int const COUNT = 4u * 1024u * 1024u;
+static char const * const PATH = "bench_serialize.bin";
+static size_t const ITERATIONS = 3;
+
+struct Data
+{
+	Array<double>	values;
+	Data() : values(COUNT)
+	{
+		for (unsigned int i = 0; i < COUNT; i++)
+			values[i] = i * 0.25;
+	}
+};
+
+struct ElementWrite
+{
+	Data& d;
+	ElementWrite(Data& data) : d(data) {}
+	void operator()()
+	{
+		std::ofstream out(PATH, std::ios::binary);
+		for (unsigned int i = 0; i < d.values.size(); i++)
+			out.write(reinterpret_cast<char const *>(&d.values[i]), sizeof(double));
+	}
+};
+
+struct BulkSerialize
+{
+	Data& d;
+	BulkSerialize(Data& data) : d(data) {}
+	void operator()()
+	{
+		std::ofstream out(PATH, std::ios::binary);
+		serialize(out, d.values);
+	}
+};
+
+struct Save
+{
+	Data& d;
+	Save(Data& data) : d(data) {}
+	void operator()() { saveArray(PATH, d.values); }
+};
+
+// Reads what ElementWrite produced (raw doubles, no header)
+struct ElementRead
+{
+	void operator()()
+	{
+		std::ifstream in(PATH, std::ios::binary);
+		Array<double> arr(COUNT);
+		for (unsigned int i = 0; i < COUNT; i++)
+			in.read(reinterpret_cast<char*>(&arr[i]), sizeof(double));
+		bench::doNotOptimize(arr[COUNT - 1]);
+	}
+};
+
+struct Load
+{
+	void operator()()
+	{
+		Array<double> arr;
+		loadArray(PATH, arr);
+		bench::doNotOptimize(arr[COUNT - 1]);
+	}
+};
+
+struct MappedView
+{
+	void operator()()
+	{
+		MappedArray<unsigned char> file(PATH);
+		SerializedView<double> view(file.data(), file.size());
+		bench::doNotOptimize(view[COUNT - 1]);
+	}
+};
+
+// In memory: rebuilding a copy element by element through operator[]
+struct ElementCopy
+{
+	Data& d;
+	ElementCopy(Data& data) : d(data) {}
+	void operator()()
+	{
+		Array<double> copy(COUNT);
+		for (unsigned int i = 0; i < COUNT; i++)
+			copy[i] = d.values[i];
+		bench::doNotOptimize(copy[COUNT - 1]);
+	}
+};
+
+struct BufferDeserialize
+{
+	std::string const & bytes;
+	BufferDeserialize(std::string const & b) : bytes(b) {}
+	void operator()()
+	{
+		std::istringstream in(bytes);
+		Array<double> arr;
+		deserialize(in, arr);
+		bench::doNotOptimize(arr[COUNT - 1]);
+	}
+};
+
+struct BufferView
+{
+	Array<unsigned char> const & buffer;
+	BufferView(Array<unsigned char> const & b) : buffer(b) {}
+	void operator()()
+	{
+		SerializedView<double> view(buffer.data(), buffer.size());
+		bench::doNotOptimize(view[COUNT - 1]);
+	}
+};
+
+// Views copy nothing: their time does not scale with the data
+template <typename F>
+static void run(std::string const & name, F& f, bool copies = true)
+{
+	double ns = bench::measure(f, ITERATIONS);
+	std::ostringstream note;
+	if (copies)
+		note << std::fixed << std::setprecision(2) << static_cast<double>(COUNT) * sizeof(double) / ns << " GB/s";
+	else
+		note << "O(1), no copy";
+	bench::report(name, ns, note.str());
+}
+
+int main(void)
+{
+	std::cout << "Serialization benchmark (4M doubles, 32 MiB)" << std::endl;
+	Data data;
+
+	ElementWrite elementWrite(data);
+	run("write: per-element ofstream::write", elementWrite);
+	ElementRead elementRead;
+	run("read: per-element ifstream::read", elementRead);
+
+	BulkSerialize bulk(data);
+	run("write: serialize(ofstream)", bulk);
+	Save save(data);
+	run("write: saveArray (writev)", save);
+	Load load;
+	run("read: loadArray", load);
+	MappedView mapped;
+	run("read: mmap + SerializedView", mapped, false);
+
+	std::ostringstream out;
+	serialize(out, data.values);
+	std::string bytes = out.str();
+	Array<unsigned char> buffer(static_cast<unsigned int>(bytes.size()), uninitialized);
+	std::copy(bytes.begin(), bytes.end(), buffer.data());
+
+	ElementCopy elementCopy(data);
+	run("memory: per-element copy loop", elementCopy);
+	BufferDeserialize fromBuffer(bytes);
+	run("memory: deserialize(istringstream)", fromBuffer);
+	BufferView view(buffer);
+	run("memory: SerializedView over buffer", view, false);
+
+	std::remove(PATH);
+	return 0;
+}
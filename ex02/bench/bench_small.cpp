@@ -0,0 +1,58 @@
+#include <string>
+#include <sstream>
+#include "../Array.hpp"
+#include "../SmallArray.hpp"
+#include "../../bench/Bench.hpp"
+#include "../../bench/PerfCounter.hpp"
+
+// Construction + destruction throughput of Array versus SmallArray<int, 16>
+// for sizes on both sides of the inline capacity, with cache misses per
+// array when hardware counters are available.
+
+static unsigned int const INLINE = 16;
+static size_t const ITERATIONS = 200000;
+
+template <typename A>
+struct Build
+{
+	unsigned int	n;
+	Build(unsigned int count) : n(count) {}
+	void operator()()
+	{
+		A arr(n);
+		arr[n - 1] = 1;
+		bench::doNotOptimize(arr[0]);
+	}
+};
+
+template <typename A>
+static void run(std::string const & name, unsigned int n)
+{
+	Build<A> build(n);
+	bench::PerfCounter misses(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+	misses.start();
+	double ns = bench::measure(build, ITERATIONS);
+	unsigned long long count = misses.stop();
+
+	std::ostringstream label;
+	label << name << " (n = " << n << ")";
+	std::ostringstream note;
+	if (misses.available())
+		note << std::fixed << std::setprecision(3)
+			<< static_cast<double>(count) / (ITERATIONS * 5) << " cache misses/op";
+	else
+		note << "cache misses n/a";
+	bench::report(label.str(), ns, note.str());
+}
+
+int main(void)
+{
+	std::cout << "SmallArray benchmark (inline capacity " << INLINE << ")" << std::endl;
+	unsigned int const sizes[] = {4, 8, 16, 17, 32, 64};
+	for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+	{
+		run<Array<int> >("Array<int>", sizes[i]);
+		run<SmallArray<int, INLINE> >("SmallArray<int, 16>", sizes[i]);
+	}
+	return 0;
+}
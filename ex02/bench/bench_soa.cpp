@@ -0,0 +1,122 @@
+#include <string>
+#include <sstream>
+#include "../Array.hpp"
+#include "../Kernels.hpp"
+#include "../SoAArray.hpp"
+#include "../../bench/Bench.hpp"
+
+// 10M particle records with 8 fields (56 bytes each), stored as an
+// Array<Particle> (AoS) or as a SoAArray with one column per field.
+// A one-field scan over AoS still reads whole records, so it pulls
+// 56 bytes per 4 useful ones through the cache. The SoA column reads
+// only the field. The plain column loop keeps the compiler's strict float
+// addition order (one add at a time); Kernels::sum vectorizes it. The
+// update touches two fields (x += vx * dt).
+
+static size_t const COUNT = 10u * 1000u * 1000u;
+static size_t const ITERATIONS = 2;
+
+struct Particle
+{
+	double	x, y, z;
+	double	vx, vy, vz;
+	float	mass;
+	int		id;
+};
+
+enum { X, Y, Z, VX, VY, VZ, MASS, ID };
+typedef SoAArray<double, double, double, double, double, double, float, int> Particles;
+
+struct AosSum
+{
+	Array<Particle> const & p;
+	AosSum(Array<Particle> const & particles) : p(particles) {}
+	void operator()()
+	{
+		Particle const * data = p.data();
+		float total = 0;
+		for (size_t i = 0; i < COUNT; i++)
+			total += data[i].mass;
+		bench::doNotOptimize(total);
+	}
+};
+
+struct SoaSum
+{
+	Particles const & p;
+	SoaSum(Particles const & particles) : p(particles) {}
+	void operator()()
+	{
+		float const * mass = p.column<MASS>().data();
+		float total = 0;
+		for (size_t i = 0; i < COUNT; i++)
+			total += mass[i];
+		bench::doNotOptimize(total);
+	}
+};
+
+struct SoaKernelSum
+{
+	Particles const & p;
+	SoaKernelSum(Particles const & particles) : p(particles) {}
+	void operator()()
+	{
+		float total = Kernels::sum(p.column<MASS>());
+		bench::doNotOptimize(total);
+	}
+};
+
+struct AosUpdate
+{
+	Array<Particle>& p;
+	AosUpdate(Array<Particle>& particles) : p(particles) {}
+	void operator()()
+	{
+		Particle* data = p.data();
+		for (size_t i = 0; i < COUNT; i++)
+			data[i].x += data[i].vx * 0.001;
+		bench::clobberMemory();
+	}
+};
+
+struct SoaUpdate
+{
+	Particles& p;
+	SoaUpdate(Particles& particles) : p(particles) {}
+	void operator()()
+	{
+		Kernels::axpy(p.column<X>(), p.column<VX>(), 0.001);
+		bench::clobberMemory();
+	}
+};
+
+template <typename F>
+static void run(std::string const & name, F f, size_t usefulBytes)
+{
+	double ns = bench::measure(f, ITERATIONS);
+	std::ostringstream note;
+	note << std::fixed << std::setprecision(2) << ns / COUNT << " ns/record, "
+		<< COUNT * usefulBytes / ns << " GB/s of useful data";
+	bench::report(name, ns, note.str());
+}
+
+int main(void)
+{
+	std::cout << "AoS vs SoA benchmark (10M records, 56 bytes each)" << std::endl;
+	Array<Particle> aos(COUNT);
+	Particles soa(COUNT);
+	for (size_t i = 0; i < COUNT; i++)
+	{
+		aos[i].mass = static_cast<float>(i % 100);
+		aos[i].vx = 1.0;
+		soa.column<MASS>()[i] = aos[i].mass;
+		soa.column<VX>()[i] = aos[i].vx;
+	}
+
+	run("mass sum: AoS loop", AosSum(aos), sizeof(float));
+	run("mass sum: SoA column loop", SoaSum(soa), sizeof(float));
+	run("mass sum: SoA Kernels::sum", SoaKernelSum(soa), sizeof(float));
+	run("x += vx * dt: AoS loop", AosUpdate(aos), 3 * sizeof(double));
+	run("x += vx * dt: SoA Kernels::axpy", SoaUpdate(soa), 3 * sizeof(double));
+	return 0;
+}
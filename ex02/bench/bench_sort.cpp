@@ -0,0 +1,214 @@
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <sstream>
+#include "../Sort.hpp"
+#include "../../bench/Bench.hpp"
+
+// Sorting 1M ints, 1M doubles and 100K strings on four input patterns:
+//   uniform:     random keys over the whole range
+//   sorted:      already ascending
+//   reversed:    descending
+//   duplicates:  16 distinct keys
+// Each call copies the input into the work array first; the copy alone
+// is the first row of every table. std::sort is the reference.
+//   ::sort:             radix sort for ints and doubles, pdqsort otherwise
+//   ::sort, comparator: pdqsort (an explicit comparator skips the radix sort)
+//   ::sort(par):        sorted runs merged in parallel, 4-thread pool
+// Then lower_bound against std::lower_bound, 1M random queries on sorted
+// arrays from cache-resident to memory-bound sizes.
+
+static size_t const NUMBERS = 1u << 20;
+static size_t const STRINGS = 100000;
+static size_t const QUERIES = 1u << 20;
+
+struct Ascending
+{
+	template <typename T>
+	bool operator()(T const & a, T const & b) const { return a < b; }
+};
+
+enum Pattern
+{
+	UNIFORM,
+	SORTED,
+	REVERSED,
+	DUPLICATES
+};
+
+static char const * const PATTERNS[] = {"uniform", "sorted", "reversed", "duplicates"};
+
+template <typename T> T key(long x) { return static_cast<T>(x); }
+template <> double key<double>(long x) { return static_cast<double>(x) / 7.0; }
+template <> std::string key<std::string>(long x)
+{
+	std::ostringstream out;
+	out << "user-" << x;
+	return out.str();
+}
+
+template <typename T>
+static void fillInput(Array<T>& input, Pattern pattern)
+{
+	std::srand(42);
+	size_t n = input.size();
+	for (size_t i = 0; i < n; i++)
+	{
+		long x = static_cast<long>(i);
+		if (pattern == UNIFORM)
+			x = std::rand() - RAND_MAX / 2;
+		else if (pattern == REVERSED)
+			x = static_cast<long>(n - i);
+		else if (pattern == DUPLICATES)
+			x = std::rand() % 16;
+		input[i] = key<T>(x);
+	}
+	if (pattern == SORTED)
+		::sort(input, Ascending());
+}
+
+template <typename T>
+struct Work
+{
+	Array<T> const &	input;
+	Array<T>			data;
+	ThreadPool&			pool;
+
+	Work(Array<T> const & in, ThreadPool& p) : input(in), data(in.size()), pool(p) {}
+
+	void reset()
+	{
+		for (size_t i = 0; i < input.size(); i++)
+			data[i] = input[i];
+	}
+};
+
+template <typename T>
+struct CopyOnly
+{
+	Work<T>& w;
+	CopyOnly(Work<T>& work) : w(work) {}
+	void operator()() { w.reset(); bench::doNotOptimize(w.data.data()); }
+};
+
+template <typename T>
+struct StdSort
+{
+	Work<T>& w;
+	StdSort(Work<T>& work) : w(work) {}
+	void operator()() { w.reset(); std::sort(w.data.begin(), w.data.end()); bench::clobberMemory(); }
+};
+
+template <typename T>
+struct DefaultSort
+{
+	Work<T>& w;
+	DefaultSort(Work<T>& work) : w(work) {}
+	void operator()() { w.reset(); ::sort(w.data); bench::clobberMemory(); }
+};
+
+template <typename T>
+struct ComparatorSort
+{
+	Work<T>& w;
+	ComparatorSort(Work<T>& work) : w(work) {}
+	void operator()() { w.reset(); ::sort(w.data, Ascending()); bench::clobberMemory(); }
+};
+
+template <typename T>
+struct ParallelSort
+{
+	Work<T>& w;
+	ParallelSort(Work<T>& work) : w(work) {}
+	void operator()() { w.reset(); ::sort(ParallelPolicy(0, &w.pool), w.data); bench::clobberMemory(); }
+};
+
+template <typename F>
+static void run(std::string const & name, size_t n, F f, double copyNs = 0)
+{
+	double ns = bench::measure(f, 1);
+	std::ostringstream note;
+	note << std::fixed << std::setprecision(2) << (ns - copyNs) / n << " ns/element sorting";
+	bench::report(name, ns, copyNs > 0 ? note.str() : "");
+}
+
+template <typename T>
+static void sortTable(std::string const & type, size_t n, ThreadPool& pool)
+{
+	std::cout << "\n" << n << " " << type << std::endl;
+	Array<T> input(n);
+	for (int p = UNIFORM; p <= DUPLICATES; p++)
+	{
+		fillInput(input, static_cast<Pattern>(p));
+		Work<T> work(input, pool);
+		std::string suffix = std::string(" (") + PATTERNS[p] + ")";
+		CopyOnly<T> copy(work);
+		double copyNs = bench::measure(copy, 1);
+		bench::report("copy only" + suffix, copyNs);
+		run("std::sort" + suffix, n, StdSort<T>(work), copyNs);
+		run("::sort" + suffix, n, DefaultSort<T>(work), copyNs);
+		run("::sort, comparator" + suffix, n, ComparatorSort<T>(work), copyNs);
+		run("::sort(par), 4 threads" + suffix, n, ParallelSort<T>(work), copyNs);
+	}
+}
+
+struct Search
+{
+	Array<int> const &	sorted;
+	Array<int> const &	queries;
+	bool				useStd;
+
+	Search(Array<int> const & s, Array<int> const & q, bool std) : sorted(s), queries(q), useStd(std) {}
+
+	void operator()()
+	{
+		size_t total = 0;
+		for (size_t i = 0; i < queries.size(); i++)
+		{
+			if (useStd)
+				total += std::lower_bound(sorted.begin(), sorted.end(), queries[i]) - sorted.begin();
+			else
+				total += ::lower_bound(sorted, queries[i]);
+		}
+		bench::doNotOptimize(total);
+	}
+};
+
+static void searchTable()
+{
+	std::cout << "\nlower_bound, " << QUERIES << " random queries" << std::endl;
+	size_t const sizes[] = {4096, 1u << 20, 1u << 24};
+	Array<int> queries(QUERIES);
+	for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+	{
+		Array<int> sorted(sizes[s]);
+		for (size_t i = 0; i < sizes[s]; i++)
+			sorted[i] = static_cast<int>(2 * i);
+		std::srand(7);
+		for (size_t i = 0; i < QUERIES; i++)
+			queries[i] = std::rand() % static_cast<int>(2 * sizes[s]);
+		std::ostringstream suffix;
+		suffix << " (n = " << sizes[s] << ")";
+		Search stdSearch(sorted, queries, true);
+		Search search(sorted, queries, false);
+		double stdNs = bench::measure(stdSearch, 1);
+		double ns = bench::measure(search, 1);
+		std::ostringstream note;
+		note << std::fixed << std::setprecision(1) << ns / QUERIES << " ns/query";
+		std::ostringstream stdNote;
+		stdNote << std::fixed << std::setprecision(1) << stdNs / QUERIES << " ns/query";
+		bench::report("std::lower_bound" + suffix.str(), stdNs, stdNote.str());
+		bench::report("::lower_bound" + suffix.str(), ns, note.str());
+	}
+}
+
+int main(void)
+{
+	std::cout << "Sort benchmark (" << ThreadPool::hardwareThreads() << " CPUs online)" << std::endl;
+	ThreadPool pool(4);
+	sortTable<int>("ints", NUMBERS, pool);
+	sortTable<double>("doubles", NUMBERS, pool);
+	sortTable<std::string>("strings", STRINGS, pool);
+	searchTable();
+	return 0;
+}
@@ -0,0 +1,130 @@
+#include <string>
+#include <sstream>
+#include "../Array.hpp"
+#include "../StaticArray.hpp"
+#include "../../bench/Bench.hpp"
+#include "../../bench/AllocCounter.hpp"
+
+// Small fixed-size arrays: Array<int>(N) (heap, runtime size) versus
+// StaticArray<int, N> (inline, size in the type) for N = 4, 16 and 64.
+// "build + iter" constructs the array, writes it and sums it through
+// iter(); "min(a, b)" is one element-wise whatever.hpp min over two
+// arrays that already exist. StaticArray unrolls both up to N = 16, and with the size
+// known the compiler can keep the whole array in registers.
+
+static size_t const ITERATIONS = 2000000;
+
+struct Add
+{
+	int* sum;
+	void operator()(int const & n) const { *sum += n; }
+};
+
+template <size_t N>
+struct HeapBuild
+{
+	int seed;
+	void operator()()
+	{
+		bench::doNotOptimize(seed);
+		Array<int> arr(N);
+		for (size_t i = 0; i < N; i++)
+			arr[i] = seed + static_cast<int>(i);
+		int sum = 0;
+		Add add = {&sum};
+		iter(arr.data(), arr.size(), add);
+		bench::doNotOptimize(sum);
+	}
+};
+
+template <size_t N>
+struct StaticBuild
+{
+	int seed;
+	void operator()()
+	{
+		bench::doNotOptimize(seed);
+		StaticArray<int, N> arr;
+		for (size_t i = 0; i < N; i++)
+			arr[i] = seed + static_cast<int>(i);
+		int sum = 0;
+		Add add = {&sum};
+		iter(arr, add);
+		bench::doNotOptimize(sum);
+	}
+};
+
+template <size_t N>
+struct HeapMin
+{
+	Array<int> a, b, out;
+	HeapMin() : a(N), b(N), out(N)
+	{
+		for (size_t i = 0; i < N; i++)
+		{
+			a[i] = static_cast<int>(i * 7 % 13);
+			b[i] = static_cast<int>(i * 5 % 11);
+		}
+	}
+	void operator()()
+	{
+		bench::clobberMemory();
+		::min(a.data(), b.data(), out.data(), N);
+		bench::doNotOptimize(out[N - 1]);
+	}
+};
+
+template <size_t N>
+struct StaticMin
+{
+	StaticArray<int, N> a, b, out;
+	StaticMin()
+	{
+		for (size_t i = 0; i < N; i++)
+		{
+			a[i] = static_cast<int>(i * 7 % 13);
+			b[i] = static_cast<int>(i * 5 % 11);
+		}
+	}
+	void operator()()
+	{
+		bench::clobberMemory();
+		out = min(a, b);
+		bench::doNotOptimize(out[N - 1]);
+	}
+};
+
+template <typename F>
+static void run(std::string const & name, size_t n, F& f)
+{
+	bench::resetAllocStats();
+	double ns = bench::measure(f, ITERATIONS);
+	std::ostringstream label;
+	label << name << " (N = " << n << ")";
+	std::ostringstream note;
+	note << std::fixed << std::setprecision(1)
+		<< static_cast<double>(bench::allocStats().allocs) / (ITERATIONS * 5) << " allocs/op";
+	bench::report(label.str(), ns, note.str());
+}
+
+template <size_t N>
+static void runSize()
+{
+	HeapBuild<N> heapBuild = {1};
+	StaticBuild<N> staticBuild = {1};
+	HeapMin<N> heapMin;
+	StaticMin<N> staticMin;
+	run("build + iter: Array<int>", N, heapBuild);
+	run("build + iter: StaticArray<int, N>", N, staticBuild);
+	run("min(a, b): Array<int>", N, heapMin);
+	run("min(a, b): StaticArray<int, N>", N, staticMin);
+}
+
+int main(void)
+{
+	std::cout << "StaticArray benchmark (heap Array vs inline StaticArray)" << std::endl;
+	runSize<4>();
+	runSize<16>();
+	runSize<64>();
+	return 0;
+}
@@ -0,0 +1,134 @@
+#include <algorithm>
+#include <string>
+#include <sstream>
+#include "../Array.hpp"
+#include "../Kernels.hpp"
+#include "../../ex01/iter.hpp"
+#include "../../bench/Bench.hpp"
+#include "../../bench/AllocCounter.hpp"
+
+// Processing sub-ranges of a 16M-float array: copying each range into its
+// own Array first (the only option before views) versus passing a slice.
+// Every operation handles WINDOWS ranges at pseudo-random offsets; the
+// note gives the throughput over the range data and the heap traffic.
+
+static unsigned int const COUNT = 16u * 1024u * 1024u;
+static unsigned int const WINDOWS = 64;
+static size_t const ITERATIONS = 20;
+
+static unsigned int offsetOf(unsigned int window, unsigned int width)
+{
+	return (window * 2654435761u) % (COUNT - width);
+}
+
+// Read-only: sum of each range
+struct SumCopy
+{
+	Array<float> const & data;
+	unsigned int width;
+	SumCopy(Array<float> const & d, unsigned int w) : data(d), width(w) {}
+	void operator()()
+	{
+		float total = 0;
+		for (unsigned int w = 0; w < WINDOWS; w++)
+		{
+			unsigned int first = offsetOf(w, width);
+			Array<float> part(width, uninitialized);
+			std::copy(data.begin() + first, data.begin() + first + width, part.begin());
+			total += Kernels::sum(part);
+		}
+		bench::doNotOptimize(total);
+	}
+};
+
+struct SumView
+{
+	Array<float> const & data;
+	unsigned int width;
+	SumView(Array<float> const & d, unsigned int w) : data(d), width(w) {}
+	void operator()()
+	{
+		float total = 0;
+		for (unsigned int w = 0; w < WINDOWS; w++)
+		{
+			unsigned int first = offsetOf(w, width);
+			total += Kernels::sum(data.slice(first, first + width));
+		}
+		bench::doNotOptimize(total);
+	}
+};
+
+// In place: each range is modified, so a copy must also be written back
+static void negate(float & x)
+{
+	x = -x;
+}
+
+struct IterCopy
+{
+	Array<float>& data;
+	unsigned int width;
+	IterCopy(Array<float>& d, unsigned int w) : data(d), width(w) {}
+	void operator()()
+	{
+		for (unsigned int w = 0; w < WINDOWS; w++)
+		{
+			unsigned int first = offsetOf(w, width);
+			Array<float> part(width, uninitialized);
+			std::copy(data.begin() + first, data.begin() + first + width, part.begin());
+			::iter(part.data(), part.size(), negate);
+			std::copy(part.begin(), part.end(), data.begin() + first);
+		}
+		bench::clobberMemory();
+	}
+};
+
+struct IterView
+{
+	Array<float>& data;
+	unsigned int width;
+	IterView(Array<float>& d, unsigned int w) : data(d), width(w) {}
+	void operator()()
+	{
+		for (unsigned int w = 0; w < WINDOWS; w++)
+		{
+			unsigned int first = offsetOf(w, width);
+			::iter(data.slice(first, first + width), negate);
+		}
+		bench::clobberMemory();
+	}
+};
+
+template <typename F>
+static void run(std::string const & name, F f, unsigned int width)
+{
+	bench::resetAllocStats();
+	double ns = bench::measure(f, ITERATIONS);
+	bench::AllocStats const & s = bench::allocStats();
+	size_t calls = ITERATIONS * 5;
+	std::ostringstream note;
+	note << std::fixed << std::setprecision(2)
+		<< static_cast<double>(WINDOWS) * width * sizeof(float) / ns << " GB/s, "
+		<< static_cast<double>(s.allocs) / calls << " allocs/op";
+	bench::report(name, ns, note.str());
+}
+
+int main(void)
+{
+	std::cout << "Sub-range benchmark (16M floats, " << WINDOWS << " ranges per op)" << std::endl;
+	Array<float> data(COUNT, uninitialized);
+	for (unsigned int i = 0; i < COUNT; i++)
+		data[i] = static_cast<float>(i % 1000);
+
+	unsigned int const widths[] = {256, 64 * 1024};
+	for (int i = 0; i < 2; i++)
+	{
+		std::ostringstream suffix;
+		suffix << " (" << widths[i] << " floats)";
+		run("sum: copy into Array" + suffix.str(), SumCopy(data, widths[i]), widths[i]);
+		run("sum: slice view" + suffix.str(), SumView(data, widths[i]), widths[i]);
+		run("iter: copy out + back" + suffix.str(), IterCopy(data, widths[i]), widths[i]);
+		run("iter: slice view" + suffix.str(), IterView(data, widths[i]), widths[i]);
+	}
+	return 0;
+}
@@ -0,0 +1,85 @@
+// Exact instrumentation counts. Built on its own with -DINSTRUMENT
+// (make instrument-test): main.cpp tests the default, uninstrumented build.
+#ifndef INSTRUMENT
+# error "build with -DINSTRUMENT (make instrument-test)"
+#endif
+
+#include <iostream>
+#include <string>
+#include <stdexcept>
+#include "Array.hpp"
+#include "../ex01/iter.hpp"
+
+// ANSI Color codes
+#define RESET   "\033[0m"
+#define RED     "\033[31m"
+#define GREEN   "\033[32m"
+#define YELLOW  "\033[33m"
+#define BOLD    "\033[1m"
+
+void printTest(std::string const & testName, bool success)
+{
+	if (success)
+		std::cout << GREEN << "✓ " << testName << RESET << std::endl;
+	else
+		std::cout << RED << "✗ " << testName << RESET << std::endl;
+}
+
+void negate(int & n)
+{
+	n = -n;
+}
+
+int main(void)
+{
+	std::cout << BOLD << YELLOW << "\n[1] Array instrumentation counters" << RESET << std::endl;
+	{
+		Instrument::reset();
+		Array<int> a(5);
+		Array<int> empty;
+		Array<int> none(0);
+		Instrument::Counters c = Instrument::snapshot();
+		printTest("One allocation per non-empty buffer", c[Instrument::ALLOCATIONS] == 1
+			&& c[Instrument::ALLOCATED_BYTES] == 5 * sizeof(int));
+
+		Instrument::reset();
+		Array<int> b(a);
+		Array<int> same(5);
+		same = a;
+		same = same;
+		Array<std::string> words(2);
+		Array<std::string> wordsCopy;
+		wordsCopy = words;
+		c = Instrument::snapshot();
+		printTest("Deep copies: copy ctor, in-place and copy-and-swap assignment", c[Instrument::DEEP_COPIES] == 3
+			&& c[Instrument::ALLOCATIONS] == 4
+			&& c[Instrument::ALLOCATED_BYTES] == 10 * sizeof(int) + 4 * sizeof(std::string));
+
+		Instrument::reset();
+		for (int i = 0; i < 9; i++)
+			empty.push_back(i);
+		c = Instrument::snapshot();
+		printTest("Growth to 9 elements allocates 4, 8, then 16 slots", c[Instrument::ALLOCATIONS] == 3
+			&& c[Instrument::ALLOCATED_BYTES] == 28 * sizeof(int) && c[Instrument::DEEP_COPIES] == 0);
+
+		Instrument::reset();
+		int thrown = 0;
+		try { a[5] = 1; } catch (std::exception&) { thrown++; }
+		try { a.at(7) = 1; } catch (std::exception&) { thrown++; }
+		try { none.pop_back(); } catch (std::exception&) { thrown++; }
+		a[4] = 1;
+		c = Instrument::snapshot();
+		printTest("Out-of-bounds throws are counted", thrown == 3 && c[Instrument::BOUNDS_THROWS] == 3);
+
+		Instrument::reset();
+		::iter(b.data(), b.size(), negate);
+		::iter(b.view().first(2), negate);
+		c = Instrument::snapshot();
+		printTest("iter over Array storage", c[Instrument::ITER_CALLS] == 2 && c[Instrument::ITER_ELEMENTS] == 7
+			&& c[Instrument::ALLOCATIONS] == 0);
+	}
+
+	std::cout << BOLD << GREEN << "\n✓ All instrumentation tests completed!\n" << RESET << std::endl;
+
+	return 0;
+}
@@ -1,6 +1,29 @@
 #include <iostream>
 #include <string>
+#include <cmath>
 #include "Array.hpp"
+#include "SmallArray.hpp"
+#include "Kernels.hpp"
+#include "MappedArray.hpp"
+#include "Serialize.hpp"
+#include "SoAArray.hpp"
+#include "ConcurrentArray.hpp"
+#include "StaticArray.hpp"
+#include "ArrayExpr.hpp"
+#include "Sort.hpp"
+#include "SearchIndex.hpp"
+#include <pthread.h>
+#include <sched.h>
+#include "../ex01/iter.hpp"
+#include <sstream>
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <functional>
+#if __cplusplus >= 201103L
+# include <type_traits>
+#endif
 
 // ANSI Color codes
 #define RESET   "\033[0m"
@@ -30,6 +53,7 @@ class Number
 	public:
 		Number() : _value(0) {}
 		Number(int value) : _value(value) {}
+		Number(Number const & src) : _value(src._value) {}
 
 		int getValue() const { return _value; }
 		void setValue(int value) { _value = value; }
@@ -48,6 +72,208 @@ std::ostream& operator<<(std::ostream& os, Number const & n)
 	return os;
 }
 
+// Kernel results: exact for int, relative tolerance for floating point
+// (reductions add in a different order)
+bool sameResult(int a, int b) { return a == b; }
+bool sameResult(double a, double b) { return std::fabs(a - b) <= 1e-4 * (1.0 + std::fabs(b)); }
+
+// Runs every kernel at `level` and at the scalar level on an odd-sized,
+// unaligned range and compares the results
+template <typename T>
+bool kernelsMatchScalar(Kernels::Level level)
+{
+	size_t const n = 1003;
+	Array<T> x(n + 1);
+	Array<T> y(n + 1);
+	for (size_t i = 0; i <= n; i++)
+	{
+		x[i] = static_cast<T>(static_cast<int>(i * 37 % 101) - 50);
+		y[i] = static_cast<T>(static_cast<int>(i * 11 % 53) - 26);
+	}
+
+	bool ok = true;
+	T results[2][3];
+	Array<T> outputs[2];
+	Kernels::Level const levels[2] = {Kernels::SCALAR, level};
+	for (int pass = 0; pass < 2; pass++)
+	{
+		Kernels::setLevel(levels[pass]);
+		Array<T> out(y);
+		Kernels::axpy(out.data() + 1, x.data() + 1, n, static_cast<T>(3));
+		Kernels::scale(out.data() + 1, n, static_cast<T>(2));
+		Kernels::add(out.data() + 1, out.data() + 1, x.data() + 1, n);
+		Kernels::fill(out.data(), 5, static_cast<T>(9));
+		outputs[pass] = out;
+		results[pass][0] = Kernels::sum(x.data() + 1, n);
+		results[pass][1] = Kernels::minValue(y.data() + 1, n);
+		results[pass][2] = Kernels::maxValue(y.data() + 1, n);
+	}
+	Kernels::setLevel(level);
+	for (size_t i = 0; i <= n; i++)
+		ok = ok && sameResult(outputs[1][i], outputs[0][i]);
+	for (int r = 0; r < 3; r++)
+		ok = ok && sameResult(results[1][r], results[0][r]);
+	return ok;
+}
+
+// MemAvailable from /proc/meminfo in bytes, 0 when unknown
+size_t availableMemory()
+{
+	std::ifstream meminfo("/proc/meminfo");
+	std::string key;
+	size_t kib;
+	while (meminfo >> key >> kib)
+	{
+		if (key == "MemAvailable:")
+			return kib * 1024;
+		meminfo.ignore(256, '\n');
+	}
+	return 0;
+}
+
+// Default constructor that fails once `budget` objects have been built
+struct Fragile
+{
+	static int budget;
+	int value;
+	Fragile() : value(1)
+	{
+		if (budget-- <= 0)
+			throw std::runtime_error("Fragile: out of budget");
+	}
+};
+int Fragile::budget = 1000;
+
+// Stream over a buffer that cannot seek, like a pipe or a socket
+struct ForwardOnlyBuffer : public std::streambuf
+{
+	ForwardOnlyBuffer(char* data, size_t size)
+	{
+		setg(data, data, data + size);
+	}
+};
+
+void addOne(double & x)
+{
+	x += 1.0;
+}
+
+int toQuantity(double x)
+{
+	return static_cast<int>(x);
+}
+
+// Concurrent append: each producer pushes (id << 32 | sequence) values
+// while a reader checks that everything below size() is already written
+size_t const PRODUCERS = 6;
+size_t const PUSHES = 20000;
+
+struct AppendShared
+{
+	ConcurrentArray<unsigned long>	values;
+	bool							readerOk;
+};
+
+struct Producer
+{
+	AppendShared*	shared;
+	unsigned long	id;
+};
+
+// Over-aligned element type: one per cache line
+struct CacheLine
+{
+	long	value;
+} __attribute__((aligned(64)));
+
+void* producerMain(void* arg)
+{
+	Producer* p = static_cast<Producer*>(arg);
+	for (unsigned long i = 0; i < PUSHES; i++)
+	{
+		p->shared->values.push_back((p->id << 32) | i);
+		if (i % 1024 == 0)
+			sched_yield();
+	}
+	return NULL;
+}
+
+void* readerMain(void* arg)
+{
+	AppendShared* shared = static_cast<AppendShared*>(arg);
+	size_t seen = 0;
+	while (seen < PRODUCERS * PUSHES)
+	{
+		size_t size = shared->values.size();
+		if (size < seen)
+			shared->readerOk = false;
+		for (; seen < size; seen++)
+			if ((shared->values[seen] >> 32) >= PRODUCERS || (shared->values[seen] & 0xffffffffUL) >= PUSHES)
+				shared->readerOk = false;
+		sched_yield();
+	}
+	return NULL;
+}
+
+// Takes any contiguous ints: Arrays convert implicitly
+long total(ArrayView<int const> values)
+{
+	long result = 0;
+	for (size_t i = 0; i < values.size(); i++)
+		result += values[i];
+	return result;
+}
+
+void negate(int & n)
+{
+	n = -n;
+}
+
+// Adds every element it is called on to *sum (iter copies the functor)
+struct Accumulate
+{
+	long* sum;
+	void operator()(int const & n) const { *sum += n; }
+};
+
+// Owns a heap int and counts its copies and live objects. Opted in as
+// trivially relocatable: growth must move it without copying.
+struct Handle
+{
+	static int copies;
+	static int live;
+	int* value;
+
+	Handle(int v = 0) : value(new int(v)) { live++; }
+	Handle(Handle const & src) : value(new int(*src.value)) { copies++; live++; }
+	~Handle() { delete value; live--; }
+	Handle& operator=(Handle const & rhs)
+	{
+		*value = *rhs.value;
+		return *this;
+	}
+};
+int Handle::copies = 0;
+int Handle::live = 0;
+
+template <>
+struct TriviallyRelocatable<Handle>
+{
+	static bool const value = true;
+};
+
+// Descending order, counting its calls
+struct CountingGreater
+{
+	size_t*	calls;
+
+	bool operator()(int a, int b) const
+	{
+		++*calls;
+		return a > b;
+	}
+};
+
 int main(void)
 {
 	std::cout << BOLD << CYAN << "\n╔════════════════════════════════════════╗" << std::endl;
@@ -323,6 +549,1174 @@ int main(void)
 		printTest("Large array works", large.size() == 1000 && large[999] == 1000);
 	}
 
+	// ========== Test 14: Swap and assignment between equal sizes ==========
+	std::cout << BOLD << YELLOW << "\n[14] Swap and same-size assignment" << RESET << std::endl;
+	{
+		Array<int> a(3);
+		Array<int> b(5);
+		a[0] = 1;
+		b[0] = 2;
+
+		swap(a, b);
+		std::cout << "After swap(a, b): a.size() = " << CYAN << a.size() << RESET
+			<< ", b.size() = " << CYAN << b.size() << RESET << std::endl;
+		printTest("swap exchanges contents", a.size() == 5 && a[0] == 2 && b.size() == 3 && b[0] == 1);
+
+		Array<int> c(5);
+		int const * before = &c[0];
+		c = a;
+		printTest("Same-size assignment reuses the buffer", &c[0] == before && c[0] == 2);
+
+		Array<std::string> s1(2);
+		Array<std::string> s2(2);
+		s1[0] = "copy";
+		s2 = s1;
+		s1[0] = "changed";
+		printTest("Same-size assignment still deep copies", s2[0] == "copy");
+	}
+
+	// ========== Test 15: Growable array ==========
+	std::cout << BOLD << YELLOW << "\n[15] Growable array (push_back, reserve, resize)" << RESET << std::endl;
+	{
+		Array<int> arr;
+		for (int i = 0; i < 100; i++)
+			arr.push_back(i);
+		std::cout << "After 100 push_back: size = " << CYAN << arr.size() << RESET
+			<< ", capacity = " << CYAN << arr.capacity() << RESET << std::endl;
+		printTest("push_back appends in order", arr.size() == 100 && arr[0] == 0 && arr[99] == 99);
+		printTest("Capacity grows geometrically", arr.capacity() >= 100 && arr.capacity() < 200);
+
+		arr.push_back(arr[0]);
+		printTest("push_back of own element is safe", arr[100] == 0);
+
+		Array<int> reserved;
+		reserved.reserve(50);
+		int const * before = NULL;
+		reserved.push_back(1);
+		before = &reserved[0];
+		for (int i = 0; i < 49; i++)
+			reserved.push_back(i);
+		printTest("reserve avoids reallocation", &reserved[0] == before && reserved.size() == 50);
+
+		reserved.resize(60);
+		printTest("resize value-initializes new elements", reserved.size() == 60 && reserved[59] == 0);
+		reserved.resize(10);
+		reserved.shrink_to_fit();
+		printTest("shrink_to_fit releases capacity", reserved.capacity() == 10 && reserved[9] == 8);
+
+		Array<std::string> words;
+		words.push_back("Hello");
+		words.emplace_back(3, '!');
+		words.pop_back();
+		words.emplace_back("World");
+		std::cout << "Words: " << MAGENTA << words[0] << " " << words[1] << RESET << std::endl;
+		printTest("emplace_back/pop_back work", words.size() == 2 && words[1] == "World");
+
+		bool exceptionCaught = false;
+		Array<int> empty;
+		try
+		{
+			empty.pop_back();
+		}
+		catch (std::exception const &)
+		{
+			exceptionCaught = true;
+		}
+		printTest("pop_back on empty array throws", exceptionCaught);
+	}
+
+	// ========== Test 16: Uninitialized construction ==========
+	std::cout << BOLD << YELLOW << "\n[16] Uninitialized construction (for overwrite)" << RESET << std::endl;
+	{
+		Array<int> buffer(1000, uninitialized);
+		for (unsigned int i = 0; i < buffer.size(); i++)
+			buffer[i] = i * 2;
+		printTest("Uninitialized array has the requested size", buffer.size() == 1000);
+		printTest("Elements can be overwritten", buffer[999] == 1998);
+
+		Array<std::string> words(3, uninitialized);
+		printTest("Non-trivial types are still constructed", words[2].empty());
+
+		buffer.resize(2000, uninitialized);
+		printTest("resize(n, uninitialized) keeps existing elements", buffer.size() == 2000 && buffer[999] == 1998);
+	}
+
+	// ========== Test 17: Arena and pool allocators ==========
+	std::cout << BOLD << YELLOW << "\n[17] Arena and pool allocators" << RESET << std::endl;
+	{
+		Arena arena(1024);
+		{
+			Array<int, ArenaAllocator> a(10, ArenaAllocator(arena));
+			Array<int, ArenaAllocator> b(a);
+			for (int i = 0; i < 500; i++)
+				b.push_back(i);
+			a[0] = 42;
+			printTest("Arena-backed arrays work", a[0] == 42 && b[0] == 0 && b[509] == 499);
+			printTest("Copies share the arena", b.get_allocator().resource() == &arena);
+
+			Array<int, ArenaAllocator> sum(a + a, ArenaAllocator(arena));
+			printTest("Expressions evaluate into the given arena",
+				sum.get_allocator().resource() == &arena && sum[0] == 84 && sum.size() == 10);
+		}
+		size_t reserved = arena.bytesReserved();
+		arena.reset();
+		{
+			Array<int, ArenaAllocator> c(100, ArenaAllocator(arena));
+			printTest("reset() reuses chunks", arena.bytesReserved() == reserved && c[99] == 0);
+		}
+
+		Pool pool;
+		int const * first = NULL;
+		{
+			Array<std::string, PoolAllocator> words(3, PoolAllocator(pool));
+			words[0] = "pooled";
+			first = reinterpret_cast<int const *>(&words[0]);
+			printTest("Pool-backed arrays work", words[0] == "pooled");
+		}
+		{
+			Array<std::string, PoolAllocator> again(3, PoolAllocator(pool));
+			printTest("Freed pool blocks are recycled", reinterpret_cast<int const *>(&again[0]) == first);
+		}
+		pool.reset();
+	}
+
+	// ========== Test 18: Small-buffer array ==========
+	std::cout << BOLD << YELLOW << "\n[18] SmallArray (inline storage up to N)" << RESET << std::endl;
+	{
+		SmallArray<int, 8> small(5);
+		small[4] = 4;
+		printTest("Short array stays inline", small.isInline() && small.size() == 5 && small[0] == 0);
+
+		SmallArray<int, 8> big(20);
+		printTest("Long array spills to the heap", !big.isInline() && big.size() == 20);
+
+		for (int i = 0; i < 4; i++)
+			small.push_back(i);
+		printTest("push_back past N spills", !small.isInline() && small.size() == 9 && small[4] == 4 && small[8] == 3);
+
+		SmallArray<std::string, 4> words(2);
+		words[0] = "inline";
+		SmallArray<std::string, 4> copy(words);
+		SmallArray<std::string, 4> assigned;
+		assigned = copy;
+		words[0] = "changed";
+		printTest("Copy and assignment deep copy", copy[0] == "inline" && assigned[0] == "inline" && assigned.isInline());
+
+		SmallArray<int, 8> shrunk(20);
+		shrunk = SmallArray<int, 8>(3);
+		printTest("Assignment reuses current storage", shrunk.size() == 3);
+
+		bool exceptionCaught = false;
+		try
+		{
+			int value = small[9];
+			(void)value;
+		}
+		catch (std::exception const &)
+		{
+			exceptionCaught = true;
+		}
+		printTest("Out of bounds access throws", exceptionCaught);
+	}
+
+	// ========== Test 19: Bounds-checking policies ==========
+	std::cout << BOLD << YELLOW << "\n[19] Bounds-checking policies and raw access" << RESET << std::endl;
+	{
+		Array<int, HeapAllocator, UncheckedBounds> fast(4);
+		int sum = 0;
+		for (unsigned int i = 0; i < fast.size(); i++)
+		{
+			fast[i] = i + 1;
+			sum += fast[i];
+		}
+		printTest("Unchecked operator[] works in range", sum == 10);
+
+		bool exceptionCaught = false;
+		try
+		{
+			int value = fast.at(4);
+			(void)value;
+		}
+		catch (std::exception const &)
+		{
+			exceptionCaught = true;
+		}
+		printTest("at() still throws when unchecked", exceptionCaught);
+
+		Array<int> arr(5);
+		int n = 0;
+		for (int* it = arr.begin(); it != arr.end(); ++it)
+			*it = n++;
+		printTest("begin()/end() cover every element", arr[4] == 4 && arr.data() == &arr[0]);
+
+		Array<int> empty;
+		printTest("Empty array has begin() == end()", empty.begin() == empty.end());
+	}
+
+	// ========== Test 20: SIMD bulk kernels ==========
+	std::cout << BOLD << YELLOW << "\n[20] SIMD bulk kernels" << RESET << std::endl;
+	{
+		Kernels::Level supported = Kernels::supportedLevel();
+		std::cout << "CPU supports: " << CYAN << Kernels::levelName(supported) << RESET << std::endl;
+		for (int l = Kernels::SSE2; l <= supported; l++)
+		{
+			Kernels::Level level = static_cast<Kernels::Level>(l);
+			std::string name = Kernels::levelName(level);
+			printTest(name + " int kernels match scalar", kernelsMatchScalar<int>(level));
+			printTest(name + " float kernels match scalar", kernelsMatchScalar<float>(level));
+			printTest(name + " double kernels match scalar", kernelsMatchScalar<double>(level));
+		}
+		Kernels::setLevel(supported);
+
+		Array<float> arr(10);
+		Kernels::fill(arr, 1.5f);
+		Kernels::scale(arr, 2);
+		std::cout << "fill(1.5) then scale(2), sum of 10: " << CYAN << Kernels::sum(arr) << RESET << std::endl;
+		printTest("Array overloads", Kernels::sum(arr) == 30.0f && Kernels::maxValue(arr) == 3.0f);
+
+		Array<int> small(3);
+		small[0] = 4;
+		small[1] = -2;
+		small[2] = 7;
+		printTest("Short ranges use the scalar tail",
+			Kernels::minValue(small) == -2 && Kernels::maxValue(small) == 7 && Kernels::sum(small) == 9);
+
+		bool sizeMismatch = false;
+		try
+		{
+			Array<int> shorter(2);
+			Kernels::axpy(small, shorter, 1);
+		}
+		catch (std::invalid_argument const &)
+		{
+			sizeMismatch = true;
+		}
+		printTest("Size mismatch rejected", sizeMismatch);
+
+		bool emptyRejected = false;
+		try
+		{
+			Array<int> none;
+			Kernels::minValue(none);
+		}
+		catch (std::invalid_argument const &)
+		{
+			emptyRejected = true;
+		}
+		printTest("min of an empty array rejected", emptyRejected);
+	}
+
+	// ========== Test 21: Memory-mapped arrays ==========
+	std::cout << BOLD << YELLOW << "\n[21] Memory-mapped, file-backed arrays" << RESET << std::endl;
+	{
+		char const * path = "mapped_test.bin";
+		{
+			std::ofstream out(path, std::ios::binary);
+			for (int i = 0; i < 4000; i++)
+				out.write(reinterpret_cast<char const *>(&i), sizeof(i));
+		}
+
+		MappedArray<int> mapped(path);
+		mapped.advise(MappedArray<int>::SEQUENTIAL);
+		long total = 0;
+		for (unsigned int i = 0; i < mapped.size(); i++)
+			total += mapped[i];
+		std::cout << "Mapped " << CYAN << mapped.size() << RESET << " ints, sum " << CYAN << total << RESET << std::endl;
+		printTest("Elements read through operator[]", mapped.size() == 4000 && total == 3999L * 4000 / 2);
+
+		bool exceptionCaught = false;
+		try
+		{
+			mapped[4000];
+		}
+		catch (MappedArray<int>::OutOfBoundsException const &)
+		{
+			exceptionCaught = true;
+		}
+		printTest("Out-of-bounds access throws", exceptionCaught);
+
+		{
+			MappedArray<int> cow(path, MappedArray<int>::COPY_ON_WRITE);
+			cow[0] = 42;
+			printTest("Copy-on-write mapping is writable", cow[0] == 42);
+
+			// Ints 1000 to 2099 cover page 1 and the ends of pages 0 and 2
+			cow[999] = -1;
+			cow[2100] = -2;
+			cow.advise(MappedArray<int>::DONT_NEED, 1000, 1100);
+			printTest("DONT_NEED keeps neighbouring changes", cow[0] == 42
+				&& cow[999] == -1 && cow[2100] == -2);
+		}
+		MappedArray<int> reread(path);
+		printTest("Copy-on-write changes stay private", reread[0] == 0);
+
+		MappedArray<int> tail(path, MappedArray<int>::READ_ONLY, 4096 + 8);
+		printTest("Offset mapping", tail.size() == 4000 - 1026 && tail[0] == 1026);
+
+		bool missing = false;
+		try
+		{
+			MappedArray<int> none("does_not_exist.bin");
+		}
+		catch (std::runtime_error const & e)
+		{
+			missing = true;
+			std::cout << RED << "Exception: " << e.what() << RESET << std::endl;
+		}
+		printTest("Missing file throws", missing);
+
+		bool partial = false;
+		try
+		{
+			MappedArray<int> odd(path, MappedArray<int>::READ_ONLY, 2);
+		}
+		catch (std::runtime_error const &)
+		{
+			partial = true;
+		}
+		printTest("Misaligned offset rejected", partial);
+
+		MappedArray<int> empty(path, MappedArray<int>::READ_ONLY, 16000);
+		printTest("Empty range maps nothing", empty.empty() && empty.begin() == empty.end());
+
+		std::remove(path);
+	}
+
+	// ========== Test 22: Binary serialization ==========
+	std::cout << BOLD << YELLOW << "\n[22] Binary serialization" << RESET << std::endl;
+	{
+		Array<double> values(1000);
+		for (unsigned int i = 0; i < values.size(); i++)
+			values[i] = i * 0.5;
+
+		std::stringstream buffer;
+		serialize(buffer, values);
+		std::string bytes = buffer.str();
+		std::cout << "Serialized 1000 doubles: " << CYAN << bytes.size() << RESET << " bytes" << std::endl;
+		Array<double> copy;
+		deserialize(buffer, copy);
+		printTest("Stream round trip", copy.size() == 1000 && copy[999] == 499.5 && bytes.size() == 64 + 8000);
+
+		char const * path = "serialize_test.bin";
+		saveArray(path, values);
+		Array<double> loaded;
+		loadArray(path, loaded);
+		printTest("File round trip (writev)", loaded.size() == 1000 && loaded[10] == 5.0);
+
+		MappedArray<unsigned char> file(path);
+		SerializedView<double> view(file.data(), file.size());
+		printTest("Zero-copy view over a mapped file",
+			view.size() == 1000 && view[999] == 499.5 && view.data() == reinterpret_cast<double const *>(file.data() + 64));
+
+		bool typeMismatch = false;
+		try
+		{
+			SerializedView<float> wrong(file.data(), file.size());
+		}
+		catch (SerializeException const & e)
+		{
+			typeMismatch = true;
+			std::cout << RED << "Exception: " << e.what() << RESET << std::endl;
+		}
+		printTest("Element type mismatch rejected", typeMismatch);
+		std::remove(path);
+
+		// Same data as written by a big-endian machine
+		std::string swapped = bytes;
+		swapped[6] = 'B';
+		SerialDetail::byteSwap(&swapped[4], 1, 2);
+		SerialDetail::byteSwap(&swapped[8], 2, 4);
+		SerialDetail::byteSwap(&swapped[16], 1, 8);
+		SerialDetail::byteSwap(&swapped[64], 1000, 8);
+		std::istringstream swappedIn(swapped);
+		Array<double> fromBigEndian;
+		deserialize(swappedIn, fromBigEndian);
+		printTest("Other byte order swapped on read", fromBigEndian.size() == 1000 && fromBigEndian[999] == 499.5);
+
+		bool viewRefused = false;
+		try
+		{
+			SerializedView<double> direct(swapped.data(), swapped.size());
+		}
+		catch (SerializeException const &)
+		{
+			viewRefused = true;
+		}
+		printTest("Zero-copy view refuses the other byte order", viewRefused);
+
+		std::string future = bytes;
+		future[4] = 2;
+		std::istringstream futureIn(future);
+		bool versionRejected = false;
+		try
+		{
+			deserialize(futureIn, copy);
+		}
+		catch (SerializeException const &)
+		{
+			versionRejected = true;
+		}
+		printTest("Newer format version rejected, array unchanged", versionRejected && copy.size() == 1000);
+
+		std::istringstream truncated(bytes.substr(0, 1000));
+		bool truncatedRejected = false;
+		try
+		{
+			deserialize(truncated, copy);
+		}
+		catch (SerializeException const &)
+		{
+			truncatedRejected = true;
+		}
+		printTest("Truncated input rejected", truncatedRejected);
+
+		// Header claiming 2^40 doubles, followed by 8 bytes of payload
+		std::string huge = bytes.substr(0, 72);
+		uint64_t hugeCount = static_cast<uint64_t>(1) << 40;
+		std::memcpy(&huge[16], &hugeCount, 8);
+		std::istringstream hugeIn(huge);
+		ForwardOnlyBuffer forwardOnly(&huge[0], huge.size());
+		std::istream pipeIn(&forwardOnly);
+		bool seekableRejected = false;
+		bool pipeRejected = false;
+		try
+		{
+			deserialize(hugeIn, copy);
+		}
+		catch (SerializeException const &)
+		{
+			seekableRejected = true;
+		}
+		try
+		{
+			deserialize(pipeIn, copy);
+		}
+		catch (SerializeException const &)
+		{
+			pipeRejected = true;
+		}
+		printTest("Huge count over a short payload rejected, seekable or not",
+			seekableRejected && pipeRejected && copy.size() == 1000);
+
+		std::string twoChunks;
+		{
+			Array<char> letters(3u << 20);
+			for (size_t i = 0; i < letters.size(); i++)
+				letters[i] = static_cast<char>('a' + i % 26);
+			std::ostringstream out;
+			serialize(out, letters);
+			twoChunks = out.str();
+		}
+		ForwardOnlyBuffer chunked(&twoChunks[0], twoChunks.size());
+		std::istream chunkedIn(&chunked);
+		Array<char> letters;
+		deserialize(chunkedIn, letters);
+		printTest("Non-seekable stream read in growing chunks", letters.size() == (3u << 20)
+			&& letters[0] == 'a' && letters[letters.size() - 1] == static_cast<char>('a' + (letters.size() - 1) % 26));
+
+		std::stringstream stream;
+		{
+			ArrayWriter<int> writer(stream);
+			int chunk[100];
+			for (int c = 0; c < 50; c++)
+			{
+				for (int i = 0; i < 100; i++)
+					chunk[i] = c * 100 + i;
+				writer.write(chunk, 100);
+			}
+			writer.finish();
+		}
+		ArrayReader<int> reader(stream);
+		int chunk[64];
+		long total = 0;
+		size_t got;
+		while ((got = reader.read(chunk, 64)) > 0)
+			for (size_t i = 0; i < got; i++)
+				total += chunk[i];
+		printTest("Streaming writer/reader", reader.count() == 5000 && total == 4999L * 5000 / 2);
+	}
+
+	// ========== Test 23: Views ==========
+	std::cout << BOLD << YELLOW << "\n[23] ArrayView over Arrays" << RESET << std::endl;
+	{
+		Array<int> arr(100);
+		for (unsigned int i = 0; i < arr.size(); i++)
+			arr[i] = static_cast<int>(i);
+
+		Array<int> const & constArr = arr;
+		std::cout << "total(arr): " << CYAN << total(arr) << RESET << std::endl;
+		printTest("Array converts to ArrayView<T const>", total(arr) == 4950 && total(constArr) == 4950);
+
+		ArrayView<int> all = arr;
+		printTest("View shares the storage", all.data() == arr.data() && all.size() == 100);
+
+		::iter(arr.slice(10, 20), negate);
+		printTest("iter over a slice touches only the slice", arr[9] == 9 && arr[10] == -10
+			&& arr[19] == -19 && arr[20] == 20);
+		::iter(arr.slice(10, 20), negate);
+
+		::iter(arr, negate);
+		long sum = 0;
+		Accumulate accumulate = {&sum};
+		::iter(constArr, accumulate);
+		printTest("iter over a whole Array, const or not", arr[99] == -99 && sum == -4950);
+		::iter(arr, negate);
+
+		Array<float> x(1000);
+		Array<float> y(1000);
+		Kernels::fill(x, 1.0f);
+		Kernels::fill(y.slice(0, 500), 2.0f);
+		Kernels::scale(x.slice(500, 1000), 3.0f);
+		Kernels::axpy(y.slice(500, 1000), x.slice(0, 500), 4.0f);
+		printTest("Kernels on slices", y[0] == 2.0f && y[499] == 2.0f && y[500] == 4.0f
+			&& x[499] == 1.0f && x[500] == 3.0f);
+		printTest("Reductions on views", Kernels::sum(x.slice(0, 500)) == 500.0f
+			&& Kernels::maxValue(x.view()) == 3.0f && Kernels::minValue(static_cast<ArrayView<float const> >(x)) == 1.0f);
+
+		Kernels::add(y.slice(0, 100), x.slice(0, 100), y.slice(100, 200));
+		printTest("add mixes mutable and read-only views", y[0] == 3.0f && y[99] == 3.0f);
+
+		Kernels::fill(x.view().stride(10), 0.0f);
+		printTest("Strided kernels", x[0] == 0.0f && x[1] == 1.0f && x[990] == 0.0f
+			&& Kernels::sum(x.view().stride(10)) == 0.0f);
+
+		bool sizeMismatch = false;
+		try
+		{
+			Kernels::axpy(y.slice(0, 10), x.slice(0, 11), 1.0f);
+		}
+		catch (std::invalid_argument const &)
+		{
+			sizeMismatch = true;
+		}
+		bool outOfRange = false;
+		try
+		{
+			arr.slice(50, 101);
+		}
+		catch (std::out_of_range const &)
+		{
+			outOfRange = true;
+		}
+		printTest("Size mismatch and bad slice rejected", sizeMismatch && outOfRange);
+	}
+
+	// ========== Test 24: 64-bit sizes and huge pages ==========
+	std::cout << BOLD << YELLOW << "\n[24] 64-bit sizes and huge pages" << RESET << std::endl;
+	{
+		Array<int> arr;
+		std::cout << "max_size() for int: " << CYAN << arr.max_size() << RESET << std::endl;
+		printTest("max_size() is beyond 2^32", arr.max_size() > (static_cast<size_t>(1) << 32));
+
+		bool tooLarge = false;
+		try
+		{
+			arr.reserve(arr.max_size() + 1);
+		}
+		catch (std::length_error const &)
+		{
+			tooLarge = true;
+		}
+		bool overflow = false;
+		try
+		{
+			Array<double> doubles(static_cast<size_t>(-1) / 4, uninitialized);
+		}
+		catch (std::length_error const &)
+		{
+			overflow = true;
+		}
+		printTest("Oversized requests throw length_error", tooLarge && overflow && arr.capacity() == 0);
+
+		Array<int, HugePageAllocator> small(100);
+		Array<int, HugePageAllocator> large(HUGE_PAGE_SIZE, uninitialized);
+		Kernels::fill(large, 7);
+		printTest("Small arrays stay on the heap", small[99] == 0);
+		printTest("Large arrays are huge-page aligned",
+			reinterpret_cast<size_t>(large.data()) % HUGE_PAGE_SIZE == 0 && large[HUGE_PAGE_SIZE - 1] == 7);
+		large.push_back(8);
+		printTest("Huge-page arrays grow and copy", large.size() == HUGE_PAGE_SIZE + 1
+			&& large[HUGE_PAGE_SIZE] == 8 && Array<int, HugePageAllocator>(large)[0] == 7);
+
+		// 2^32 + 64 bytes: indices past the old unsigned int limit
+		size_t const count = (static_cast<size_t>(1) << 32) + 64;
+		size_t const needed = count + (static_cast<size_t>(512) << 20);
+		if (sizeof(size_t) < 8 || availableMemory() < needed)
+			std::cout << MAGENTA << "Skipped 2^32-element stress test: needs "
+				<< (needed >> 20) << " MiB available" << RESET << std::endl;
+		else
+		{
+			Array<unsigned char, HugePageAllocator> huge(count, uninitialized);
+			std::memset(huge.data(), 1, huge.size());
+			size_t const limit = static_cast<size_t>(1) << 32;
+			huge[limit - 1] = 2;
+			huge[limit] = 3;
+			huge.at(count - 1) = 4;
+			std::cout << "Allocated " << CYAN << huge.size() << RESET << " bytes" << std::endl;
+			printTest("Size above 2^32 kept exactly", huge.size() == count && huge.end() - huge.begin() == static_cast<ptrdiff_t>(count));
+			printTest("Indices above 2^32 reach distinct elements",
+				huge[limit - 1] == 2 && huge[limit] == 3 && huge[count - 1] == 4 && huge[0] == 1 && &huge[limit] == huge.data() + limit);
+			ArrayView<unsigned char const> tail = huge.slice(limit - 2, count);
+			printTest("Views across the 2^32 boundary", tail.size() == 66 && tail[1] == 2 && tail[2] == 3 && tail[65] == 4);
+			bool outOfRange = false;
+			try
+			{
+				huge.at(count);
+			}
+			catch (std::exception const &)
+			{
+				outOfRange = true;
+			}
+			printTest("at(size()) still throws above 2^32", outOfRange);
+		}
+	}
+
+	// ========== Test 25: Aligned storage ==========
+	std::cout << BOLD << YELLOW << "\n[25] Aligned storage" << RESET << std::endl;
+	{
+		typedef Array<float, AlignedAllocator<64> > Aligned;
+		std::cout << "ALIGNMENT: Array<float> " << CYAN << Array<float>::ALIGNMENT << RESET
+			<< ", AlignedAllocator<32> " << CYAN << Array<float, AlignedAllocator<32> >::ALIGNMENT << RESET
+			<< ", AlignedAllocator<64> " << CYAN << Aligned::ALIGNMENT << RESET << std::endl;
+		printTest("ALIGNMENT reflects the allocator", Array<float>::ALIGNMENT == __alignof__(float)
+			&& Array<float, AlignedAllocator<32> >::ALIGNMENT == 32 && Aligned::ALIGNMENT == 64);
+
+		Aligned arr(1000);
+		Kernels::fill(arr, 1.5f);
+		bool aligned = reinterpret_cast<size_t>(arr.data()) % 64 == 0;
+		Aligned copy(arr);
+		aligned = aligned && reinterpret_cast<size_t>(copy.data()) % 64 == 0 && copy[999] == 1.5f;
+		Aligned assigned(3);
+		assigned = arr;
+		aligned = aligned && reinterpret_cast<size_t>(assigned.data()) % 64 == 0 && assigned[999] == 1.5f;
+		printTest("Copies and assignments stay aligned", aligned);
+
+		Aligned grown;
+		bool growthAligned = true;
+		for (int i = 0; i < 100; i++)
+		{
+			grown.push_back(static_cast<float>(i));
+			growthAligned = growthAligned && reinterpret_cast<size_t>(grown.data()) % 64 == 0;
+		}
+		grown.shrink_to_fit();
+		growthAligned = growthAligned && reinterpret_cast<size_t>(grown.data()) % 64 == 0 && grown[99] == 99.0f;
+		printTest("Growth and shrink_to_fit stay aligned", growthAligned);
+
+		// Rounded-up block sizes: small per-thread arrays never share a line
+		Aligned first(3);
+		Aligned second(3);
+		printTest("Small arrays get separate cache lines",
+			reinterpret_cast<size_t>(first.data()) / 64 != reinterpret_cast<size_t>(second.data()) / 64);
+
+		// Over-aligned elements in a default (heap) Array
+		Array<CacheLine> lines;
+		bool linesAligned = true;
+		for (long i = 0; i < 100; i++)
+		{
+			CacheLine line = {i};
+			lines.push_back(line);
+			linesAligned = linesAligned && reinterpret_cast<size_t>(lines.data()) % 64 == 0;
+		}
+		Array<CacheLine> linesCopy(lines);
+		linesAligned = linesAligned && reinterpret_cast<size_t>(linesCopy.data()) % 64 == 0
+			&& linesCopy[99].value == 99;
+		printTest("Over-aligned types in a heap Array", Array<CacheLine>::ALIGNMENT == 64 && linesAligned);
+	}
+
+	// ========== Test 26: Structure of arrays ==========
+	std::cout << BOLD << YELLOW << "\n[26] Structure of arrays (SoAArray)" << RESET << std::endl;
+	{
+		enum { PRICE, QUANTITY, NAME };
+		SoAArray<double, int, std::string> orders(4);
+		std::cout << "Columns: " << CYAN << orders.COLUMNS << RESET << ", rows: " << CYAN << orders.size() << RESET << std::endl;
+		printTest("Every column has size() rows", orders.column<PRICE>().size() == 4
+			&& orders.column<QUANTITY>().size() == 4 && orders.column<NAME>().size() == 4);
+
+		for (size_t i = 0; i < orders.size(); i++)
+		{
+			orders[i].get<PRICE>() = 10.5 * static_cast<double>(i);
+			orders[i].get<QUANTITY>() = static_cast<int>(i);
+		}
+		SoAArray<double, int, std::string>::Row last = orders.push_back();
+		last.get<PRICE>() = 99.5;
+		last.get<NAME>() = "last";
+		printTest("Record-style access through rows", orders.size() == 5 && orders[2].get<PRICE>() == 21.0
+			&& orders[4].get<NAME>() == "last" && orders[4].get<QUANTITY>() == 0);
+
+		orders.iter<PRICE>(addOne);
+		orders.transform<PRICE, QUANTITY>(toQuantity);
+		printTest("Column-wise iter and transform", orders[1].get<PRICE>() == 11.5
+			&& orders[1].get<QUANTITY>() == 11 && orders[4].get<QUANTITY>() == 100);
+		printTest("Columns feed the kernels directly", Kernels::sum(orders.column<PRICE>()) == 63.0 + 4.0 + 100.5);
+
+		SoAArray<double, int, std::string> copy(orders);
+		copy[0].get<NAME>() = "copy";
+		SoAArray<double, int, std::string> const & constOrders = orders;
+		printTest("Copies are deep", constOrders[0].get<NAME>().empty() && copy.size() == 5);
+
+		bool outOfRange = false;
+		try
+		{
+			orders[5];
+		}
+		catch (std::exception const &)
+		{
+			outOfRange = true;
+		}
+		printTest("Row index checked", outOfRange);
+
+		SoAArray<int, Fragile> fragile(5);
+		Fragile::budget = 2;
+		bool failed = false;
+		try
+		{
+			fragile.resize(10);
+		}
+		catch (std::runtime_error const &)
+		{
+			failed = true;
+		}
+		Fragile::budget = 1000;
+		printTest("Failed growth leaves columns the same size", failed && fragile.size() == 5
+			&& fragile.column<0>().size() == 5 && fragile.column<1>().size() == 5);
+	}
+
+	// ========== Test 27: Concurrent append ==========
+	std::cout << BOLD << YELLOW << "\n[27] Concurrent append (ConcurrentArray)" << RESET << std::endl;
+	{
+		AppendShared shared;
+		shared.readerOk = true;
+		pthread_t reader;
+		pthread_t producers[PRODUCERS];
+		Producer args[PRODUCERS];
+		pthread_create(&reader, NULL, readerMain, &shared);
+		for (size_t p = 0; p < PRODUCERS; p++)
+		{
+			args[p].shared = &shared;
+			args[p].id = p;
+			pthread_create(&producers[p], NULL, producerMain, &args[p]);
+		}
+		for (size_t p = 0; p < PRODUCERS; p++)
+			pthread_join(producers[p], NULL);
+		pthread_join(reader, NULL);
+
+		ConcurrentArray<unsigned long>::Snapshot snapshot = shared.values.snapshot();
+		std::cout << "Pushed " << CYAN << snapshot.size() << RESET << " values from " << PRODUCERS
+			<< " threads in " << CYAN << snapshot.segments() << RESET << " segments" << std::endl;
+		printTest("Every push published", snapshot.size() == PRODUCERS * PUSHES);
+		printTest("Concurrent reader saw only written values", shared.readerOk);
+
+		// Each producer's values appear once each, in its push order
+		unsigned long next[PRODUCERS] = {0};
+		bool ordered = true;
+		for (size_t k = 0; k < snapshot.segments(); k++)
+		{
+			ArrayView<unsigned long const> piece = snapshot.segment(k);
+			for (size_t i = 0; i < piece.size(); i++)
+			{
+				unsigned long id = piece[i] >> 32;
+				ordered = ordered && (piece[i] & 0xffffffffUL) == next[id]++;
+			}
+		}
+		for (size_t p = 0; p < PRODUCERS; p++)
+			ordered = ordered && next[p] == PUSHES;
+		printTest("No value lost or duplicated, per-producer order kept", ordered);
+
+		Array<unsigned long> copy = snapshot.toArray();
+		shared.values.push_back(42);
+		printTest("toArray() copy matches, snapshot unaffected by later pushes", copy.size() == snapshot.size()
+			&& copy[0] == snapshot[0] && copy[copy.size() - 1] == snapshot[snapshot.size() - 1]
+			&& snapshot.size() == PRODUCERS * PUSHES && shared.values.size() == PRODUCERS * PUSHES + 1);
+
+		ConcurrentArray<int> empty;
+		bool outOfRange = false;
+		try
+		{
+			empty[0];
+		}
+		catch (std::exception const &)
+		{
+			outOfRange = true;
+		}
+		printTest("Unpublished index rejected", outOfRange && empty.snapshot().segments() == 0);
+
+		ConcurrentArray<CacheLine> lines;
+		CacheLine line = {0};
+		bool linesAligned = true;
+		for (long i = 0; i < 3000; i++)
+		{
+			line.value = i;
+			size_t index = lines.push_back(line);
+			linesAligned = linesAligned && reinterpret_cast<size_t>(&lines[index]) % 64 == 0
+				&& lines[index].value == i;
+		}
+		printTest("Over-aligned elements keep their alignment", linesAligned);
+	}
+
+	// ========== Test 28: Fixed-size arrays ==========
+	std::cout << BOLD << YELLOW << "\n[28] Fixed-size arrays (StaticArray)" << RESET << std::endl;
+	{
+		StaticArray<int, 5> arr;
+		bool allZero = true;
+		for (size_t i = 0; i < arr.size(); i++)
+			allZero = allZero && arr[i] == 0;
+		std::cout << "sizeof(StaticArray<int, 5>): " << CYAN << sizeof(arr) << RESET << " bytes, no heap" << std::endl;
+		printTest("Size 5, elements value-initialized", arr.size() == 5 && allZero && sizeof(arr) == 5 * sizeof(int));
+
+		bool outOfRange = false;
+		size_t index = arr.size();
+		try
+		{
+			arr[index] = 1;
+		}
+		catch (StaticArray<int, 5>::OutOfBoundsException const &)
+		{
+			outOfRange = true;
+		}
+		StaticArray<int, 5> const & constArr = arr;
+		bool constOutOfRange = false;
+		try
+		{
+			constArr.at(index);
+		}
+		catch (std::exception const &)
+		{
+			constOutOfRange = true;
+		}
+		printTest("Runtime index checked (const and non-const)", outOfRange && constOutOfRange);
+
+		int const values[5] = {4, -2, 9, -2, 9};
+		StaticArray<int, 5> a(values);
+		StaticArray<int, 5> copy(a);
+		copy[0] = 100;
+		a.get<1>() = -3;
+		printTest("Built from values, deep copy, get<I>()", a.get<0>() == 4 && a[1] == -3
+			&& copy[0] == 100 && copy[1] == -2);
+
+		long sum = 0;
+		Accumulate accumulate = {&sum};
+		iter(a, accumulate);
+		StaticArray<int, 64> big;
+		big.fill(2);
+		iter(big, negate);
+		iter(static_cast<StaticArray<int, 64> const &>(big), accumulate);
+		printTest("iter() unrolled (5) and looped (64)", sum == 4 - 3 + 9 - 2 + 9 - 128 && big[63] == -2);
+
+		int const others[5] = {1, 1, 10, -5, 9};
+		StaticArray<int, 5> b(others);
+		StaticArray<int, 5> lo = min(a, b);
+		StaticArray<int, 5> hi = max(a, b);
+		std::pair<int const *, int const *> extremes = minmax_element(a);
+		printTest("Element-wise min/max, minmax_element tie rules", lo[0] == 1 && lo[1] == -3
+			&& lo[3] == -5 && hi[2] == 10 && hi[4] == 9
+			&& extremes.first == &a[1] && extremes.second == &a[4]);
+
+		swap(a, b);
+		StaticArray<int, 64> other;
+		swap(big, other);
+		printTest("swap() exchanges elements", a[0] == 1 && b[0] == 4 && big[0] == 0 && other[0] == -2);
+		printTest("Views and kernels see the elements", total(a) == 16 && Kernels::sum(other.view()) == -128);
+
+#if __cplusplus >= 201103L
+		constexpr StaticArray<int, 4> primes(2, 3, 5);
+		static_assert(primes.size() == 4 && primes[2] == 5 && primes.get<3>() == 0, "constexpr access");
+		static_assert(primes.at(0) + primes.get<1>() == 5, "constexpr at and get");
+		printTest("constexpr construction and access (checked by static_assert)", true);
+
+		constexpr StaticArray<int, 4> single(7);
+		static_assert(single[0] == 7 && single[3] == 0, "one leading element");
+		static_assert(!std::is_convertible<int, StaticArray<int, 4> >::value, "no implicit conversion from T");
+		printTest("Single-element construction is explicit (checked by static_assert)", true);
+#endif
+	}
+
+	// ========== Test 29: Element-wise expressions ==========
+	std::cout << BOLD << YELLOW << "\n[29] Element-wise expressions (one fused loop)" << RESET << std::endl;
+	{
+		Array<int> a(5);
+		Array<int> b(5);
+		for (int i = 0; i < 5; i++)
+		{
+			a[i] = i + 1;
+			b[i] = 10 * (i + 1);
+		}
+		Array<int> c;
+		c = a * 2 + b;
+		int* buffer = c.data();
+		c = b - a / 2;
+		std::cout << "c = b - a / 2: ";
+		for (size_t i = 0; i < c.size(); i++)
+			std::cout << c[i] << " ";
+		std::cout << std::endl;
+		printTest("c = a * 2 + b, then reassigned in place", c.size() == 5 && c[0] == 10 && c[4] == 48
+			&& c.data() == buffer);
+
+		Array<int> d = -(a + b) / 3 + 1;
+		Array<double> x(3);
+		x[0] = 0.5;
+		x[1] = 1.5;
+		x[2] = -2.0;
+		Array<double> y = 2 * x - 1;
+		printTest("Construction, unary minus, scalars on either side", d[0] == -2 && d[4] == -17
+			&& y[0] == 0.0 && y[1] == 2.0 && y[2] == -5.0);
+
+		a = a + b;
+		bool selfOk = a[0] == 11 && a[4] == 55;
+		a = a * a - a;
+		selfOk = selfOk && a[0] == 110 && a[4] == 2970;
+		b = a / 10 + b * 2;
+		printTest("Aliasing: a = a + b, a = a * a - a, b = a / 10 + b * 2", selfOk && b[0] == 31 && b[4] == 397);
+
+		a += b;
+		a -= 1;
+		a *= 2;
+		a /= b + 1;
+		printTest("Compound assignment with arrays, scalars, expressions", a[0] == (110 + 31 - 1) * 2 / 32
+			&& a[4] == (2970 + 397 - 1) * 2 / 398);
+
+		Array<int> shorter(4);
+		bool mismatch = false;
+		try
+		{
+			c = a + shorter;
+		}
+		catch (std::invalid_argument const &)
+		{
+			mismatch = true;
+		}
+		printTest("Size mismatch throws, target untouched", mismatch && c.size() == 5 && c[0] == 10);
+
+		ThreadPool pool(4);
+		size_t const size = 100000;
+		Array<long> p(size);
+		Array<long> q(size);
+		for (size_t i = 0; i < size; i++)
+		{
+			p[i] = static_cast<long>(i);
+			q[i] = static_cast<long>(i % 7);
+		}
+		Array<long> serial = p * 3 - q;
+		Array<long> parallel;
+		evaluate(ParallelPolicy(1000, &pool), parallel, p * 3 - q);
+		evaluate(ParallelPolicy(1000, &pool), p, p * 3 - q);
+		bool same = parallel.size() == size;
+		for (size_t i = 0; i < size && same; i++)
+			same = parallel[i] == serial[i] && p[i] == serial[i];
+		printTest("Parallel evaluation matches, also in place", same);
+
+		// 10001 ints starting 32 bytes into a line: a halving split would cut mid-line
+		Array<int> raw(10001 + 64);
+		int* odd = raw.data() + (64 - reinterpret_cast<size_t>(raw.data()) % 64) / sizeof(int) + 8;
+		IterDetail::Chunks chunks = IterDetail::alignedChunks(odd, 10001, 0, pool.size());
+		bool aligned = chunks.begin(0) == 0 && chunks.begin(chunks.count()) == 10001 && chunks.count() > 4;
+		for (size_t i = 1; i < chunks.count(); i++)
+			aligned = aligned && reinterpret_cast<size_t>(odd + chunks.begin(i)) % 64 == 0;
+		printTest("Parallel chunks start on cache lines of the target", aligned);
+	}
+
+	// ========== Test 30: Bulk copy paths ==========
+	std::cout << BOLD << YELLOW << "\n[30] Bulk copy paths (type traits)" << RESET << std::endl;
+	{
+		printTest("Traits: int and double* bulk, std::string and Number per element",
+			TypeTraits<int>::trivialCopy && TypeTraits<int>::zeroInit && TypeTraits<double*>::zeroInit
+			&& !TypeTraits<std::string>::trivialRelocate && !TypeTraits<Number>::trivialCopy
+			&& TypeTraits<Handle>::trivialRelocate && !TypeTraits<Handle>::trivialCopy);
+
+		Array<double> values(1000);
+		for (size_t i = 0; i < values.size(); i++)
+			values[i] = static_cast<double>(i) / 4;
+		Array<double> copy(values);
+		Array<double> assigned(10);
+		assigned = values;
+		values.resize(1500, -0.0);
+		values.resize(2000, 2.5);
+		printTest("memcpy copy/assign, memset and loop fills", copy[999] == 249.75 && assigned[1] == 0.25
+			&& assigned.size() == 1000 && values[999] == 249.75 && 1.0 / values[1000] < 0
+			&& values[1499] == 0.0 && values[1500] == 2.5 && values[1999] == 2.5);
+
+		Array<char> letters;
+		letters.resize(4, 'x');
+		Array<long> zeros;
+		zeros.resize(3, 5);
+		zeros.resize(10);
+		printTest("Single-byte fill and zero value-initialization", letters[0] == 'x' && letters[3] == 'x'
+			&& zeros[2] == 5 && zeros[3] == 0 && zeros[9] == 0);
+
+		Handle::copies = 0;
+		{
+			Array<Handle> handles;
+			for (int i = 0; i < 100; i++)
+				handles.push_back(Handle(i));
+			printTest("Relocatable type grows without copies, values kept", Handle::copies == 100
+				&& *handles[0].value == 0 && *handles[99].value == 99 && Handle::live == 100);
+		}
+		printTest("No Handle leaked or destroyed twice", Handle::live == 0);
+
+		Array<std::string> words;
+		for (int i = 0; i < 100; i++)
+			words.push_back(std::string(1, static_cast<char>('a' + i % 26)));
+		Array<Number> numbers(3);
+		numbers[2] = Number(7);
+		Array<Number> numbersCopy(numbers);
+		numbers[2] = Number(8);
+		printTest("Non-trivial types keep per-element copies", words[0] == "a" && words[99] == "v"
+			&& numbersCopy[2].getValue() == 7);
+	}
+
+	// ========== Test 31: Instrumentation ==========
+	std::cout << BOLD << YELLOW << "\n[31] Instrumentation compiled out" << RESET << std::endl;
+	{
+		// Exact counts: make instrument-test (instrument_test.cpp, -DINSTRUMENT)
+		Instrument::reset();
+		Array<int> a(5);
+		Array<int> b(a);
+		int thrown = 0;
+		try { a[5] = 1; } catch (std::exception&) { thrown++; }
+		Instrument::Counters c = Instrument::snapshot();
+		printTest("Default build: allocations, copies and throws count nothing", thrown == 1
+			&& c[Instrument::ALLOCATIONS] == 0 && c[Instrument::DEEP_COPIES] == 0 && c[Instrument::BOUNDS_THROWS] == 0);
+	}
+
+	// ========== Test 32: Sorting and searching ==========
+	std::cout << BOLD << YELLOW << "\n[32] Sorting and searching" << RESET << std::endl;
+	{
+		std::srand(3);
+		Array<int> ints(1000);
+		long sum = 0;
+		for (size_t i = 0; i < ints.size(); i++)
+		{
+			ints[i] = std::rand() % 2001 - 1000;
+			sum += ints[i];
+		}
+		::sort(ints);
+		long sortedSum = 0;
+		for (size_t i = 0; i < ints.size(); i++)
+			sortedSum += ints[i];
+		printTest("Radix sort: ints with negatives", ::is_sorted(ints) && sortedSum == sum);
+
+		Array<double> doubles(600);
+		for (size_t i = 0; i < doubles.size(); i++)
+			doubles[i] = (std::rand() % 2001 - 1000) / 8.0;
+		::sort(doubles);
+		printTest("Radix sort: doubles", ::is_sorted(doubles) && doubles[0] < 0 && doubles[599] > 0);
+
+		Array<std::string> names(5);
+		names[0] = "mike";
+		names[1] = "alice";
+		names[2] = "zoe";
+		names[3] = "bob";
+		names[4] = "alice";
+		::sort(names);
+		std::cout << "Sorted names: " << names[0] << " " << names[1] << " " << names[2]
+			<< " " << names[3] << " " << names[4] << std::endl;
+		printTest("Introsort: strings", names[0] == "alice" && names[1] == "alice"
+			&& names[2] == "bob" && names[4] == "zoe");
+
+		size_t calls = 0;
+		CountingGreater greater = {&calls};
+		Array<int> pattern(2000);
+		bool allSorted = true;
+		for (int p = 0; p < 4; p++)
+		{
+			for (size_t i = 0; i < pattern.size(); i++)
+			{
+				int const values[] = {static_cast<int>(i), -static_cast<int>(i), static_cast<int>(i % 3),
+					static_cast<int>(i < 1000 ? i : 2000 - i)};
+				pattern[i] = values[p];
+			}
+			::sort(pattern, greater);
+			allSorted = allSorted && ::is_sorted(pattern.view(), greater);
+		}
+		for (size_t i = 0; i < pattern.size(); i++)
+			pattern[i] = static_cast<int>(pattern.size() - i);
+		calls = 0;
+		::sort(pattern, greater);
+		printTest("Introsort: ascending, descending, 3 keys, organ pipe", allSorted);
+		printTest("Sorted input takes a linear number of comparisons", calls < 3 * pattern.size());
+
+		int values[] = {9, 8, 7, 6, 5, 4, 3, 2, 1, 0};
+		::sort(ArrayView<int>(values).slice(2, 8));
+		printTest("Sorting a slice leaves the rest alone", values[0] == 9 && values[1] == 8
+			&& values[2] == 2 && values[7] == 7 && values[8] == 1 && values[9] == 0);
+
+		ThreadPool pool(4);
+		Array<int> big(100000);
+		for (size_t i = 0; i < big.size(); i++)
+			big[i] = std::rand();
+		Array<int> serial(big);
+		Array<int> descending(big);
+		::sort(serial);
+		::sort(ParallelPolicy(0, &pool), big);
+		::sort(ParallelPolicy(1000, &pool), descending, std::greater<int>());
+		bool same = true;
+		for (size_t i = 0; i < big.size(); i++)
+			same = same && big[i] == serial[i] && descending[big.size() - 1 - i] == serial[i];
+		printTest("Parallel sort matches the sequential one", same);
+
+		int const sortedValues[] = {1, 3, 3, 3, 7};
+		Array<int> sorted(5);
+		for (size_t i = 0; i < 5; i++)
+			sorted[i] = sortedValues[i];
+		printTest("lower_bound / upper_bound", ::lower_bound(sorted, 3) == 1 && ::upper_bound(sorted, 3) == 4
+			&& ::lower_bound(sorted, 0) == 0 && ::lower_bound(sorted, 8) == 5 && ::upper_bound(sorted, 7) == 5
+			&& ::lower_bound(Array<int>(), 1) == 0);
+		printTest("binary_search", ::binary_search(sorted, 7) && !::binary_search(sorted, 4)
+			&& !::binary_search(sorted, 0) && ::binary_search(sorted.view(), 1));
+	}
+
+	// ========== Test 33: Search index ==========
+	std::cout << BOLD << YELLOW << "\n[33] Search index" << RESET << std::endl;
+	{
+		std::srand(5);
+		Array<int> keys(10000);
+		for (size_t i = 0; i < keys.size(); i++)
+			keys[i] = std::rand() % 5000 - 2500;
+		::sort(keys);
+		SearchIndex<int> index(keys);
+		Array<int> queries(3000);
+		Array<size_t> batched(queries.size());
+		for (size_t i = 0; i < queries.size(); i++)
+			queries[i] = std::rand() % 5004 - 2502;
+		index.lower_bound(queries, batched);
+		bool same = true;
+		for (size_t i = 0; i < queries.size(); i++)
+		{
+			size_t expected = ::lower_bound(keys, queries[i]);
+			same = same && index.lower_bound(queries[i]) == expected && batched[i] == expected
+				&& index.contains(queries[i]) == ::binary_search(keys, queries[i]);
+		}
+		std::cout << "10000 ints in " << index.bytes() << " bytes of 64-byte nodes" << std::endl;
+		printTest("lower_bound, batched lower_bound and contains match binary search", same);
+
+		Array<unsigned long> wide(100);
+		for (size_t i = 0; i < wide.size(); i++)
+			wide[i] = 3 * i + 1;
+		SearchIndex<unsigned long> wideIndex(wide);
+		printTest("unsigned long keys, values around and past the ends", wideIndex.lower_bound(0) == 0
+			&& wideIndex.lower_bound(1) == 0 && wideIndex.lower_bound(2) == 1 && wideIndex.lower_bound(298) == 99
+			&& wideIndex.lower_bound(299) == 100 && !wideIndex.contains(299) && wideIndex.contains(298));
+
+		Array<double> reals(3);
+		reals[0] = -1.5;
+		reals[1] = 0.0;
+		reals[2] = 2.5;
+		SearchIndex<double> realIndex(reals);
+		SearchIndex<int> none((Array<int>()));
+		printTest("Doubles and an empty index", realIndex.lower_bound(0.0) == 1 && realIndex.lower_bound(3.0) == 3
+			&& none.lower_bound(7) == 0 && !none.contains(7) && none.empty());
+
+		bool rejected = false;
+		try
+		{
+			SearchIndex<int> unsorted(queries);
+		}
+		catch (std::invalid_argument const &)
+		{
+			rejected = true;
+		}
+		printTest("Unsorted keys are rejected", rejected);
+	}
+
 	std::cout << BOLD << GREEN << "\n✓ All Array tests completed!\n" << RESET << std::endl;
 
 	return 0;
@@ -0,0 +1,171 @@
+// Concurrency stress tests meant for ThreadSanitizer (make tsan): the
+// ConcurrentArray multi-producer test of main.cpp at a larger scale, and
+// the ThreadPool entry points. Kept out of main.cpp, whose large-array
+// tests cannot run under TSan's memory overhead.
+
+#include <iostream>
+#include <string>
+#include <pthread.h>
+#include <sched.h>
+#include "Array.hpp"
+#include "ConcurrentArray.hpp"
+#include "ArrayExpr.hpp"
+#include "Sort.hpp"
+#include "../ex01/ParallelIter.hpp"
+
+// ANSI Color codes
+#define RESET   "\033[0m"
+#define RED     "\033[31m"
+#define GREEN   "\033[32m"
+#define YELLOW  "\033[33m"
+#define BOLD    "\033[1m"
+
+void printTest(std::string const & testName, bool success)
+{
+	if (success)
+		std::cout << GREEN << "✓ " << testName << RESET << std::endl;
+	else
+		std::cout << RED << "✗ " << testName << RESET << std::endl;
+}
+
+// Each producer pushes (id << 32 | sequence) values while readers check
+// that everything below size() is already written
+size_t const PRODUCERS = 8;
+size_t const READERS = 2;
+size_t const PUSHES = 50000;
+
+struct AppendShared
+{
+	ConcurrentArray<unsigned long>	values;
+	int								readerErrors;	// Atomic
+};
+
+struct Producer
+{
+	AppendShared*	shared;
+	unsigned long	id;
+};
+
+void* producerMain(void* arg)
+{
+	Producer* p = static_cast<Producer*>(arg);
+	for (unsigned long i = 0; i < PUSHES; i++)
+	{
+		p->shared->values.push_back((p->id << 32) | i);
+		if (i % 4096 == 0)
+			sched_yield();
+	}
+	return NULL;
+}
+
+void* readerMain(void* arg)
+{
+	AppendShared* shared = static_cast<AppendShared*>(arg);
+	size_t seen = 0;
+	while (seen < PRODUCERS * PUSHES)
+	{
+		size_t size = shared->values.size();
+		if (size < seen)
+			__atomic_add_fetch(&shared->readerErrors, 1, __ATOMIC_RELAXED);
+		for (; seen < size; seen++)
+			if ((shared->values[seen] >> 32) >= PRODUCERS || (shared->values[seen] & 0xffffffffUL) >= PUSHES)
+				__atomic_add_fetch(&shared->readerErrors, 1, __ATOMIC_RELAXED);
+		sched_yield();
+	}
+	return NULL;
+}
+
+// pool.run task: slot i written by task i only
+struct Square
+{
+	long*	out;
+
+	void operator()(size_t i) { out[i] = static_cast<long>(i * i); }
+};
+
+// parallelFor body: per-range sums folded with one atomic add
+struct RangeSum
+{
+	long*	total;
+
+	void operator()(size_t begin, size_t end)
+	{
+		long sum = 0;
+		for (size_t i = begin; i < end; i++)
+			sum += static_cast<long>(i);
+		__atomic_add_fetch(total, sum, __ATOMIC_RELAXED);
+	}
+};
+
+void incrementElement(int & element)
+{
+	++element;
+}
+
+int main(void)
+{
+	std::cout << BOLD << YELLOW << "\n[1] ConcurrentArray: " << PRODUCERS << " producers, " << READERS
+		<< " readers" << RESET << std::endl;
+	{
+		AppendShared shared;
+		shared.readerErrors = 0;
+		pthread_t readers[READERS];
+		pthread_t producers[PRODUCERS];
+		Producer args[PRODUCERS];
+		for (size_t r = 0; r < READERS; r++)
+			pthread_create(&readers[r], NULL, readerMain, &shared);
+		for (size_t p = 0; p < PRODUCERS; p++)
+		{
+			args[p].shared = &shared;
+			args[p].id = p;
+			pthread_create(&producers[p], NULL, producerMain, &args[p]);
+		}
+		for (size_t p = 0; p < PRODUCERS; p++)
+			pthread_join(producers[p], NULL);
+		for (size_t r = 0; r < READERS; r++)
+			pthread_join(readers[r], NULL);
+
+		ConcurrentArray<unsigned long>::Snapshot snapshot = shared.values.snapshot();
+		unsigned long next[PRODUCERS] = {0};
+		bool ordered = snapshot.size() == PRODUCERS * PUSHES;
+		for (size_t k = 0; k < snapshot.segments(); k++)
+		{
+			ArrayView<unsigned long const> piece = snapshot.segment(k);
+			for (size_t i = 0; i < piece.size(); i++)
+				ordered = ordered && (piece[i] & 0xffffffffUL) == next[piece[i] >> 32]++;
+		}
+		printTest("Readers saw only written values", shared.readerErrors == 0);
+		printTest("Every push published once, per-producer order kept", ordered);
+	}
+
+	std::cout << BOLD << YELLOW << "\n[2] ThreadPool" << RESET << std::endl;
+	{
+		ThreadPool pool(4);
+		Array<long> squares(100000);
+		Square square = {squares.data()};
+		pool.run(square, squares.size());
+		bool runOk = true;
+		for (size_t i = 0; i < squares.size(); i++)
+			runOk = runOk && squares[i] == static_cast<long>(i * i);
+		printTest("run(): every index once", runOk);
+
+		long total = 0;
+		RangeSum sum = {&total};
+		pool.parallelFor(0, 100000, 1000, sum);
+		printTest("parallelFor(): ranges cover the whole interval", total == 99999L * 100000 / 2);
+
+		Array<int> values(100000);
+		::iter(ParallelPolicy(0, &pool), values.data(), values.size(), incrementElement);
+		Array<int> doubled;
+		evaluate(ParallelPolicy(0, &pool), doubled, values * 2);
+		for (size_t i = 0; i < values.size(); i++)
+			values[i] = static_cast<int>((i * 7919) % 100000);
+		::sort(ParallelPolicy(0, &pool), values);
+		printTest("Parallel iter, evaluate and sort", doubled[0] == 2 && doubled[99999] == 2
+			&& ::is_sorted(values) && values[0] == 0 && values[99999] == 99999);
+	}
+
+	std::cout << BOLD << GREEN << "\n✓ All concurrency tests completed!\n" << RESET << std::endl;
+
+	return 0;
+}